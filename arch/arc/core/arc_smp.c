@@ -144,6 +144,15 @@ void arch_sched_ipi(void)
 	}
 }
 
+void arch_sched_directed_ipi(uint32_t cpu_bitmap)
+{
+	for (uint32_t i = 0U; i < CONFIG_MP_NUM_CPUS; i++) {
+		if ((cpu_bitmap & BIT(i)) != 0U) {
+			z_arc_connect_ici_generate(i);
+		}
+	}
+}
+
 static int arc_smp_init(const struct device *dev)
 {
 	ARG_UNUSED(dev);
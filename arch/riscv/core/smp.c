@@ -76,6 +76,22 @@ void arch_sched_ipi(void)
 	arch_irq_unlock(key);
 }
 
+void arch_sched_directed_ipi(uint32_t cpu_bitmap)
+{
+	unsigned int key;
+
+	key = arch_irq_lock();
+
+	for (unsigned int i = 0U; i < CONFIG_MP_NUM_CPUS; i++) {
+		if ((cpu_bitmap & BIT(i)) != 0U) {
+			volatile uint32_t *r = (uint32_t *)get_hart_msip(i);
+			*r = 1U;
+		}
+	}
+
+	arch_irq_unlock(key);
+}
+
 static void sched_ipi_handler(const void *unused)
 {
 	ARG_UNUSED(unused);
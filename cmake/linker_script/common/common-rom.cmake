@@ -96,6 +96,9 @@ if(CONFIG_NET_SOCKETS)
   zephyr_iterable_section(NAME net_socket_register KVMA RAM_REGION GROUP RODATA_REGION SUBALIGN 4)
 endif()
 
+if(CONFIG_NET_TCP_CONGESTION_CONTROL)
+  zephyr_iterable_section(NAME tcp_cc_ops KVMA RAM_REGION GROUP RODATA_REGION SUBALIGN 4)
+endif()
 
 if(CONFIG_NET_L2_PPP)
   zephyr_iterable_section(NAME ppp_protocol_handler KVMA RAM_REGION GROUP RODATA_REGION SUBALIGN 4)
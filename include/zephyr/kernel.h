@@ -750,7 +750,7 @@ __syscall void k_thread_priority_set(k_tid_t thread, int prio);
  * Linux sched_setattr()) that allows the kernel to validate the
  * scheduling for achievability.  Such features could be implemented
  * above this call, which is simply input to the priority selection
- * logic.
+ * logic, or use k_thread_cbs_set().
  *
  * @note You should enable @kconfig{CONFIG_SCHED_DEADLINE} in your project
  * configuration.
@@ -762,6 +762,45 @@ __syscall void k_thread_priority_set(k_tid_t thread, int prio);
 __syscall void k_thread_deadline_set(k_tid_t thread, int deadline);
 #endif
 
+#if defined(CONFIG_SCHED_CBS) || defined(__DOXYGEN__)
+/**
+ * @brief Make a thread a constant bandwidth server
+ *
+ * Reserves @a budget_us microseconds of CPU time for the thread in
+ * every @a period_us.  From then on the kernel manages the thread's
+ * deadline: it is set a period ahead whenever the thread wakes up
+ * with too little budget left to meet the current one, and postponed
+ * by a period whenever the thread has run through its budget.  A
+ * thread that overruns its reservation thus only delays servers at
+ * the same priority once they have met their own deadlines.
+ *
+ * The request is rejected if the sum of budget / period over all
+ * servers would exceed @kconfig{CONFIG_SCHED_CBS_MAX_UTILIZATION}
+ * percent, which guarantees that servers sharing a priority with no
+ * higher priority threads or interrupts competing all meet their
+ * deadlines.  Budgets are enforced with the system timer, so they are
+ * overrun by up to a tick or two.
+ *
+ * Deadlines only order threads of the same static priority, so all
+ * servers should be given the same one.  k_thread_deadline_set() must
+ * not be used on a server.
+ *
+ * @note You should enable @kconfig{CONFIG_SCHED_CBS} in your project
+ * configuration.
+ *
+ * @param thread Thread to configure
+ * @param budget_us Runtime budget per period, in microseconds, or
+ *                  zero to release the thread's reservation
+ * @param period_us Period, in microseconds
+ *
+ * @retval 0 on success
+ * @retval -EINVAL if the budget exceeds the period, the period is too
+ *                 long or the thread has exited
+ * @retval -ENOSPC if the reservation would overload the CPU
+ */
+int k_thread_cbs_set(k_tid_t thread, uint32_t budget_us, uint32_t period_us);
+#endif
+
 #ifdef CONFIG_SCHED_CPU_MASK
 /**
  * @brief Sets all CPU enable masks to zero
@@ -1706,17 +1745,38 @@ struct k_queue {
 
 	_POLL_EVENT;
 
+#ifdef CONFIG_QUEUE_NODE_POOL
+	/* Unused nodes given with k_queue_node_pool_init() */
+	sys_sflist_t node_pool;
+#endif
+
 	SYS_PORT_TRACING_TRACKING_FIELD(k_queue)
 };
 
+#ifdef CONFIG_QUEUE_NODE_POOL
+#define Z_QUEUE_NODE_POOL_INIT(obj) \
+	.node_pool = SYS_SFLIST_STATIC_INIT(&obj.node_pool),
+#else
+#define Z_QUEUE_NODE_POOL_INIT(obj)
+#endif
+
 #define Z_QUEUE_INITIALIZER(obj) \
 	{ \
 	.data_q = SYS_SFLIST_STATIC_INIT(&obj.data_q), \
 	.lock = { }, \
 	.wait_q = Z_WAIT_Q_INIT(&obj.wait_q),	\
 	_POLL_EVENT_OBJ_INIT(obj)		\
+	Z_QUEUE_NODE_POOL_INIT(obj)		\
 	}
 
+/* Bookkeeping node put in a queue for k_queue_alloc_append() and
+ * k_queue_alloc_prepend(), pointing to the caller's data item.
+ */
+struct k_queue_node {
+	sys_sfnode_t node;
+	void *data;
+};
+
 extern void *z_queue_node_peek(sys_sfnode_t *node, bool needs_free);
 
 /**
@@ -1753,6 +1813,29 @@ __syscall void k_queue_init(struct k_queue *queue);
  */
 __syscall void k_queue_cancel_wait(struct k_queue *queue);
 
+#if defined(CONFIG_QUEUE_NODE_POOL) || defined(__DOXYGEN__)
+/**
+ * @brief Give a queue preallocated bookkeeping nodes.
+ *
+ * This routine hands @a count nodes to @a queue. Items added with
+ * k_queue_alloc_append() and k_queue_alloc_prepend() use one of these
+ * nodes until they are removed, instead of allocating one from the
+ * calling thread's resource pool. Once all of them are in use, further
+ * items fall back to the resource pool.
+ *
+ * The queue must be initialized and must not hold any items added with
+ * a node from an earlier array. The nodes belong to the kernel until
+ * the queue is initialized again, and should not be in memory that user
+ * threads can write.
+ *
+ * @param queue Address of the queue.
+ * @param nodes Array of nodes.
+ * @param count Number of nodes in @a nodes.
+ */
+void k_queue_node_pool_init(struct k_queue *queue, struct k_queue_node *nodes,
+			    size_t count);
+#endif
+
 /**
  * @brief Append an element to the end of a queue.
  *
@@ -1773,7 +1856,9 @@ extern void k_queue_append(struct k_queue *queue, void *data);
  * This routine appends a data item to @a queue. There is an implicit memory
  * allocation to create an additional temporary bookkeeping data structure from
  * the calling thread's resource pool, which is automatically freed when the
- * item is removed. The data itself is not copied.
+ * item is removed. The data itself is not copied. If the queue was given
+ * nodes with k_queue_node_pool_init(), one of those is used instead while
+ * any are left.
  *
  * @funcprops \isr_ok
  *
@@ -1805,7 +1890,9 @@ extern void k_queue_prepend(struct k_queue *queue, void *data);
  * This routine prepends a data item to @a queue. There is an implicit memory
  * allocation to create an additional temporary bookkeeping data structure from
  * the calling thread's resource pool, which is automatically freed when the
- * item is removed. The data itself is not copied.
+ * item is removed. The data itself is not copied. If the queue was given
+ * nodes with k_queue_node_pool_init(), one of those is used instead while
+ * any are left.
  *
  * @funcprops \isr_ok
  *
@@ -2073,12 +2160,15 @@ struct k_event {
 	_wait_q_t         wait_q;
 	uint32_t          events;
 	struct k_spinlock lock;
+
+	_POLL_EVENT;
 };
 
 #define Z_EVENT_INITIALIZER(obj) \
 	{ \
 	.wait_q = Z_WAIT_Q_INIT(&obj.wait_q), \
-	.events = 0 \
+	.events = 0, \
+	_POLL_EVENT_OBJ_INIT(obj) \
 	}
 
 /**
@@ -2219,6 +2309,21 @@ struct k_fifo {
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_fifo, init, fifo); \
 	})
 
+#if defined(CONFIG_QUEUE_NODE_POOL) || defined(__DOXYGEN__)
+/**
+ * @brief Give a FIFO queue preallocated bookkeeping nodes.
+ *
+ * Items added with k_fifo_alloc_put() use these nodes instead of memory
+ * from the calling thread's resource pool. See k_queue_node_pool_init().
+ *
+ * @param fifo Address of the FIFO queue.
+ * @param nodes Array of struct k_queue_node.
+ * @param count Number of nodes in @a nodes.
+ */
+#define k_fifo_node_pool_init(fifo, nodes, count) \
+	k_queue_node_pool_init(&(fifo)->_queue, nodes, count)
+#endif
+
 /**
  * @brief Cancel waiting on a FIFO queue.
  *
@@ -2454,6 +2559,21 @@ struct k_lifo {
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_lifo, init, lifo); \
 	})
 
+#if defined(CONFIG_QUEUE_NODE_POOL) || defined(__DOXYGEN__)
+/**
+ * @brief Give a LIFO queue preallocated bookkeeping nodes.
+ *
+ * Items added with k_lifo_alloc_put() use these nodes instead of memory
+ * from the calling thread's resource pool. See k_queue_node_pool_init().
+ *
+ * @param lifo Address of the LIFO queue.
+ * @param nodes Array of struct k_queue_node.
+ * @param count Number of nodes in @a nodes.
+ */
+#define k_lifo_node_pool_init(lifo, nodes, count) \
+	k_queue_node_pool_init(&(lifo)->_queue, nodes, count)
+#endif
+
 /**
  * @brief Add an element to a LIFO queue.
  *
@@ -2708,20 +2828,48 @@ struct k_mutex {
 	/** Original thread priority */
 	int owner_orig_prio;
 
+#ifdef CONFIG_SYNC_FAST_PATH
+	/* Owner thread, with Z_MUTEX_WAITERS set once another thread
+	 * contends for the mutex.  Zero while unlocked.
+	 */
+	atomic_t state;
+#endif
+
+#ifdef CONFIG_MUTEX_ADAPTIVE_SPIN_STATS
+	/* Spins that saw the mutex released, and that gave up */
+	atomic_t spin_hits;
+	atomic_t spin_misses;
+#endif
+
+	_POLL_EVENT;
+
 	SYS_PORT_TRACING_TRACKING_FIELD(k_mutex)
 };
 
 /**
  * @cond INTERNAL_HIDDEN
  */
+#define Z_MUTEX_WAITERS ((atomic_val_t)1)
+
 #define Z_MUTEX_INITIALIZER(obj) \
 	{ \
 	.wait_q = Z_WAIT_Q_INIT(&obj.wait_q), \
 	.owner = NULL, \
 	.lock_count = 0, \
 	.owner_orig_prio = K_LOWEST_APPLICATION_THREAD_PRIO, \
+	_POLL_EVENT_OBJ_INIT(obj) \
 	}
 
+/* True if the mutex is unlocked, as seen without its lock */
+static inline bool z_mutex_is_free(struct k_mutex *mutex)
+{
+#ifdef CONFIG_SYNC_FAST_PATH
+	return (atomic_get(&mutex->state) & ~Z_MUTEX_WAITERS) == 0;
+#else
+	return mutex->lock_count == 0U;
+#endif
+}
+
 /**
  * INTERNAL_HIDDEN @endcond
  */
@@ -2799,6 +2947,32 @@ __syscall int k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout);
  */
 __syscall int k_mutex_unlock(struct k_mutex *mutex);
 
+#if defined(CONFIG_MUTEX_ADAPTIVE_SPIN_STATS) || defined(__DOXYGEN__)
+/**
+ * @brief Mutex adaptive spinning statistics.
+ */
+struct k_mutex_spin_stats {
+	/** Spins that ended with the mutex released */
+	uint32_t hits;
+	/** Spins that gave up and went on to pend */
+	uint32_t misses;
+};
+
+/**
+ * @brief Get adaptive spinning statistics of a mutex.
+ *
+ * A spin is counted each time k_mutex_lock() finds @a mutex owned by
+ * a thread running on another CPU and waits for its release before
+ * pending.  A high share of misses suggests the critical sections
+ * protected by @a mutex are too long for CONFIG_MUTEX_ADAPTIVE_SPIN_US.
+ *
+ * @param mutex Address of the mutex.
+ * @param stats Pointer to the statistics to fill in.
+ */
+extern void k_mutex_spin_stats_get(struct k_mutex *mutex,
+				   struct k_mutex_spin_stats *stats);
+#endif
+
 /**
  * @}
  */
@@ -2887,7 +3061,14 @@ __syscall int k_condvar_wait(struct k_condvar *condvar, struct k_mutex *mutex,
 
 struct k_sem {
 	_wait_q_t wait_q;
+#ifdef CONFIG_SYNC_FAST_PATH
+	/* Count, with Z_SEM_WAITERS set while threads or poll events
+	 * may be waiting on the semaphore.
+	 */
+	atomic_t count;
+#else
 	unsigned int count;
+#endif
 	unsigned int limit;
 
 	_POLL_EVENT;
@@ -2896,11 +3077,21 @@ struct k_sem {
 
 };
 
+#define Z_SEM_WAITERS ((atomic_val_t)BIT(31))
+#define Z_SEM_COUNT_MASK ((atomic_val_t)BIT_MASK(31))
+
+/* Largest count that can be stored, larger limits are clamped to it */
+#ifdef CONFIG_SYNC_FAST_PATH
+#define Z_SEM_COUNT_MAX ((unsigned int)Z_SEM_COUNT_MASK)
+#else
+#define Z_SEM_COUNT_MAX UINT_MAX
+#endif
+
 #define Z_SEM_INITIALIZER(obj, initial_count, count_limit) \
 	{ \
 	.wait_q = Z_WAIT_Q_INIT(&obj.wait_q), \
-	.count = initial_count, \
-	.limit = count_limit, \
+	.count = MIN(initial_count, Z_SEM_COUNT_MAX), \
+	.limit = MIN(count_limit, Z_SEM_COUNT_MAX), \
 	_POLL_EVENT_OBJ_INIT(obj) \
 	}
 
@@ -3001,7 +3192,11 @@ __syscall unsigned int k_sem_count_get(struct k_sem *sem);
  */
 static inline unsigned int z_impl_k_sem_count_get(struct k_sem *sem)
 {
+#ifdef CONFIG_SYNC_FAST_PATH
+	return (unsigned int)(atomic_get(&sem->count) & Z_SEM_COUNT_MASK);
+#else
 	return sem->count;
+#endif
 }
 
 /**
@@ -3129,6 +3324,41 @@ int k_work_submit_to_queue(struct k_work_q *queue,
  */
 extern int k_work_submit(struct k_work *work);
 
+/** @brief Submit several work items to a queue at once.
+ *
+ * Each item is submitted as by k_work_submit_to_queue(), but all of them
+ * within one critical section, and the queue thread is woken once for the
+ * whole batch rather than once per item.  Items that are already queued
+ * are left in place; items that are running are queued to the queue that
+ * is running them, as usual.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param queue pointer to the work queue on which the items should run.  If
+ * NULL the queue from each item's most recent submission will be used.
+ * @param works array of pointers to the work items.
+ * @param count number of entries in @p works.
+ *
+ * @return the number of items newly queued (those for which
+ * k_work_submit_to_queue() would have returned 1 or 2).  If no item was
+ * newly queued, the error code of the first rejected item, or 0 if none
+ * was rejected.
+ */
+int k_work_submit_batch_to_queue(struct k_work_q *queue,
+				 struct k_work **works,
+				 size_t count);
+
+/** @brief Submit several work items to the system queue at once.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param works array of pointers to the work items.
+ * @param count number of entries in @p works.
+ *
+ * @return as with k_work_submit_batch_to_queue().
+ */
+extern int k_work_submit_batch(struct k_work **works, size_t count);
+
 /** @brief Wait for last-submitted instance to complete.
  *
  * Resubmissions may occur while waiting, including chained submissions (from
@@ -4315,14 +4545,35 @@ struct k_msgq {
 	char *buffer_start;
 	/** End of message buffer */
 	char *buffer_end;
+#ifdef CONFIG_MSGQ_LOCKFREE
+	/** Next sequence number to be reserved by a writer */
+	atomic_t prod_head;
+	/** Sequence number up to which messages are readable */
+	atomic_t prod_tail;
+	/** Next sequence number to be reserved by a reader */
+	atomic_t cons_head;
+	/** Sequence number up to which slots are writable again */
+	atomic_t cons_tail;
+	/** Sequence numbers wrap at this multiple of max_msgs */
+	uint32_t seq_limit;
+	/** Pending threads and registered pollers */
+	atomic_t waiters;
+	/** Threads in the wait queue are readers, not writers */
+	bool readers_waiting;
+#else
 	/** Read pointer */
 	char *read_ptr;
 	/** Write pointer */
 	char *write_ptr;
 	/** Number of used messages */
 	uint32_t used_msgs;
+#endif
 
 	_POLL_EVENT;
+#ifdef CONFIG_POLL
+	/** Pollers waiting for free space */
+	sys_dlist_t space_poll_events;
+#endif
 
 	/** Message queue */
 	uint8_t flags;
@@ -4334,6 +4585,27 @@ struct k_msgq {
  */
 
 
+#ifdef CONFIG_MSGQ_LOCKFREE
+#define Z_MSGQ_SEQ_LIMIT(q_max_msgs) \
+	(((q_max_msgs) == 0U) ? 1U : \
+	 (0x80000000U / (uint32_t)(q_max_msgs)) * (uint32_t)(q_max_msgs))
+
+#define Z_MSGQ_RING_INIT(q_buffer, q_max_msgs) \
+	.seq_limit = Z_MSGQ_SEQ_LIMIT(q_max_msgs),
+#else
+#define Z_MSGQ_RING_INIT(q_buffer, q_max_msgs) \
+	.read_ptr = q_buffer, \
+	.write_ptr = q_buffer, \
+	.used_msgs = 0,
+#endif
+
+#ifdef CONFIG_POLL
+#define Z_MSGQ_SPACE_POLL_INIT(obj) \
+	.space_poll_events = SYS_DLIST_STATIC_INIT(&obj.space_poll_events),
+#else
+#define Z_MSGQ_SPACE_POLL_INIT(obj)
+#endif
+
 #define Z_MSGQ_INITIALIZER(obj, q_buffer, q_msg_size, q_max_msgs) \
 	{ \
 	.wait_q = Z_WAIT_Q_INIT(&obj.wait_q), \
@@ -4341,10 +4613,9 @@ struct k_msgq {
 	.max_msgs = q_max_msgs, \
 	.buffer_start = q_buffer, \
 	.buffer_end = q_buffer + (q_max_msgs * q_msg_size), \
-	.read_ptr = q_buffer, \
-	.write_ptr = q_buffer, \
-	.used_msgs = 0, \
+	Z_MSGQ_RING_INIT(q_buffer, q_max_msgs) \
 	_POLL_EVENT_OBJ_INIT(obj) \
+	Z_MSGQ_SPACE_POLL_INIT(obj) \
 	}
 
 /**
@@ -4543,9 +4814,32 @@ __syscall void  k_msgq_get_attrs(struct k_msgq *msgq,
 				 struct k_msgq_attrs *attrs);
 
 
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+static inline uint32_t z_msgq_used_msgs(struct k_msgq *msgq)
+{
+#ifdef CONFIG_MSGQ_LOCKFREE
+	/* Reading the consumer side first keeps the difference from
+	 * going negative, concurrent updates can only make it too large.
+	 */
+	uint32_t head = (uint32_t)atomic_get(&msgq->cons_head);
+	uint32_t tail = (uint32_t)atomic_get(&msgq->prod_tail);
+	uint32_t used = (tail >= head) ? tail - head :
+		tail + msgq->seq_limit - head;
+
+	return MIN(used, msgq->max_msgs);
+#else
+	return msgq->used_msgs;
+#endif
+}
+/**
+ * INTERNAL_HIDDEN @endcond
+ */
+
 static inline uint32_t z_impl_k_msgq_num_free_get(struct k_msgq *msgq)
 {
-	return msgq->max_msgs - msgq->used_msgs;
+	return msgq->max_msgs - z_msgq_used_msgs(msgq);
 }
 
 /**
@@ -4561,7 +4855,7 @@ __syscall uint32_t k_msgq_num_used_get(struct k_msgq *msgq);
 
 static inline uint32_t z_impl_k_msgq_num_used_get(struct k_msgq *msgq)
 {
-	return msgq->used_msgs;
+	return z_msgq_used_msgs(msgq);
 }
 
 /** @} */
@@ -4737,6 +5031,8 @@ struct k_pipe {
 	size_t         bytes_used;      /**< # bytes used in buffer */
 	size_t         read_index;      /**< Where in buffer to read from */
 	size_t         write_index;     /**< Where in buffer to write */
+	size_t         put_claimed;     /**< # bytes claimed for writing */
+	size_t         get_claimed;     /**< # bytes claimed for reading */
 	struct k_spinlock lock;		/**< Synchronization lock */
 
 	struct {
@@ -4746,6 +5042,8 @@ struct k_pipe {
 
 	uint8_t	       flags;		/**< Flags */
 
+	_POLL_EVENT;
+
 	SYS_PORT_TRACING_TRACKING_FIELD(k_pipe)
 };
 
@@ -4761,12 +5059,15 @@ struct k_pipe {
 	.bytes_used = 0,                                            \
 	.read_index = 0,                                            \
 	.write_index = 0,                                           \
+	.put_claimed = 0,                                           \
+	.get_claimed = 0,                                           \
 	.lock = {},                                                 \
 	.wait_q = {                                                 \
 		.readers = Z_WAIT_Q_INIT(&obj.wait_q.readers),       \
 		.writers = Z_WAIT_Q_INIT(&obj.wait_q.writers)        \
 	},                                                          \
-	.flags = 0                                                  \
+	.flags = 0,                                                 \
+	_POLL_EVENT_OBJ_INIT(obj)                                   \
 	}
 
 /**
@@ -4925,12 +5226,128 @@ __syscall void k_pipe_flush(struct k_pipe *pipe);
  */
 __syscall void k_pipe_buffer_flush(struct k_pipe *pipe);
 
+/**
+ * @brief Claim space in a pipe's buffer for writing in place.
+ *
+ * This routine returns the address of contiguous free space in the pipe's
+ * ring buffer, so that a producer can write data directly into the pipe
+ * instead of copying it in with k_pipe_put(). The data becomes visible to
+ * readers once it is committed with k_pipe_put_finish().
+ *
+ * The returned space may be smaller than requested if the buffer is nearly
+ * full or wraps; claim again after finishing to fill the rest. Repeated
+ * claims without a finish in between return consecutive space. Nothing
+ * can be claimed while writers are blocked in k_pipe_put(), as their data
+ * must go first.
+ *
+ * @warning
+ * k_pipe_put() must not be called on @a pipe while a put claim is
+ * outstanding. Use cases involving multiple producers must serialize
+ * claims and finishes, e.g. with a mutex.
+ *
+ * @note This routine is not available to user mode threads, as the pipe's
+ * buffer is kernel memory.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param pipe Address of the pipe.
+ * @param data Address of area to hold the address of the claimed space.
+ * @param size Maximum number of bytes to claim.
+ *
+ * @return Number of bytes claimed; zero if no space is available or the
+ *         pipe has no buffer.
+ */
+size_t k_pipe_put_claim(struct k_pipe *pipe, unsigned char **data,
+			size_t size);
+
+/**
+ * @brief Commit data written to claimed pipe buffer space.
+ *
+ * This routine makes the first @a size bytes of the space claimed with
+ * k_pipe_put_claim() available to readers, and releases the rest of the
+ * claim. Readers blocked in k_pipe_get() are given the data and readied
+ * once their request is satisfied.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param pipe Address of the pipe.
+ * @param size Number of bytes written, possibly zero.
+ *
+ * @retval 0 Data committed.
+ * @retval -EINVAL @a size exceeds the claimed space.
+ */
+int k_pipe_put_finish(struct k_pipe *pipe, size_t size);
+
+/**
+ * @brief Claim data in a pipe's buffer for reading in place.
+ *
+ * This routine returns the address of contiguous data in the pipe's ring
+ * buffer, so that a consumer can process it in place instead of copying it
+ * out with k_pipe_get(). The space is handed back to writers once it is
+ * released with k_pipe_get_finish().
+ *
+ * The returned data may be shorter than requested if less is buffered or
+ * the buffer wraps. Repeated claims without a finish in between return
+ * consecutive data. Data held by writers blocked in k_pipe_put() is moved
+ * into the buffer as space is released, not handed out directly.
+ *
+ * @warning
+ * k_pipe_get(), k_pipe_flush() and k_pipe_buffer_flush() must not be
+ * called on @a pipe while a get claim is outstanding. Use cases involving
+ * multiple consumers must serialize claims and finishes, e.g. with a mutex.
+ *
+ * @note This routine is not available to user mode threads, as the pipe's
+ * buffer is kernel memory.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param pipe Address of the pipe.
+ * @param data Address of area to hold the address of the claimed data.
+ * @param size Maximum number of bytes to claim.
+ *
+ * @return Number of bytes claimed; zero if the pipe's buffer is empty or
+ *         the pipe has no buffer.
+ */
+size_t k_pipe_get_claim(struct k_pipe *pipe, unsigned char **data,
+			size_t size);
+
+/**
+ * @brief Release pipe buffer data claimed for reading.
+ *
+ * This routine consumes the first @a size bytes of the data claimed with
+ * k_pipe_get_claim(); the rest of the claim stays in the pipe and will be
+ * returned again by the next claim. Writers blocked in k_pipe_put() move
+ * their data into the freed space and are readied once their request is
+ * satisfied.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param pipe Address of the pipe.
+ * @param size Number of bytes consumed, possibly zero.
+ *
+ * @retval 0 Data released.
+ * @retval -EINVAL @a size exceeds the claimed data.
+ */
+int k_pipe_get_finish(struct k_pipe *pipe, size_t size);
+
 /** @} */
 
 /**
  * @cond INTERNAL_HIDDEN
  */
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+struct k_mem_slab_cache {
+	struct k_spinlock lock;
+	uint32_t count;
+	uint32_t alloc_hits;
+	uint32_t alloc_misses;
+	uint32_t free_hits;
+	uint32_t free_misses;
+	void *blocks[CONFIG_MEM_SLAB_CPU_CACHE_SIZE];
+};
+#endif
+
 struct k_mem_slab {
 	_wait_q_t wait_q;
 	struct k_spinlock lock;
@@ -4942,6 +5359,12 @@ struct k_mem_slab {
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	uint32_t max_used;
 #endif
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	/* One cache per CPU, NULL unless enabled for this slab */
+	struct k_mem_slab_cache *cpu_cache;
+	/* Threads about to wait or waiting for a block */
+	atomic_t cache_waiters;
+#endif
 
 	SYS_PORT_TRACING_TRACKING_FIELD(k_mem_slab)
 };
@@ -5082,6 +5505,11 @@ extern int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem,
  */
 extern void k_mem_slab_free(struct k_mem_slab *slab, void **mem);
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+/* Number of free blocks currently held in per-CPU caches */
+extern uint32_t z_mem_slab_num_cached(struct k_mem_slab *slab);
+#endif
+
 /**
  * @brief Get the number of used blocks in a memory slab.
  *
@@ -5094,7 +5522,11 @@ extern void k_mem_slab_free(struct k_mem_slab *slab, void **mem);
  */
 static inline uint32_t k_mem_slab_num_used_get(struct k_mem_slab *slab)
 {
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	return slab->num_used - z_mem_slab_num_cached(slab);
+#else
 	return slab->num_used;
+#endif
 }
 
 /**
@@ -5129,9 +5561,57 @@ static inline uint32_t k_mem_slab_max_used_get(struct k_mem_slab *slab)
  */
 static inline uint32_t k_mem_slab_num_free_get(struct k_mem_slab *slab)
 {
-	return slab->num_blocks - slab->num_used;
+	return slab->num_blocks - k_mem_slab_num_used_get(slab);
 }
 
+#if defined(CONFIG_MEM_SLAB_CPU_CACHE) || defined(__DOXYGEN__)
+/**
+ * @brief Memory slab per-CPU cache statistics.
+ */
+struct k_mem_slab_cache_stats {
+	/** Allocations served from a per-CPU cache */
+	uint32_t alloc_hits;
+	/** Allocations that had to take the slab lock */
+	uint32_t alloc_misses;
+	/** Frees absorbed by a per-CPU cache */
+	uint32_t free_hits;
+	/** Frees that had to take the slab lock */
+	uint32_t free_misses;
+};
+
+/**
+ * @brief Enable per-CPU block caches for a memory slab.
+ *
+ * Puts a small cache of free blocks for each CPU in front of the
+ * slab's free list, so most allocations and frees avoid the shared
+ * slab lock.  Blocks sitting in a cache count as free, and are
+ * returned to the slab before an allocation fails or has to wait.
+ *
+ * @note Must be called before the slab is used concurrently.
+ *
+ * @param slab Address of the memory slab.
+ * @param caches Array of CONFIG_MP_NUM_CPUS caches, which must stay
+ *        valid as long as the slab is in use.
+ *
+ * @retval 0 on success
+ * @retval -EINVAL invalid data supplied
+ */
+extern int k_mem_slab_cache_enable(struct k_mem_slab *slab,
+				   struct k_mem_slab_cache *caches);
+
+/**
+ * @brief Get per-CPU cache statistics of a memory slab.
+ *
+ * Statistics are summed over all CPUs, and are all zero if caching
+ * is not enabled for @a slab.
+ *
+ * @param slab Address of the memory slab.
+ * @param stats Pointer to the statistics to fill in.
+ */
+extern void k_mem_slab_cache_stats_get(struct k_mem_slab *slab,
+				       struct k_mem_slab_cache_stats *stats);
+#endif
+
 /** @} */
 
 /**
@@ -5141,10 +5621,23 @@ static inline uint32_t k_mem_slab_num_free_get(struct k_mem_slab *slab)
 
 /* kernel synchronized heap struct */
 
+#ifdef CONFIG_SYS_HEAP_CACHE
+struct k_heap_cache {
+	struct k_spinlock lock;
+	struct sys_heap_cache cache;
+};
+#endif
+
 struct k_heap {
 	struct sys_heap heap;
 	_wait_q_t wait_q;
 	struct k_spinlock lock;
+#ifdef CONFIG_SYS_HEAP_CACHE
+	/* One size-class cache per CPU, NULL unless enabled */
+	struct k_heap_cache *cpu_cache;
+	/* Threads about to wait or waiting for memory */
+	atomic_t cache_waiters;
+#endif
 };
 
 /**
@@ -5219,10 +5712,41 @@ void *k_heap_alloc(struct k_heap *h, size_t bytes,
  */
 void k_heap_free(struct k_heap *h, void *mem);
 
+#if defined(CONFIG_SYS_HEAP_CACHE) || defined(__DOXYGEN__)
+/**
+ * @brief Enable per-CPU size-class caches for a k_heap
+ *
+ * Puts a sys_heap_cache for each CPU in front of the heap, so that
+ * small allocations (up to 256 bytes, with no more than pointer
+ * alignment) and their frees are mostly served without taking the
+ * heap lock or searching the heap.  Blocks are moved between a cache
+ * and the heap in batches.  All cached blocks are returned to the
+ * heap before an allocation fails or has to wait.
+ *
+ * @note Must be called before the heap is used concurrently.
+ *
+ * @param h Heap to enable caching for
+ * @param caches Array of CONFIG_MP_NUM_CPUS caches, which must stay
+ *        valid as long as the heap is in use.
+ *
+ * @retval 0 on success
+ * @retval -EINVAL invalid data supplied
+ */
+int k_heap_cache_enable(struct k_heap *h, struct k_heap_cache *caches);
+#endif
+
 /* Hand-calculated minimum heap sizes needed to return a successful
  * 1-byte allocation.  See details in lib/os/heap.[ch]
  */
+#ifdef CONFIG_SYS_HEAP_TLSF
+/* Plus the list bitmaps and the extra list heads of (at most) the
+ * eight buckets of such a small heap.
+ */
+#define Z_HEAP_MIN_SIZE ((sizeof(void *) > 4 ? 56 : 44) + 64 + \
+			 ((1 << CONFIG_SYS_HEAP_TLSF_SL_BITS) - 1) * 4 * 8)
+#else
 #define Z_HEAP_MIN_SIZE (sizeof(void *) > 4 ? 56 : 44)
+#endif
 
 /**
  * @brief Define a static k_heap in the specified linker section
@@ -5381,6 +5905,18 @@ enum _poll_types_bits {
 	/* msgq data availability */
 	_POLL_TYPE_MSGQ_DATA_AVAILABLE,
 
+	/* msgq free space availability */
+	_POLL_TYPE_MSGQ_SPACE_AVAILABLE,
+
+	/* pipe data availability */
+	_POLL_TYPE_PIPE_DATA_AVAILABLE,
+
+	/* events posted to a k_event */
+	_POLL_TYPE_EVENT_POSTED,
+
+	/* mutex availability */
+	_POLL_TYPE_MUTEX_AVAILABLE,
+
 	_POLL_NUM_TYPES
 };
 
@@ -5406,6 +5942,18 @@ enum _poll_states_bits {
 	/* data is available to read on a message queue */
 	_POLL_STATE_MSGQ_DATA_AVAILABLE,
 
+	/* space is available to write to a message queue */
+	_POLL_STATE_MSGQ_SPACE_AVAILABLE,
+
+	/* data is available to read from a pipe */
+	_POLL_STATE_PIPE_DATA_AVAILABLE,
+
+	/* events are set on a k_event */
+	_POLL_STATE_EVENT_POSTED,
+
+	/* mutex is unlocked */
+	_POLL_STATE_MUTEX_AVAILABLE,
+
 	_POLL_NUM_STATES
 };
 
@@ -5437,6 +5985,10 @@ enum _poll_states_bits {
 #define K_POLL_TYPE_DATA_AVAILABLE Z_POLL_TYPE_BIT(_POLL_TYPE_DATA_AVAILABLE)
 #define K_POLL_TYPE_FIFO_DATA_AVAILABLE K_POLL_TYPE_DATA_AVAILABLE
 #define K_POLL_TYPE_MSGQ_DATA_AVAILABLE Z_POLL_TYPE_BIT(_POLL_TYPE_MSGQ_DATA_AVAILABLE)
+#define K_POLL_TYPE_MSGQ_SPACE_AVAILABLE Z_POLL_TYPE_BIT(_POLL_TYPE_MSGQ_SPACE_AVAILABLE)
+#define K_POLL_TYPE_PIPE_DATA_AVAILABLE Z_POLL_TYPE_BIT(_POLL_TYPE_PIPE_DATA_AVAILABLE)
+#define K_POLL_TYPE_EVENT_POSTED Z_POLL_TYPE_BIT(_POLL_TYPE_EVENT_POSTED)
+#define K_POLL_TYPE_MUTEX_AVAILABLE Z_POLL_TYPE_BIT(_POLL_TYPE_MUTEX_AVAILABLE)
 
 /* public - polling modes */
 enum k_poll_modes {
@@ -5453,6 +6005,10 @@ enum k_poll_modes {
 #define K_POLL_STATE_DATA_AVAILABLE Z_POLL_STATE_BIT(_POLL_STATE_DATA_AVAILABLE)
 #define K_POLL_STATE_FIFO_DATA_AVAILABLE K_POLL_STATE_DATA_AVAILABLE
 #define K_POLL_STATE_MSGQ_DATA_AVAILABLE Z_POLL_STATE_BIT(_POLL_STATE_MSGQ_DATA_AVAILABLE)
+#define K_POLL_STATE_MSGQ_SPACE_AVAILABLE Z_POLL_STATE_BIT(_POLL_STATE_MSGQ_SPACE_AVAILABLE)
+#define K_POLL_STATE_PIPE_DATA_AVAILABLE Z_POLL_STATE_BIT(_POLL_STATE_PIPE_DATA_AVAILABLE)
+#define K_POLL_STATE_EVENT_POSTED Z_POLL_STATE_BIT(_POLL_STATE_EVENT_POSTED)
+#define K_POLL_STATE_MUTEX_AVAILABLE Z_POLL_STATE_BIT(_POLL_STATE_MUTEX_AVAILABLE)
 #define K_POLL_STATE_CANCELLED Z_POLL_STATE_BIT(_POLL_STATE_CANCELLED)
 
 /* public - poll signal object */
@@ -5510,6 +6066,9 @@ struct k_poll_event {
 		struct k_fifo *fifo;
 		struct k_queue *queue;
 		struct k_msgq *msgq;
+		struct k_pipe *pipe;
+		struct k_event *event;
+		struct k_mutex *mutex;
 	};
 };
 
@@ -5931,6 +6490,29 @@ extern void k_sys_runtime_stats_enable(void);
  */
 extern void k_sys_runtime_stats_disable(void);
 
+#if defined(CONFIG_SCHED_LATENCY_STATS) || defined(__DOXYGEN__)
+/**
+ * @brief Get the scheduling latency histograms of a thread
+ *
+ * @param thread ID of thread.
+ * @param stats Pointer to struct to copy the histograms into.
+ * @return -EINVAL if null pointers, otherwise 0
+ */
+int k_thread_latency_stats_get(k_tid_t thread,
+			       struct k_sched_latency_stats *stats);
+
+/**
+ * @brief Get the scheduling latency histograms of a CPU
+ *
+ * These cover all threads but the idle thread that ran on @a cpu.
+ *
+ * @param cpu CPU index.
+ * @param stats Pointer to struct to copy the histograms into.
+ * @return -EINVAL if null pointer or invalid CPU, otherwise 0
+ */
+int k_cpu_latency_stats_get(int cpu, struct k_sched_latency_stats *stats);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -57,4 +57,26 @@ struct _priq_mq {
 
 struct k_thread *z_priq_mq_best(struct _priq_mq *pq);
 
+/* Wait queue flavor of the multi-queue, one level per thread priority
+ * (again max 32).  The per-priority FIFOs are kept as consecutive runs
+ * of a single list sorted like the "dumb" one, with a pointer to the
+ * last thread of each run, so that a thread is inserted after the
+ * last thread of its own or the nearest higher priority in O(1) time
+ * and the list can still be walked in order.  The bucket a thread was
+ * queued in is kept in its order_key, which is only used while the
+ * thread is in a run queue.
+ */
+#define Z_PRIQ_BM_LEVELS \
+	(CONFIG_NUM_COOP_PRIORITIES + CONFIG_NUM_PREEMPT_PRIORITIES + 1)
+
+struct _priq_bm {
+	sys_dlist_t list;
+	unsigned int bitmask; /* bit 1<<i set if tails[i] is valid */
+	struct k_thread *tails[Z_PRIQ_BM_LEVELS];
+};
+
+void z_priq_bm_add(struct _priq_bm *pq, struct k_thread *thread);
+void z_priq_bm_remove(struct _priq_bm *pq, struct k_thread *thread);
+struct k_thread *z_priq_bm_best(struct _priq_bm *pq);
+
 #endif /* ZEPHYR_INCLUDE_SCHED_PRIQ_H_ */
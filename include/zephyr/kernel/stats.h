@@ -24,4 +24,22 @@ struct k_cycle_stats {
 	bool      track_usage;  /* true if gathering usage stats */
 };
 
+#if defined(CONFIG_SCHED_LATENCY_STATS) || defined(__DOXYGEN__)
+/**
+ * @brief Scheduling latency histograms of a thread or CPU.
+ *
+ * Entry N of a histogram counts the events that took between 2^N and
+ * 2^(N+1) - 1 cycles, entry 0 also counting those that took none, and
+ * the last entry all longer ones.  The idle thread is not accounted.
+ */
+struct k_sched_latency_stats {
+	/** Time from being made ready (woken up, started, resumed) to running */
+	uint32_t wakeup[CONFIG_SCHED_LATENCY_STATS_BUCKETS];
+	/** Time run before being switched out */
+	uint32_t slice[CONFIG_SCHED_LATENCY_STATS_BUCKETS];
+	/** Switches out while still ready, i.e. preemptions and yields */
+	uint32_t preempted;
+};
+#endif
+
 #endif
@@ -90,6 +90,19 @@ struct _thread_base {
 	int prio_deadline;
 #endif
 
+#ifdef CONFIG_SCHED_CBS
+	/* Constant bandwidth server budget and period, in cycles */
+	uint32_t cbs_budget;
+	uint32_t cbs_period;
+
+	/* Bandwidth reserved, in parts per million */
+	uint32_t cbs_share;
+
+	/* Budget left in the current period, and when it was last charged */
+	uint32_t cbs_left;
+	uint32_t cbs_start;
+#endif
+
 	uint32_t order_key;
 
 #ifdef CONFIG_SMP
@@ -126,6 +139,12 @@ struct _thread_base {
 #ifdef CONFIG_SCHED_THREAD_USAGE
 	struct k_cycle_stats  usage;   /* Track thread usage statistics */
 #endif
+
+#ifdef CONFIG_SCHED_LATENCY_STATS
+	/* Cycle count when last made ready, 0 once running */
+	uint32_t ready_stamp;
+	struct k_sched_latency_stats latency;
+#endif
 };
 
 typedef struct _thread_base _thread_base_t;
@@ -110,7 +110,7 @@ struct _cpu {
 	/* one assigned idle thread per CPU */
 	struct k_thread *idle_thread;
 
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#ifdef CONFIG_SCHED_CPU_READY_Q
 	struct _ready_q ready_q;
 #endif
 
@@ -149,12 +149,38 @@ struct _cpu {
 #endif
 #endif
 
+#ifdef CONFIG_SCHED_LATENCY_STATS
+	/* Start of the current thread's run slice, 0 when idle */
+	uint32_t slice0;
+	struct k_sched_latency_stats latency;
+#endif
+
 	/* Per CPU architecture specifics */
 	struct _cpu_arch arch;
 };
 
 typedef struct _cpu _cpu_t;
 
+#ifdef CONFIG_TRACE_SCHED_IPI
+/* Scheduler IPI counters, see CONFIG_TRACE_SCHED_IPI */
+struct z_sched_ipi_stats {
+	/* Threads made ready that other CPUs should be interrupted for */
+	atomic_t flagged;
+
+	/* Threads made ready that no other CPU would switch to */
+	atomic_t skipped;
+
+	/* IPIs sent, each covering one or more flagged threads */
+	atomic_t sent;
+
+	/* CPUs targeted, summed over all IPIs sent */
+	atomic_t targets;
+
+	/* IPIs received */
+	atomic_t received;
+};
+#endif
+
 struct z_kernel {
 	struct _cpu cpus[CONFIG_MP_NUM_CPUS];
 
@@ -166,7 +192,7 @@ struct z_kernel {
 	 * ready queue: can be big, keep after small fields, since some
 	 * assembly (e.g. ARC) are limited in the encoding of the offset
 	 */
-#ifndef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#ifndef CONFIG_SCHED_CPU_READY_Q
 	struct _ready_q ready_q;
 #endif
 
@@ -189,8 +215,12 @@ struct z_kernel {
 #endif
 
 #if defined(CONFIG_SMP) && defined(CONFIG_SCHED_IPI_SUPPORTED)
-	/* Need to signal an IPI at the next scheduling point */
-	bool pending_ipi;
+	/* Bitmask of CPUs to interrupt at the next scheduling point */
+	atomic_t pending_ipi;
+#endif
+
+#ifdef CONFIG_TRACE_SCHED_IPI
+	struct z_sched_ipi_stats ipi_stats;
 #endif
 };
 
@@ -226,6 +256,14 @@ extern bool z_priq_rb_lessthan(struct rbnode *a, struct rbnode *b);
 
 #define Z_WAIT_Q_INIT(wait_q) { { { .lessthan_fn = z_priq_rb_lessthan } } }
 
+#elif defined(CONFIG_WAITQ_MULTIQ)
+
+typedef struct {
+	struct _priq_bm waitq;
+} _wait_q_t;
+
+#define Z_WAIT_Q_INIT(wait_q) { { SYS_DLIST_STATIC_INIT(&(wait_q)->waitq.list) } }
+
 #else
 
 typedef struct {
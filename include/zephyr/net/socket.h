@@ -403,6 +403,103 @@ static inline ssize_t zsock_send(int sock, const void *buf, size_t len,
 __syscall ssize_t zsock_sendmsg(int sock, const struct msghdr *msg,
 				int flags);
 
+/**
+ * @brief Send multiple messages on a socket
+ *
+ * @details
+ * @rst
+ * See `Linux man page
+ * <https://man7.org/linux/man-pages/man2/sendmmsg.2.html>`__
+ * for a description. The socket is looked up and locked once for the
+ * whole batch, which makes this cheaper than calling zsock_sendmsg() for
+ * each datagram. The number of bytes sent for each message is stored in
+ * its ``msg_len`` field. Calls from user mode send at most 1024
+ * messages, as on Linux.
+ * This function is also exposed as ``sendmmsg()``
+ * if :kconfig:option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrst
+ *
+ * @return Number of messages sent, or -1 if none could be sent.
+ */
+__syscall int zsock_sendmmsg(int sock, struct mmsghdr *msgvec,
+			     unsigned int vlen, int flags);
+
+/**
+ * @brief Receive a message from an arbitrary network address
+ *
+ * @details
+ * @rst
+ * See `POSIX.1-2017 article
+ * <http://pubs.opengroup.org/onlinepubs/9699919799/functions/recvmsg.html>`__
+ * for normative description. Ancillary data is not supported, so
+ * ``msg_controllen`` is always set to 0. ``ZSOCK_MSG_TRUNC`` is set in
+ * ``msg_flags`` if a datagram did not fit in the buffers. TLS, packet
+ * and socketpair sockets don't implement it and fail with ``EOPNOTSUPP``.
+ * This function is also exposed as ``recvmsg()``
+ * if :kconfig:option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrst
+ */
+__syscall ssize_t zsock_recvmsg(int sock, struct msghdr *msg, int flags);
+
+/**
+ * @brief Receive multiple messages from a socket
+ *
+ * @details
+ * @rst
+ * See `Linux man page
+ * <https://man7.org/linux/man-pages/man2/recvmmsg.2.html>`__
+ * for a description. Only the first message is waited for, as with
+ * ``MSG_WAITFORONE`` on Linux, the rest of the batch is filled with the
+ * datagrams that are already queued. There is no timeout argument, the
+ * receive timeout of the socket applies to the first message. Calls
+ * from user mode receive at most 1024 messages. The same sockets as
+ * with zsock_recvmsg() fail with ``EOPNOTSUPP``.
+ * This function is also exposed as ``recvmmsg()``
+ * if :kconfig:option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrst
+ *
+ * @return Number of messages received, or -1 if none was received.
+ */
+__syscall int zsock_recvmmsg(int sock, struct mmsghdr *msgvec,
+			     unsigned int vlen, int flags);
+
+struct net_pkt;
+
+/**
+ * @brief Receive a datagram without copying it
+ *
+ * @details
+ * Like zsock_recvmsg() on a datagram socket, but instead of copying the
+ * data, the entries of @p msg->msg_iov are set to point at the data
+ * fragments of the received packet and @p msg->msg_iovlen is set to the
+ * number of entries used. If the packet has more fragments than there are
+ * entries, ZSOCK_MSG_TRUNC is set in @p msg->msg_flags.
+ *
+ * The data remains valid until the packet is given back with
+ * zsock_recvmsg_zc_release(), which must be done for every successful
+ * call, also with ZSOCK_MSG_PEEK. Packets that are held are not available
+ * for receiving new data, so they should be released quickly.
+ *
+ * Only native sockets support this, and only from supervisor threads.
+ * Requires :kconfig:option:`CONFIG_NET_SOCKETS_RECV_ZERO_COPY`.
+ *
+ * @param sock Datagram socket
+ * @param msg Message header, msg_name and msg_iov are filled in
+ * @param flags ZSOCK_MSG_DONTWAIT, ZSOCK_MSG_PEEK or ZSOCK_MSG_TRUNC
+ * @param pkt Set to the packet that holds the data
+ *
+ * @return Number of bytes received, or -1 with errno set.
+ */
+ssize_t zsock_recvmsg_zc(int sock, struct msghdr *msg, int flags,
+			 struct net_pkt **pkt);
+
+/**
+ * @brief Give back a packet received by zsock_recvmsg_zc()
+ *
+ * @param pkt Packet returned by zsock_recvmsg_zc()
+ */
+void zsock_recvmsg_zc_release(struct net_pkt *pkt);
+
 /**
  * @brief Receive data from an arbitrary network address
  *
@@ -766,12 +863,29 @@ static inline ssize_t sendmsg(int sock, const struct msghdr *message,
 	return zsock_sendmsg(sock, message, flags);
 }
 
+static inline int sendmmsg(int sock, struct mmsghdr *msgvec,
+			   unsigned int vlen, int flags)
+{
+	return zsock_sendmmsg(sock, msgvec, vlen, flags);
+}
+
 static inline ssize_t recvfrom(int sock, void *buf, size_t max_len, int flags,
 			       struct sockaddr *src_addr, socklen_t *addrlen)
 {
 	return zsock_recvfrom(sock, buf, max_len, flags, src_addr, addrlen);
 }
 
+static inline ssize_t recvmsg(int sock, struct msghdr *msg, int flags)
+{
+	return zsock_recvmsg(sock, msg, flags);
+}
+
+static inline int recvmmsg(int sock, struct mmsghdr *msgvec,
+			   unsigned int vlen, int flags)
+{
+	return zsock_recvmmsg(sock, msgvec, vlen, flags);
+}
+
 static inline int poll(struct zsock_pollfd *fds, int nfds, int timeout)
 {
 	return zsock_poll(fds, nfds, timeout);
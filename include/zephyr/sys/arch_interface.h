@@ -437,6 +437,17 @@ static inline struct _cpu *arch_curr_cpu(void);
  * This will invoke z_sched_ipi() on other CPUs in the system.
  */
 void arch_sched_ipi(void);
+
+/**
+ * Send an interrupt to a set of CPUs
+ *
+ * This will invoke z_sched_ipi() on each CPU whose bit is set in
+ * @a cpu_bitmap.  Only required if the architecture selects
+ * CONFIG_SCHED_DIRECTED_IPI_SUPPORTED.
+ *
+ * @param cpu_bitmap Bitmask of CPU IDs
+ */
+void arch_sched_directed_ipi(uint32_t cpu_bitmap);
 #endif /* CONFIG_SMP */
 
 /** @} */
@@ -104,6 +104,9 @@ struct k_mem_paging_stats_t {
 		/** Number of page faults while in ISR */
 		unsigned long			in_isr;
 #endif
+
+		/** Number of pages read ahead of faulting pages */
+		unsigned long			read_ahead;
 	} pagefaults;
 
 	struct {
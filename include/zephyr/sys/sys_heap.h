@@ -262,6 +262,98 @@ void sys_heap_stress(void *(*alloc_fn)(void *arg, size_t bytes),
  */
 void sys_heap_print_info(struct sys_heap *heap, bool dump_chunks);
 
+#if defined(CONFIG_SYS_HEAP_CACHE) || defined(__DOXYGEN__)
+
+/** Number of size classes of a sys_heap_cache, 16 to 256 bytes */
+#define SYS_HEAP_CACHE_CLASSES 8
+
+/** @brief Size-class cache in front of a sys_heap
+ *
+ * Holds freed small blocks in one LIFO bin per size class, linked
+ * through the blocks' own memory.  Requests are rounded up to the
+ * class size, so a cached block can serve any later request of its
+ * class without touching the heap.  Cached blocks remain allocated
+ * as far as the heap (and its runtime statistics) is concerned.
+ *
+ * Like sys_heap itself, a cache is not internally synchronized.
+ * sys_heap_cache_get() and sys_heap_cache_put() do not access the
+ * heap's metadata, so they need only the lock protecting the cache,
+ * which allows per-CPU or per-thread caches in front of one heap.
+ * The other functions additionally need the heap lock.
+ */
+struct sys_heap_cache {
+	void *bins[SYS_HEAP_CACHE_CLASSES];
+	uint8_t count[SYS_HEAP_CACHE_CLASSES];
+	size_t align;
+	/** Requests served from a bin */
+	uint32_t hits;
+	/** Cacheable requests that found their bin empty */
+	uint32_t misses;
+};
+
+/** @brief Initialize a sys_heap_cache
+ *
+ * @param cache Cache to initialize
+ * @param align Alignment in bytes of all blocks the cache hands out,
+ *              a power of two.  Zero means sizeof(void *).
+ */
+void sys_heap_cache_init(struct sys_heap_cache *cache, size_t align);
+
+/** @brief Take a block from a sys_heap_cache
+ *
+ * @param cache Cache to allocate from
+ * @param bytes Number of bytes requested
+ * @return A cached block of at least @a bytes bytes, or NULL if @a
+ *         bytes is not cacheable or its bin is empty
+ */
+void *sys_heap_cache_get(struct sys_heap_cache *cache, size_t bytes);
+
+/** @brief Park a freed block in a sys_heap_cache
+ *
+ * @param cache Cache to put the block in
+ * @param heap Heap the block was allocated from
+ * @param mem Block to free
+ * @return true if the block was cached, false if it has to be freed
+ *         with sys_heap_cache_trim() or sys_heap_free()
+ */
+bool sys_heap_cache_put(struct sys_heap_cache *cache, struct sys_heap *heap,
+			void *mem);
+
+/** @brief Allocate a block and refill its bin
+ *
+ * Allocates a block of the class fitting @a bytes from @a heap, plus
+ * up to half a bin's worth of further blocks of that class which are
+ * put in the cache.
+ *
+ * @param cache Cache to refill
+ * @param heap Heap to allocate from
+ * @param bytes Number of bytes requested
+ * @return Pointer to memory the caller can now use, or NULL if @a
+ *         bytes is not cacheable or the heap is exhausted
+ */
+void *sys_heap_cache_refill(struct sys_heap_cache *cache,
+			    struct sys_heap *heap, size_t bytes);
+
+/** @brief Free a block, trimming its bin
+ *
+ * Frees @a mem to @a heap.  If the block's bin is full, half of the
+ * bin is returned to the heap as well.
+ *
+ * @param cache Cache that refused the block
+ * @param heap Heap the block was allocated from
+ * @param mem Block to free
+ */
+void sys_heap_cache_trim(struct sys_heap_cache *cache, struct sys_heap *heap,
+			 void *mem);
+
+/** @brief Return all cached blocks to the heap
+ *
+ * @param cache Cache to empty
+ * @param heap Heap the cached blocks were allocated from
+ */
+void sys_heap_cache_flush(struct sys_heap_cache *cache, struct sys_heap *heap);
+
+#endif /* CONFIG_SYS_HEAP_CACHE */
 
 #ifdef __cplusplus
 }
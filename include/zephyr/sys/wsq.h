@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef ZEPHYR_INCLUDE_SYS_WSQ_H_
+#define ZEPHYR_INCLUDE_SYS_WSQ_H_
+
+#include <zephyr/kernel.h>
+
+/* Zephyr Work-Stealing Queues
+ *
+ * A pool of worker threads, each with its own deque of work items.
+ * Workers run their own items newest first and, when they run out,
+ * steal the oldest item from another worker.  Work items follow the
+ * k_work rules: an item is queued at most once at a time, never runs
+ * concurrently with itself, and can be canceled or flushed.
+ */
+
+struct k_wsq_work;
+
+/**
+ * Work-stealing queue handler callback
+ */
+typedef void (*k_wsq_handler_t)(struct k_wsq_work *work);
+
+/* Work item state, as returned by k_wsq_work_busy_get() */
+#define K_WSQ_WORK_QUEUED	BIT(0)
+#define K_WSQ_WORK_RUNNING	BIT(1)
+#define K_WSQ_WORK_CANCELING	BIT(2)
+
+/**
+ * @brief Work-stealing queue work item
+ *
+ * Must be initialized with k_wsq_work_init() and not be modified by
+ * the caller afterwards.
+ */
+struct k_wsq_work {
+	/* reserved for implementation */
+	sys_dnode_t node;
+	k_wsq_handler_t handler;
+	struct k_wsq_worker *worker;
+	uint32_t flags;
+	uint32_t completions;
+};
+
+/**
+ * @brief Work-stealing queue synchronization object
+ *
+ * Used by k_wsq_flush() and k_wsq_cancel_sync() to wait for a work
+ * item.  Must stay valid until the call returns, and must not be on
+ * the stack on architectures where stacks aren't cache-coherent.
+ */
+struct k_wsq_sync {
+	/* reserved for implementation */
+	sys_snode_t node;
+	struct k_wsq_work *work;
+	uint32_t target;
+	struct k_sem sem;
+};
+
+/**
+ * @brief Work-stealing queue worker
+ *
+ * One per thread in the pool, private to the implementation.
+ */
+struct k_wsq_worker {
+	struct k_spinlock lock;
+
+	/* Items queued on this worker: the worker takes from the
+	 * tail, thieves from the head.
+	 */
+	sys_dlist_t deque;
+
+	struct k_wsq *queue;
+	struct k_thread thread;
+};
+
+/**
+ * @brief Work-stealing queue
+ */
+struct k_wsq {
+	/* Protects the waiter list and first-time item placement */
+	struct k_spinlock lock;
+
+	/* struct k_wsq_sync objects waiting on work items */
+	sys_slist_t waiters;
+
+	struct k_wsq_worker *workers;
+	uint32_t num_workers;
+	struct z_thread_stack_element *stacks;
+	size_t stack_size;
+
+	/* Round-robin placement of items submitted from outside */
+	atomic_t next;
+
+	/* Workers about to sleep or sleeping on idle_sem */
+	atomic_t idle;
+	struct k_sem idle_sem;
+};
+
+/**
+ * @brief Statically define a work-stealing queue
+ *
+ * Defines a struct k_wsq object with the specified number of worker
+ * threads.  The threads are created by k_wsq_start().
+ *
+ * @param name Symbol name of the struct k_wsq that will be defined
+ * @param n_threads Number of worker threads
+ * @param stack_sz Requested stack size of each thread, in bytes
+ */
+#define K_WSQ_DEFINE(name, n_threads, stack_sz)				\
+	static K_THREAD_STACK_ARRAY_DEFINE(_wsqstacks_##name,		\
+					   n_threads, stack_sz);	\
+	static struct k_wsq_worker _wsqworkers_##name[n_threads];	\
+	static struct k_wsq name = {					\
+		.workers = _wsqworkers_##name,				\
+		.num_workers = n_threads,				\
+		.stacks = &(_wsqstacks_##name[0][0]),			\
+		.stack_size = stack_sz,					\
+	}
+
+/**
+ * @brief Start a work-stealing queue
+ *
+ * Initializes the queue defined with K_WSQ_DEFINE() and starts its
+ * worker threads.  No other API may be used on the queue before this.
+ *
+ * @param queue Work-stealing queue to start
+ * @param prio Priority of the worker threads
+ */
+void k_wsq_start(struct k_wsq *queue, int prio);
+
+/**
+ * @brief Initialize a work-stealing queue work item
+ *
+ * @param work Work item to initialize
+ * @param handler Handler to invoke when the item runs
+ */
+void k_wsq_work_init(struct k_wsq_work *work, k_wsq_handler_t handler);
+
+/**
+ * @brief Get the state of a work item
+ *
+ * @param work Work item
+ *
+ * @return a mask of K_WSQ_WORK_QUEUED, K_WSQ_WORK_RUNNING and
+ * K_WSQ_WORK_CANCELING, zero if the item is idle.
+ */
+int k_wsq_work_busy_get(struct k_wsq_work *work);
+
+/**
+ * @brief Submit a work item to a work-stealing queue
+ *
+ * An item submitted from one of the queue's own workers is queued on
+ * that worker, otherwise on the worker that last ran it, or one chosen
+ * round-robin the first time.  An item that is running is queued on
+ * the worker running it, so that it won't run concurrently with
+ * itself.  Items are not run in submission order.  A work item must
+ * only ever be submitted to one queue.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param queue Work-stealing queue to submit to
+ * @param work Work item to submit
+ *
+ * @retval 0 if the item was already queued
+ * @retval 1 if the item was idle and has been queued
+ * @retval 2 if the item was running and has been queued again
+ * @retval -EBUSY if the item is being canceled
+ */
+int k_wsq_submit(struct k_wsq *queue, struct k_wsq_work *work);
+
+/**
+ * @brief Cancel a work item
+ *
+ * Removes the item from its queue if it is queued.  An item that is
+ * running can't be stopped: it is marked as canceling, which rejects
+ * new submissions until the handler returns.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param work Work item to cancel
+ *
+ * @return the state of the item after cancellation, as with
+ * k_wsq_work_busy_get().  Zero if it is now idle.
+ */
+int k_wsq_cancel(struct k_wsq_work *work);
+
+/**
+ * @brief Cancel a work item and wait for it to finish running
+ *
+ * @param work Work item to cancel
+ * @param sync Synchronization object
+ *
+ * @retval true if the item was queued or running
+ * @retval false if the item was idle
+ */
+bool k_wsq_cancel_sync(struct k_wsq_work *work, struct k_wsq_sync *sync);
+
+/**
+ * @brief Wait for the last submission of a work item to complete
+ *
+ * @param work Work item to flush
+ * @param sync Synchronization object
+ *
+ * @retval true if the item was queued or running and has completed
+ * @retval false if the item was idle
+ */
+bool k_wsq_flush(struct k_wsq_work *work, struct k_wsq_sync *sync);
+
+#endif /* ZEPHYR_INCLUDE_SYS_WSQ_H_ */
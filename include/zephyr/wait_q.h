@@ -38,7 +38,24 @@ static inline struct k_thread *z_waitq_head(_wait_q_t *w)
 	return (struct k_thread *)rb_get_min(&w->waitq.tree);
 }
 
-#else /* !CONFIG_WAITQ_SCALABLE: */
+#elif defined(CONFIG_WAITQ_MULTIQ)
+
+#define _WAIT_Q_FOR_EACH(wq, thread_ptr) \
+	SYS_DLIST_FOR_EACH_CONTAINER(&((wq)->waitq.list), thread_ptr, \
+				     base.qnode_dlist)
+
+static inline void z_waitq_init(_wait_q_t *w)
+{
+	sys_dlist_init(&w->waitq.list);
+	w->waitq.bitmask = 0;
+}
+
+static inline struct k_thread *z_waitq_head(_wait_q_t *w)
+{
+	return (struct k_thread *)sys_dlist_peek_head(&w->waitq.list);
+}
+
+#else /* !CONFIG_WAITQ_SCALABLE && !CONFIG_WAITQ_MULTIQ: */
 
 #define _WAIT_Q_FOR_EACH(wq, thread_ptr) \
 	SYS_DLIST_FOR_EACH_CONTAINER(&((wq)->waitq), thread_ptr, \
@@ -54,7 +71,7 @@ static inline struct k_thread *z_waitq_head(_wait_q_t *w)
 	return (struct k_thread *)sys_dlist_peek_head(&w->waitq);
 }
 
-#endif /* !CONFIG_WAITQ_SCALABLE */
+#endif /* !CONFIG_WAITQ_SCALABLE && !CONFIG_WAITQ_MULTIQ */
 
 #ifdef __cplusplus
 }
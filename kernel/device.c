@@ -5,8 +5,11 @@
  */
 
 #include <string.h>
+#include <kernel.h>
 #include <device.h>
+#include <init.h>
 #include <sys/atomic.h>
+#include <sys/printk.h>
 #include <syscall_handler.h>
 
 extern const struct init_entry __init_start[];
@@ -40,6 +43,213 @@ void z_device_state_init(void)
 	}
 }
 
+static void init_entry_run(const struct init_entry *entry)
+{
+	const struct device *dev = entry->dev;
+#ifdef CONFIG_DEVICE_INIT_TIMING
+	uint32_t start = k_cycle_get_32();
+#endif
+	int rc = entry->init(dev);
+
+#ifdef CONFIG_DEVICE_INIT_TIMING
+	uint32_t us = k_cyc_to_us_floor32(k_cycle_get_32() - start);
+
+	if (dev != NULL) {
+		printk("init %s: %u us\n", dev->name, us);
+	} else {
+		printk("init %p: %u us\n", entry->init, us);
+	}
+#endif
+
+	if (dev != NULL) {
+		/* Mark device initialized.  If initialization
+		 * failed, record the error condition.
+		 */
+		if (rc != 0) {
+			if (rc < 0) {
+				rc = -rc;
+			}
+			if (rc > UINT8_MAX) {
+				rc = UINT8_MAX;
+			}
+			dev->state->init_res = rc;
+		}
+		dev->state->initialized = true;
+	}
+}
+
+#ifdef CONFIG_DEVICE_INIT_PARALLEL
+/* Runs of consecutive device entries are initialized by a pool of
+ * threads, each device as soon as the devices it requires in the same
+ * run are initialized.  Other entries run alone in between, after
+ * everything before them has completed.
+ */
+struct init_worker {
+	struct k_thread thread;
+	struct k_sem go;
+	const struct init_entry *entry;
+};
+
+#define NUM_INIT_WORKERS CONFIG_DEVICE_INIT_PARALLEL_THREADS
+
+static K_THREAD_STACK_ARRAY_DEFINE(init_stacks, NUM_INIT_WORKERS,
+				   CONFIG_DEVICE_INIT_PARALLEL_STACK_SIZE);
+static struct init_worker init_workers[NUM_INIT_WORKERS];
+static K_SEM_DEFINE(init_done, 0, NUM_INIT_WORKERS);
+
+static void init_worker_main(void *p1, void *p2, void *p3)
+{
+	struct init_worker *w = p1;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		k_sem_take(&w->go, K_FOREVER);
+		if (w->entry == NULL) {
+			break;
+		}
+		init_entry_run(w->entry);
+		w->entry = NULL;
+		k_sem_give(&init_done);
+	}
+}
+
+static bool init_in_run(const struct device *dev,
+			const struct init_entry *first,
+			const struct init_entry *last)
+{
+	for (const struct init_entry *entry = first; entry < last; entry++) {
+		if (entry->dev == dev) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static bool init_started(const struct init_entry *entry)
+{
+	if (entry->dev->state->initialized) {
+		return true;
+	}
+
+	for (int i = 0; i < NUM_INIT_WORKERS; i++) {
+		if (init_workers[i].entry == entry) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static bool init_ready(const struct init_entry *entry,
+		       const struct init_entry *first,
+		       const struct init_entry *last)
+{
+	size_t count = 0;
+	const device_handle_t *deps;
+
+	deps = device_required_handles_get(entry->dev, &count);
+	for (size_t i = 0; i < count; i++) {
+		const struct device *dep = device_from_handle(deps[i]);
+
+		if ((dep != NULL) && !dep->state->initialized &&
+		    init_in_run(dep, first, last)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static void init_dispatch(const struct init_entry *entry)
+{
+	for (int i = 0; i < NUM_INIT_WORKERS; i++) {
+		if (init_workers[i].entry == NULL) {
+			init_workers[i].entry = entry;
+			k_sem_give(&init_workers[i].go);
+			return;
+		}
+	}
+
+	__ASSERT(false, "no idle init worker");
+}
+
+static void init_run_devices(const struct init_entry *first,
+			     const struct init_entry *last)
+{
+	size_t pending = last - first;
+	int busy = 0;
+
+	while ((pending > 0) || (busy > 0)) {
+		const struct init_entry *entry;
+		bool started = false;
+
+		for (entry = first; (entry < last) && (busy < NUM_INIT_WORKERS);
+		     entry++) {
+			if (!init_started(entry) &&
+			    init_ready(entry, first, last)) {
+				init_dispatch(entry);
+				started = true;
+				pending--;
+				busy++;
+			}
+		}
+
+		if (started) {
+			continue;
+		}
+
+		if (busy > 0) {
+			k_sem_take(&init_done, K_FOREVER);
+			busy--;
+		} else {
+			/* Dependencies can't be met, fall back to link order */
+			for (entry = first; init_started(entry); entry++) {
+			}
+			init_entry_run(entry);
+			pending--;
+		}
+	}
+}
+
+static void init_run_parallel(const struct init_entry *first,
+			      const struct init_entry *last)
+{
+	const struct init_entry *entry = first;
+
+	for (int i = 0; i < NUM_INIT_WORKERS; i++) {
+		k_sem_init(&init_workers[i].go, 0, 1);
+		k_thread_create(&init_workers[i].thread, init_stacks[i],
+				K_THREAD_STACK_SIZEOF(init_stacks[i]),
+				init_worker_main, &init_workers[i], NULL, NULL,
+				CONFIG_MAIN_THREAD_PRIORITY, 0, K_NO_WAIT);
+		k_thread_name_set(&init_workers[i].thread, "init");
+	}
+
+	while (entry < last) {
+		const struct init_entry *run_end = entry;
+
+		while ((run_end < last) && (run_end->dev != NULL)) {
+			run_end++;
+		}
+
+		if (run_end == entry) {
+			init_entry_run(entry++);
+		} else {
+			init_run_devices(entry, run_end);
+			entry = run_end;
+		}
+	}
+
+	for (int i = 0; i < NUM_INIT_WORKERS; i++) {
+		k_sem_give(&init_workers[i].go);
+		k_thread_join(&init_workers[i].thread, K_FOREVER);
+	}
+}
+#endif /* CONFIG_DEVICE_INIT_PARALLEL */
+
 /**
  * @brief Execute all the init entry initialization functions at a given level
  *
@@ -47,7 +257,9 @@ void z_device_state_init(void)
  * created by the INIT_ENTRY_DEFINE() macro using the specified level.
  * The linker script places the init entry objects in memory in the order
  * they need to be invoked, with symbols indicating where one level leaves
- * off and the next one begins.
+ * off and the next one begins.  With CONFIG_DEVICE_INIT_PARALLEL, devices
+ * of the POST_KERNEL and APPLICATION levels are initialized concurrently
+ * where their devicetree dependencies allow.
  *
  * @param level init level to run.
  */
@@ -66,25 +278,16 @@ void z_sys_init_run_level(int32_t level)
 	};
 	const struct init_entry *entry;
 
+#ifdef CONFIG_DEVICE_INIT_PARALLEL
+	if ((level == _SYS_INIT_LEVEL_POST_KERNEL) ||
+	    (level == _SYS_INIT_LEVEL_APPLICATION)) {
+		init_run_parallel(levels[level], levels[level+1]);
+		return;
+	}
+#endif
+
 	for (entry = levels[level]; entry < levels[level+1]; entry++) {
-		const struct device *dev = entry->dev;
-		int rc = entry->init(dev);
-
-		if (dev != NULL) {
-			/* Mark device initialized.  If initialization
-			 * failed, record the error condition.
-			 */
-			if (rc != 0) {
-				if (rc < 0) {
-					rc = -rc;
-				}
-				if (rc > UINT8_MAX) {
-					rc = UINT8_MAX;
-				}
-				dev->state->init_res = rc;
-			}
-			dev->state->initialized = true;
-		}
+		init_entry_run(entry);
 	}
 }
 
@@ -47,6 +47,9 @@ void z_impl_k_event_init(struct k_event *event)
 	SYS_PORT_TRACING_OBJ_INIT(k_event, event);
 
 	z_waitq_init(&event->wait_q);
+#ifdef CONFIG_POLL
+	sys_dlist_init(&event->poll_events);
+#endif
 
 	z_object_init(event);
 }
@@ -142,6 +145,14 @@ static void k_event_post_internal(struct k_event *event, uint32_t events,
 		} while (thread != NULL);
 	}
 
+#ifdef CONFIG_POLL
+	/* Every poller gets to see the events, as every waiter does */
+	while ((events != 0U) && !sys_dlist_is_empty(&event->poll_events)) {
+		z_handle_obj_poll_events(&event->poll_events,
+					 K_POLL_STATE_EVENT_POSTED);
+	}
+#endif
+
 	z_reschedule(&event->lock, key);
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_event, post, event, events,
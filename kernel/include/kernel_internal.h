@@ -289,6 +289,16 @@ void z_paging_histogram_inc(struct k_mem_paging_histogram_t *hist,
 			    uint32_t cycles);
 #endif /* CONFIG_DEMAND_PAGING_TIMING_HISTOGRAM */
 
+#if defined(CONFIG_POLL) && defined(CONFIG_SYNC_FAST_PATH)
+/**
+ * Flag a mutex as contended, locked or not, so that its next release
+ * takes the slow path and signals the poll events registered on it.
+ *
+ * @param mutex Mutex a poll event has been registered on
+ */
+void z_mutex_poll_contend(struct k_mutex *mutex);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
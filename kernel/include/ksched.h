@@ -64,6 +64,7 @@ void z_ready_thread(struct k_thread *thread);
 void z_requeue_current(struct k_thread *curr);
 struct k_thread *z_swap_next_thread(void);
 void z_thread_abort(struct k_thread *thread);
+bool z_thread_active_elsewhere(struct k_thread *thread);
 
 static inline void z_pend_curr_unlocked(_wait_q_t *wait_q, k_timeout_t timeout)
 {
@@ -396,6 +397,30 @@ void z_sched_cpu_usage(uint8_t core_id, struct k_thread_runtime_stats *stats);
 void z_sched_thread_usage(struct k_thread *thread,
 			  struct k_thread_runtime_stats *stats);
 
+#ifdef CONFIG_SCHED_LATENCY_STATS
+/**
+ * @brief Timestamps a thread made ready, for its wakeup latency
+ */
+void z_sched_latency_ready(struct k_thread *thread);
+#else
+static inline void z_sched_latency_ready(struct k_thread *thread)
+{
+	ARG_UNUSED(thread);
+}
+#endif
+
+#ifdef CONFIG_SCHED_CBS
+/**
+ * @brief Starts charging a constant bandwidth server switched in
+ */
+void z_sched_cbs_start(struct k_thread *thread);
+
+/**
+ * @brief Charges the constant bandwidth server switched out, if any
+ */
+void z_sched_cbs_stop(void);
+#endif
+
 static inline void z_sched_usage_switch(struct k_thread *thread)
 {
 	ARG_UNUSED(thread);
@@ -403,6 +428,10 @@ static inline void z_sched_usage_switch(struct k_thread *thread)
 	z_sched_usage_stop();
 	z_sched_usage_start(thread);
 #endif
+#ifdef CONFIG_SCHED_CBS
+	z_sched_cbs_stop();
+	z_sched_cbs_start(thread);
+#endif
 }
 
 #endif /* ZEPHYR_KERNEL_INCLUDE_KSCHED_H_ */
@@ -9,11 +9,16 @@
 #include <wait_q.h>
 #include <init.h>
 #include <linker/linker-defs.h>
+#include <sys/check.h>
 
 void k_heap_init(struct k_heap *h, void *mem, size_t bytes)
 {
 	z_waitq_init(&h->wait_q);
 	sys_heap_init(&h->heap, mem, bytes);
+#ifdef CONFIG_SYS_HEAP_CACHE
+	h->cpu_cache = NULL;
+	atomic_clear(&h->cache_waiters);
+#endif
 
 	SYS_PORT_TRACING_OBJ_INIT(k_heap, h);
 }
@@ -61,21 +66,160 @@ SYS_INIT(statics_init, PRE_KERNEL_1, CONFIG_KERNEL_INIT_PRIORITY_OBJECTS);
 SYS_INIT(statics_init, POST_KERNEL, 0);
 #endif /* CONFIG_DEMAND_PAGING && !CONFIG_LINKER_GENERIC_SECTIONS_PRESENT_AT_BOOT */
 
+#ifdef CONFIG_SYS_HEAP_CACHE
+/*
+ * Per-CPU size-class caches.  Each cache has its own lock, which is
+ * only contended while another CPU reclaims the cache's blocks.  Lock
+ * ordering is h->lock before any cache lock.
+ */
+int k_heap_cache_enable(struct k_heap *h, struct k_heap_cache *caches)
+{
+	CHECKIF(caches == NULL) {
+		return -EINVAL;
+	}
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		caches[i] = (struct k_heap_cache) {};
+		sys_heap_cache_init(&caches[i].cache, sizeof(void *));
+	}
+
+	LOCKED(&h->lock) {
+		h->cpu_cache = caches;
+	}
+
+	return 0;
+}
+
+static bool cacheable(struct k_heap *h, size_t align)
+{
+	return (h->cpu_cache != NULL) && (align <= sizeof(void *));
+}
+
+static void *cache_alloc(struct k_heap *h, size_t bytes)
+{
+	unsigned int irq_key = arch_irq_lock();
+	struct k_heap_cache *c = &h->cpu_cache[arch_curr_cpu()->id];
+	k_spinlock_key_t key = k_spin_lock(&c->lock);
+	void *ret = sys_heap_cache_get(&c->cache, bytes);
+
+	k_spin_unlock(&c->lock, key);
+	arch_irq_unlock(irq_key);
+
+	return ret;
+}
+
+static bool cache_free(struct k_heap *h, void *mem)
+{
+	unsigned int irq_key = arch_irq_lock();
+	struct k_heap_cache *c = &h->cpu_cache[arch_curr_cpu()->id];
+	k_spinlock_key_t key = k_spin_lock(&c->lock);
+	bool hit = false;
+
+	/* Memory must not be parked in a cache while someone waits
+	 * for some, see heap_alloc().
+	 */
+	if (atomic_get(&h->cache_waiters) == 0) {
+		hit = sys_heap_cache_put(&c->cache, &h->heap, mem);
+	}
+
+	k_spin_unlock(&c->lock, key);
+	arch_irq_unlock(irq_key);
+
+	return hit;
+}
+
+/* Allocates through the current CPU's cache, h->lock held */
+static void *cache_refill(struct k_heap *h, size_t bytes)
+{
+	struct k_heap_cache *c = &h->cpu_cache[_current_cpu->id];
+	k_spinlock_key_t key = k_spin_lock(&c->lock);
+	void *ret = sys_heap_cache_refill(&c->cache, &h->heap, bytes);
+
+	k_spin_unlock(&c->lock, key);
+
+	return ret;
+}
+
+/* Frees through the current CPU's cache, h->lock held */
+static void cache_trim(struct k_heap *h, void *mem)
+{
+	struct k_heap_cache *c = &h->cpu_cache[_current_cpu->id];
+	k_spinlock_key_t key = k_spin_lock(&c->lock);
+
+	sys_heap_cache_trim(&c->cache, &h->heap, mem);
+
+	k_spin_unlock(&c->lock, key);
+}
+
+/* Returns the blocks cached by all CPUs to the heap, h->lock held */
+static void cache_reclaim(struct k_heap *h)
+{
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		struct k_heap_cache *c = &h->cpu_cache[i];
+		k_spinlock_key_t key = k_spin_lock(&c->lock);
+
+		sys_heap_cache_flush(&c->cache, &h->heap);
+
+		k_spin_unlock(&c->lock, key);
+	}
+}
+#endif /* CONFIG_SYS_HEAP_CACHE */
+
+/* h->lock held */
+static void *heap_alloc(struct k_heap *h, size_t align, size_t bytes)
+{
+	void *ret = NULL;
+
+#ifdef CONFIG_SYS_HEAP_CACHE
+	if (cacheable(h, align) && (atomic_get(&h->cache_waiters) == 0)) {
+		ret = cache_refill(h, bytes);
+	}
+#endif
+
+	if (ret == NULL) {
+		ret = sys_heap_aligned_alloc(&h->heap, align, bytes);
+	}
+
+#ifdef CONFIG_SYS_HEAP_CACHE
+	if ((ret == NULL) && (h->cpu_cache != NULL)) {
+		cache_reclaim(h);
+		ret = sys_heap_aligned_alloc(&h->heap, align, bytes);
+	}
+#endif
+
+	return ret;
+}
+
 void *k_heap_aligned_alloc(struct k_heap *h, size_t align, size_t bytes,
 			k_timeout_t timeout)
 {
 	int64_t now, end = sys_clock_timeout_end_calc(timeout);
 	void *ret = NULL;
-	k_spinlock_key_t key = k_spin_lock(&h->lock);
+	k_spinlock_key_t key;
+#ifdef CONFIG_SYS_HEAP_CACHE
+	bool waiter = false;
+#endif
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_heap, aligned_alloc, h, timeout);
 
 	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
 
+#ifdef CONFIG_SYS_HEAP_CACHE
+	if (cacheable(h, align)) {
+		ret = cache_alloc(h, bytes);
+		if (ret != NULL) {
+			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_heap, aligned_alloc, h, timeout, ret);
+			return ret;
+		}
+	}
+#endif
+
+	key = k_spin_lock(&h->lock);
+
 	bool blocked_alloc = false;
 
 	while (ret == NULL) {
-		ret = sys_heap_aligned_alloc(&h->heap, align, bytes);
+		ret = heap_alloc(h, align, bytes);
 
 		now = sys_clock_tick_get();
 		if (!IS_ENABLED(CONFIG_MULTITHREADING) ||
@@ -83,6 +227,18 @@ void *k_heap_aligned_alloc(struct k_heap *h, size_t align, size_t bytes,
 			break;
 		}
 
+#ifdef CONFIG_SYS_HEAP_CACHE
+		if ((h->cpu_cache != NULL) && !waiter) {
+			/* Announce the waiter, then retry: the reclaim in
+			 * heap_alloc() now also catches memory freed into
+			 * a cache before other CPUs saw the announcement.
+			 */
+			atomic_inc(&h->cache_waiters);
+			waiter = true;
+			continue;
+		}
+#endif
+
 		if (!blocked_alloc) {
 			blocked_alloc = true;
 
@@ -98,6 +254,12 @@ void *k_heap_aligned_alloc(struct k_heap *h, size_t align, size_t bytes,
 		key = k_spin_lock(&h->lock);
 	}
 
+#ifdef CONFIG_SYS_HEAP_CACHE
+	if (waiter) {
+		atomic_dec(&h->cache_waiters);
+	}
+#endif
+
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_heap, aligned_alloc, h, timeout, ret);
 
 	k_spin_unlock(&h->lock, key);
@@ -117,9 +279,26 @@ void *k_heap_alloc(struct k_heap *h, size_t bytes, k_timeout_t timeout)
 
 void k_heap_free(struct k_heap *h, void *mem)
 {
-	k_spinlock_key_t key = k_spin_lock(&h->lock);
+	k_spinlock_key_t key;
 
+#ifdef CONFIG_SYS_HEAP_CACHE
+	if ((h->cpu_cache != NULL) && (mem != NULL) && cache_free(h, mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC(k_heap, free, h);
+		return;
+	}
+#endif
+
+	key = k_spin_lock(&h->lock);
+
+#ifdef CONFIG_SYS_HEAP_CACHE
+	if ((h->cpu_cache != NULL) && (mem != NULL)) {
+		cache_trim(h, mem);
+	} else {
+		sys_heap_free(&h->heap, mem);
+	}
+#else
 	sys_heap_free(&h->heap, mem);
+#endif
 
 	SYS_PORT_TRACING_OBJ_FUNC(k_heap, free, h);
 	if (IS_ENABLED(CONFIG_MULTITHREADING) && z_unpend_all(&h->wait_q) != 0) {
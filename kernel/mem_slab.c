@@ -88,6 +88,11 @@ int k_mem_slab_init(struct k_mem_slab *slab, void *buffer,
 	slab->max_used = 0U;
 #endif
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	slab->cpu_cache = NULL;
+	atomic_clear(&slab->cache_waiters);
+#endif
+
 	rc = create_free_list(slab);
 	if (rc < 0) {
 		goto out;
@@ -101,19 +106,204 @@ out:
 	return rc;
 }
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+/*
+ * Per-CPU caches ("magazines") of free blocks.  Each cache has its
+ * own lock, which is only contended while another CPU reclaims the
+ * cache's blocks.  Lock ordering is slab->lock before any cache lock.
+ * A block in a cache is accounted as used in slab->num_used, i.e. that
+ * counts blocks missing from the free list.
+ */
+#define CACHE_SIZE	CONFIG_MEM_SLAB_CPU_CACHE_SIZE
+#define CACHE_BATCH	(CONFIG_MEM_SLAB_CPU_CACHE_SIZE / 2)
+
+int k_mem_slab_cache_enable(struct k_mem_slab *slab,
+			    struct k_mem_slab_cache *caches)
+{
+	CHECKIF(caches == NULL) {
+		return -EINVAL;
+	}
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		caches[i] = (struct k_mem_slab_cache) {};
+	}
+
+	LOCKED(&slab->lock) {
+		slab->cpu_cache = caches;
+	}
+
+	return 0;
+}
+
+uint32_t z_mem_slab_num_cached(struct k_mem_slab *slab)
+{
+	uint32_t count = 0U;
+
+	if (slab->cpu_cache != NULL) {
+		for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+			count += slab->cpu_cache[i].count;
+		}
+	}
+
+	return count;
+}
+
+void k_mem_slab_cache_stats_get(struct k_mem_slab *slab,
+				struct k_mem_slab_cache_stats *stats)
+{
+	*stats = (struct k_mem_slab_cache_stats) {};
+
+	if (slab->cpu_cache == NULL) {
+		return;
+	}
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		struct k_mem_slab_cache *c = &slab->cpu_cache[i];
+
+		stats->alloc_hits += c->alloc_hits;
+		stats->alloc_misses += c->alloc_misses;
+		stats->free_hits += c->free_hits;
+		stats->free_misses += c->free_misses;
+	}
+}
+
+static bool cache_alloc(struct k_mem_slab *slab, void **mem)
+{
+	unsigned int irq_key = arch_irq_lock();
+	struct k_mem_slab_cache *c = &slab->cpu_cache[arch_curr_cpu()->id];
+	k_spinlock_key_t key = k_spin_lock(&c->lock);
+	bool hit = c->count > 0U;
+
+	if (hit) {
+		*mem = c->blocks[--c->count];
+		c->alloc_hits++;
+	} else {
+		c->alloc_misses++;
+	}
+
+	k_spin_unlock(&c->lock, key);
+	arch_irq_unlock(irq_key);
+
+	return hit;
+}
+
+static bool cache_free(struct k_mem_slab *slab, void *mem)
+{
+	unsigned int irq_key = arch_irq_lock();
+	struct k_mem_slab_cache *c = &slab->cpu_cache[arch_curr_cpu()->id];
+	k_spinlock_key_t key = k_spin_lock(&c->lock);
+	bool hit = (c->count < CACHE_SIZE) &&
+		   (atomic_get(&slab->cache_waiters) == 0);
+
+	/* Blocks must not be parked in a cache while someone waits for
+	 * one, see the reclaim in k_mem_slab_alloc().
+	 */
+	if (hit) {
+		c->blocks[c->count++] = mem;
+		c->free_hits++;
+	} else {
+		c->free_misses++;
+	}
+
+	k_spin_unlock(&c->lock, key);
+	arch_irq_unlock(irq_key);
+
+	return hit;
+}
+
+/* Moves up to @a n blocks from the free list into the current CPU's
+ * cache, slab->lock held.
+ */
+static void cache_refill(struct k_mem_slab *slab, uint32_t n)
+{
+	struct k_mem_slab_cache *c = &slab->cpu_cache[_current_cpu->id];
+	k_spinlock_key_t key = k_spin_lock(&c->lock);
+
+	while ((n-- > 0U) && (c->count < CACHE_SIZE) &&
+	       (slab->free_list != NULL)) {
+		c->blocks[c->count++] = slab->free_list;
+		slab->free_list = *(char **)(slab->free_list);
+		slab->num_used++;
+	}
+
+	k_spin_unlock(&c->lock, key);
+}
+
+/* Moves up to @a n blocks of a cache back to the free list,
+ * slab->lock held.
+ */
+static void cache_flush(struct k_mem_slab *slab, struct k_mem_slab_cache *c,
+			uint32_t n)
+{
+	k_spinlock_key_t key = k_spin_lock(&c->lock);
+
+	while ((n-- > 0U) && (c->count > 0U)) {
+		char *block = c->blocks[--c->count];
+
+		*(char **)block = slab->free_list;
+		slab->free_list = block;
+		slab->num_used--;
+	}
+
+	k_spin_unlock(&c->lock, key);
+}
+
+static void cache_reclaim(struct k_mem_slab *slab)
+{
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		cache_flush(slab, &slab->cpu_cache[i], CACHE_SIZE);
+	}
+}
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
+
 int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 {
-	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+	k_spinlock_key_t key;
 	int result;
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	bool waiter = false;
+#endif
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, alloc, slab, timeout);
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	if ((slab->cpu_cache != NULL) && cache_alloc(slab, mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, alloc, slab, timeout, 0);
+		return 0;
+	}
+#endif
+
+	key = k_spin_lock(&slab->lock);
+
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	if ((slab->free_list == NULL) && (slab->cpu_cache != NULL)) {
+		/* Announce the waiter before reclaiming, so no CPU parks
+		 * a freed block in its cache once its cache has been
+		 * emptied here.
+		 */
+		if (!K_TIMEOUT_EQ(timeout, K_NO_WAIT) &&
+		    IS_ENABLED(CONFIG_MULTITHREADING)) {
+			atomic_inc(&slab->cache_waiters);
+			waiter = true;
+		}
+		cache_reclaim(slab);
+	}
+#endif
+
 	if (slab->free_list != NULL) {
 		/* take a free block */
 		*mem = slab->free_list;
 		slab->free_list = *(char **)(slab->free_list);
 		slab->num_used++;
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+		if (waiter) {
+			atomic_dec(&slab->cache_waiters);
+		} else if (slab->cpu_cache != NULL) {
+			cache_refill(slab, CACHE_BATCH);
+		}
+#endif
+
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 		slab->max_used = MAX(slab->num_used, slab->max_used);
 #endif
@@ -133,6 +323,12 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 			*mem = _current->base.swap_data;
 		}
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+		if (waiter) {
+			atomic_dec(&slab->cache_waiters);
+		}
+#endif
+
 		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, alloc, slab, timeout, result);
 
 		return result;
@@ -147,9 +343,19 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 
 void k_mem_slab_free(struct k_mem_slab *slab, void **mem)
 {
-	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+	k_spinlock_key_t key;
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, free, slab);
+
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	if ((slab->cpu_cache != NULL) && cache_free(slab, *mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
+		return;
+	}
+#endif
+
+	key = k_spin_lock(&slab->lock);
+
 	if (slab->free_list == NULL && IS_ENABLED(CONFIG_MULTITHREADING)) {
 		struct k_thread *pending_thread = z_unpend_first_thread(&slab->wait_q);
 
@@ -166,6 +372,15 @@ void k_mem_slab_free(struct k_mem_slab *slab, void **mem)
 	slab->free_list = *(char **) mem;
 	slab->num_used--;
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	/* Make room in this CPU's cache for the next frees */
+	if ((slab->cpu_cache != NULL) &&
+	    (atomic_get(&slab->cache_waiters) == 0)) {
+		cache_flush(slab, &slab->cpu_cache[_current_cpu->id],
+			    CACHE_BATCH);
+	}
+#endif
+
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
 
 	k_spin_unlock(&slab->lock, key);
@@ -5,6 +5,7 @@
  */
 
 #include <kernel.h>
+#include <init.h>
 #include <string.h>
 #include <sys/math_extras.h>
 #include <sys/util.h>
@@ -61,6 +62,20 @@ void k_free(void *ptr)
 K_HEAP_DEFINE(_system_heap, CONFIG_HEAP_MEM_POOL_SIZE);
 #define _SYSTEM_HEAP (&_system_heap)
 
+#ifdef CONFIG_SYS_HEAP_CACHE
+static struct k_heap_cache system_heap_caches[CONFIG_MP_NUM_CPUS];
+
+static int system_heap_cache_init(const struct device *unused)
+{
+	ARG_UNUSED(unused);
+
+	return k_heap_cache_enable(_SYSTEM_HEAP, system_heap_caches);
+}
+
+/* The heap itself is initialized in PRE_KERNEL_1 */
+SYS_INIT(system_heap_cache_init, PRE_KERNEL_2, CONFIG_KERNEL_INIT_PRIORITY_OBJECTS);
+#endif
+
 void *k_aligned_alloc(size_t align, size_t size)
 {
 	__ASSERT(align / sizeof(void *) >= 1
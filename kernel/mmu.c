@@ -1312,14 +1312,146 @@ static inline struct z_page_frame *do_eviction_select(bool *dirty)
 	return pf;
 }
 
+/* Bring the data page at addr in from page_in_location in the backing
+ * store, evicting another data page if there is no free page frame.
+ *
+ * Called with interrupts locked. With CONFIG_DEMAND_PAGING_ALLOW_IRQ they
+ * are unlocked around the backing store transfers, so *key_ptr is updated
+ * with the key of the final irq_lock().
+ */
+static struct z_page_frame *page_in_locked(void *addr,
+					   uintptr_t page_in_location,
+					   struct k_thread *faulting_thread,
+					   int *key_ptr)
+{
+	struct z_page_frame *pf;
+	uintptr_t page_out_location;
+	bool dirty = false;
+	int ret;
+
+	pf = free_page_frame_list_get();
+	if (pf == NULL) {
+		/* Need to evict a page frame */
+		pf = do_eviction_select(&dirty);
+		__ASSERT(pf != NULL, "failed to get a page frame");
+		LOG_DBG("evicting %p at 0x%lx", pf->addr,
+			z_page_frame_to_phys(pf));
+
+		paging_stats_eviction_inc(faulting_thread, dirty);
+	}
+	ret = page_frame_prepare_locked(pf, &dirty, true, &page_out_location);
+	__ASSERT(ret == 0, "failed to prepare page frame");
+
+#ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
+	irq_unlock(*key_ptr);
+	/* Interrupts are now unlocked if they were not locked when we entered
+	 * this function, and we may service ISRs. The scheduler is still
+	 * locked.
+	 */
+#endif /* CONFIG_DEMAND_PAGING_ALLOW_IRQ */
+	if (dirty) {
+		do_backing_store_page_out(page_out_location);
+	}
+	do_backing_store_page_in(page_in_location);
+
+#ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
+	*key_ptr = irq_lock();
+	pf->flags &= ~Z_PAGE_FRAME_BUSY;
+#endif /* CONFIG_DEMAND_PAGING_ALLOW_IRQ */
+	pf->flags |= Z_PAGE_FRAME_MAPPED;
+	pf->addr = UINT_TO_POINTER(POINTER_TO_UINT(addr)
+				   & ~(CONFIG_MMU_PAGE_SIZE - 1));
+
+	arch_mem_page_in(addr, z_page_frame_to_phys(pf));
+	k_mem_paging_backing_store_page_finalize(pf, page_in_location);
+
+	return pf;
+}
+
+#if CONFIG_DEMAND_PAGING_READ_AHEAD > 0
+/*
+ * After a page fault, also bring in the data pages that follow the
+ * faulting one, up to CONFIG_DEMAND_PAGING_READ_AHEAD of them, stopping at
+ * the first that isn't paged out. Code and sequentially accessed data then
+ * take one fault per cluster instead of one per page.
+ *
+ * Pages read ahead are mapped with their accessed state clear, so the
+ * eviction algorithm takes them back first if they go unused. While the
+ * cluster is being filled its frames are pinned, so that reading ahead
+ * never evicts the page that faulted or another page of the same cluster.
+ * The cluster is thus capped to the free and evictable frames minus one,
+ * so that pinning it never leaves nothing to evict.
+ */
+static size_t read_ahead_window_locked(void)
+{
+	uintptr_t phys;
+	struct z_page_frame *pf;
+	size_t frames = z_free_page_count;
+
+	Z_PAGE_FRAME_FOREACH(phys, pf) {
+		if (z_page_frame_is_evictable(pf)) {
+			frames++;
+		}
+	}
+
+	return (frames > 1U) ?
+		MIN(frames - 1U, CONFIG_DEMAND_PAGING_READ_AHEAD) : 0U;
+}
+
+static void read_ahead_locked(struct z_page_frame *fault_pf,
+			      struct k_thread *faulting_thread, int *key_ptr)
+{
+	struct z_page_frame *cluster[CONFIG_DEMAND_PAGING_READ_AHEAD + 1];
+	uint8_t *pos = fault_pf->addr;
+	uintptr_t page_in_location;
+	size_t count = 0;
+	size_t window;
+
+	cluster[count++] = fault_pf;
+	fault_pf->flags |= Z_PAGE_FRAME_PINNED;
+	window = read_ahead_window_locked();
+
+	for (size_t i = 0; i < window; i++) {
+		struct z_page_frame *pf;
+
+		pos += CONFIG_MMU_PAGE_SIZE;
+		if (pos >= Z_VIRT_RAM_END ||
+		    arch_page_location_get(pos, &page_in_location) !=
+		    ARCH_PAGE_LOCATION_PAGED_OUT) {
+			break;
+		}
+
+		pf = page_in_locked(pos, page_in_location, faulting_thread,
+				    key_ptr);
+		pf->flags |= Z_PAGE_FRAME_PINNED;
+		cluster[count++] = pf;
+#ifdef CONFIG_DEMAND_PAGING_STATS
+		paging_stats.pagefaults.read_ahead++;
+#ifdef CONFIG_DEMAND_PAGING_THREAD_STATS
+		faulting_thread->paging_stats.pagefaults.read_ahead++;
+#endif
+#endif /* CONFIG_DEMAND_PAGING_STATS */
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		cluster[i]->flags &= ~Z_PAGE_FRAME_PINNED;
+	}
+}
+#else
+static inline void read_ahead_locked(struct z_page_frame *fault_pf,
+				     struct k_thread *faulting_thread,
+				     int *key_ptr)
+{
+}
+#endif /* CONFIG_DEMAND_PAGING_READ_AHEAD > 0 */
+
 static bool do_page_fault(void *addr, bool pin)
 {
 	struct z_page_frame *pf;
-	int key, ret;
-	uintptr_t page_in_location, page_out_location;
+	int key;
+	uintptr_t page_in_location;
 	enum arch_page_location status;
 	bool result;
-	bool dirty = false;
 	struct k_thread *faulting_thread = _current_cpu->current;
 
 	__ASSERT(page_frames_initialized, "page fault at %p happened too early",
@@ -1393,44 +1525,12 @@ static bool do_page_fault(void *addr, bool pin)
 
 	paging_stats_faults_inc(faulting_thread, key);
 
-	pf = free_page_frame_list_get();
-	if (pf == NULL) {
-		/* Need to evict a page frame */
-		pf = do_eviction_select(&dirty);
-		__ASSERT(pf != NULL, "failed to get a page frame");
-		LOG_DBG("evicting %p at 0x%lx", pf->addr,
-			z_page_frame_to_phys(pf));
-
-		paging_stats_eviction_inc(faulting_thread, dirty);
-	}
-	ret = page_frame_prepare_locked(pf, &dirty, true, &page_out_location);
-	__ASSERT(ret == 0, "failed to prepare page frame");
-
-#ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
-	irq_unlock(key);
-	/* Interrupts are now unlocked if they were not locked when we entered
-	 * this function, and we may service ISRs. The scheduler is still
-	 * locked.
-	 */
-#endif /* CONFIG_DEMAND_PAGING_ALLOW_IRQ */
-	if (dirty) {
-		do_backing_store_page_out(page_out_location);
-	}
-	do_backing_store_page_in(page_in_location);
-
-#ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
-	key = irq_lock();
-	pf->flags &= ~Z_PAGE_FRAME_BUSY;
-#endif /* CONFIG_DEMAND_PAGING_ALLOW_IRQ */
+	pf = page_in_locked(addr, page_in_location, faulting_thread, &key);
 	if (pin) {
 		pf->flags |= Z_PAGE_FRAME_PINNED;
+	} else {
+		read_ahead_locked(pf, faulting_thread, &key);
 	}
-	pf->flags |= Z_PAGE_FRAME_MAPPED;
-	pf->addr = UINT_TO_POINTER(POINTER_TO_UINT(addr)
-				   & ~(CONFIG_MMU_PAGE_SIZE - 1));
-
-	arch_mem_page_in(addr, z_page_frame_to_phys(pf));
-	k_mem_paging_backing_store_page_finalize(pf, page_in_location);
 out:
 	irq_unlock(key);
 #ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
@@ -28,7 +28,9 @@
 #ifdef CONFIG_POLL
 static inline void handle_poll_events(struct k_msgq *msgq, uint32_t state)
 {
-	z_handle_obj_poll_events(&msgq->poll_events, state);
+	z_handle_obj_poll_events((state == K_POLL_STATE_MSGQ_SPACE_AVAILABLE) ?
+				 &msgq->space_poll_events : &msgq->poll_events,
+				 state);
 }
 #endif /* CONFIG_POLL */
 
@@ -39,14 +41,25 @@ void k_msgq_init(struct k_msgq *msgq, char *buffer, size_t msg_size,
 	msgq->max_msgs = max_msgs;
 	msgq->buffer_start = buffer;
 	msgq->buffer_end = buffer + (max_msgs * msg_size);
+#ifdef CONFIG_MSGQ_LOCKFREE
+	(void)atomic_set(&msgq->prod_head, 0);
+	(void)atomic_set(&msgq->prod_tail, 0);
+	(void)atomic_set(&msgq->cons_head, 0);
+	(void)atomic_set(&msgq->cons_tail, 0);
+	msgq->seq_limit = Z_MSGQ_SEQ_LIMIT(max_msgs);
+	(void)atomic_set(&msgq->waiters, 0);
+	msgq->readers_waiting = false;
+#else
 	msgq->read_ptr = buffer;
 	msgq->write_ptr = buffer;
 	msgq->used_msgs = 0;
+#endif
 	msgq->flags = 0;
 	z_waitq_init(&msgq->wait_q);
 	msgq->lock = (struct k_spinlock) {};
 #ifdef CONFIG_POLL
 	sys_dlist_init(&msgq->poll_events);
+	sys_dlist_init(&msgq->space_poll_events);
 #endif	/* CONFIG_POLL */
 
 	SYS_PORT_TRACING_OBJ_INIT(k_msgq, msgq);
@@ -113,6 +126,252 @@ int k_msgq_cleanup(struct k_msgq *msgq)
 }
 
 
+#ifdef CONFIG_MSGQ_LOCKFREE
+/*
+ * Lock-free message ring.
+ *
+ * Writers and readers each own a head and a tail sequence number.  A
+ * head is advanced with a CAS to reserve a slot, the message is copied,
+ * and the matching tail is then advanced in reservation order to commit
+ * it.  Interrupts stay locked while a reservation is held, so waiting
+ * for an earlier one to commit only ever waits on another CPU.
+ * Sequence numbers wrap at a multiple of max_msgs close to 2^31, so a
+ * stale head can't be mistaken for a current one.
+ *
+ * k_msgq_put() and k_msgq_get() only use the ring directly while
+ * msgq->waiters is zero.  It counts threads pending (or about to pend)
+ * on the queue and pollers registered on it, and everything involving
+ * those is done under msgq->lock, as without this option.  Waiters are
+ * counted before they look at the ring and the lock-free paths look at
+ * the count after updating it, so one side always sees the other: a
+ * lock-free operation that finds waiters takes the lock to wake them.
+ *
+ * Woken threads retry their operation rather than having it done for
+ * them, as a message can't be moved safely on behalf of a thread that
+ * may be timing out concurrently.
+ */
+
+static inline uint32_t seq_next(struct k_msgq *msgq, uint32_t seq)
+{
+	return ((seq + 1U) == msgq->seq_limit) ? 0U : seq + 1U;
+}
+
+static inline uint32_t seq_dist(struct k_msgq *msgq, uint32_t to,
+				uint32_t from)
+{
+	return (to >= from) ? to - from : to + msgq->seq_limit - from;
+}
+
+static inline char *ring_slot(struct k_msgq *msgq, uint32_t seq)
+{
+	return msgq->buffer_start + ((seq % msgq->max_msgs) * msgq->msg_size);
+}
+
+static inline void ring_commit(struct k_msgq *msgq, atomic_t *tail,
+			       uint32_t seq)
+{
+	/* Earlier reservations are committed first */
+	while ((uint32_t)atomic_get(tail) != seq) {
+	}
+	(void)atomic_set(tail, seq_next(msgq, seq));
+}
+
+static bool ring_put(struct k_msgq *msgq, const void *data)
+{
+	unsigned int key = arch_irq_lock();
+	uint32_t seq, used;
+
+	do {
+		seq = (uint32_t)atomic_get(&msgq->prod_head);
+		used = seq_dist(msgq, seq, (uint32_t)atomic_get(&msgq->cons_tail));
+		if (used == msgq->max_msgs) {
+			arch_irq_unlock(key);
+			return false;
+		}
+		/* More than max_msgs means seq is already stale */
+	} while ((used > msgq->max_msgs) ||
+		 !atomic_cas(&msgq->prod_head, seq, seq_next(msgq, seq)));
+
+	(void)memcpy(ring_slot(msgq, seq), data, msgq->msg_size);
+	ring_commit(msgq, &msgq->prod_tail, seq);
+	arch_irq_unlock(key);
+
+	return true;
+}
+
+/* A NULL data discards the message */
+static bool ring_get(struct k_msgq *msgq, void *data)
+{
+	unsigned int key = arch_irq_lock();
+	uint32_t seq, avail;
+
+	do {
+		seq = (uint32_t)atomic_get(&msgq->cons_head);
+		avail = seq_dist(msgq, (uint32_t)atomic_get(&msgq->prod_tail), seq);
+		if (avail == 0U) {
+			arch_irq_unlock(key);
+			return false;
+		}
+	} while ((avail > msgq->max_msgs) ||
+		 !atomic_cas(&msgq->cons_head, seq, seq_next(msgq, seq)));
+
+	if (data != NULL) {
+		(void)memcpy(data, ring_slot(msgq, seq), msgq->msg_size);
+	}
+	ring_commit(msgq, &msgq->cons_tail, seq);
+	arch_irq_unlock(key);
+
+	return true;
+}
+
+static bool ring_peek(struct k_msgq *msgq, void *data)
+{
+	uint32_t seq, avail;
+
+	for (;;) {
+		seq = (uint32_t)atomic_get(&msgq->cons_head);
+		avail = seq_dist(msgq, (uint32_t)atomic_get(&msgq->prod_tail), seq);
+		if (avail == 0U) {
+			return false;
+		}
+		if (avail <= msgq->max_msgs) {
+			(void)memcpy(data, ring_slot(msgq, seq), msgq->msg_size);
+			/* The slot can't be rewritten before a reader has
+			 * moved cons_head past it.
+			 */
+			if ((uint32_t)atomic_get(&msgq->cons_head) == seq) {
+				return true;
+			}
+		}
+	}
+}
+
+/* Wakes as many pending threads as can now complete, msgq->lock held */
+static bool msgq_settle(struct k_msgq *msgq)
+{
+	uint32_t used = z_msgq_used_msgs(msgq);
+	uint32_t n = msgq->readers_waiting ? used : msgq->max_msgs - used;
+	struct k_thread *pending_thread;
+	bool woken = false;
+
+	while ((n-- > 0U) &&
+	       ((pending_thread = z_unpend_first_thread(&msgq->wait_q)) != NULL)) {
+		arch_thread_return_value_set(pending_thread, 0);
+		z_ready_thread(pending_thread);
+		woken = true;
+	}
+
+#ifdef CONFIG_POLL
+	if (used > 0U) {
+		handle_poll_events(msgq, K_POLL_STATE_MSGQ_DATA_AVAILABLE);
+	}
+	if (used < msgq->max_msgs) {
+		handle_poll_events(msgq, K_POLL_STATE_MSGQ_SPACE_AVAILABLE);
+	}
+#endif /* CONFIG_POLL */
+
+	return woken;
+}
+
+static void msgq_wake(struct k_msgq *msgq, k_spinlock_key_t key)
+{
+	if (msgq_settle(msgq)) {
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+}
+
+/* Called after a lock-free operation, in case a waiter raced with it */
+static inline void msgq_kick(struct k_msgq *msgq)
+{
+	if (atomic_get(&msgq->waiters) != 0) {
+		msgq_wake(msgq, k_spin_lock(&msgq->lock));
+	}
+}
+
+/* Retries a get or put until it succeeds, times out or the queue is purged */
+static int msgq_wait(struct k_msgq *msgq, bool reader, void *data,
+		     k_timeout_t timeout)
+{
+	int64_t now, end = sys_clock_timeout_end_calc(timeout);
+	bool blocked = false;
+	k_spinlock_key_t key;
+	int result;
+
+	key = k_spin_lock(&msgq->lock);
+	(void)atomic_inc(&msgq->waiters);
+
+	for (;;) {
+		if (reader ? ring_get(msgq, data) : ring_put(msgq, data)) {
+			result = 0;
+			break;
+		}
+
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			/* don't wait for a message or space to become available */
+			result = -ENOMSG;
+			break;
+		}
+
+		/* end is UINT64_MAX for K_FOREVER, which must not expire */
+		now = sys_clock_tick_get();
+		if (!K_TIMEOUT_EQ(timeout, K_FOREVER) && (end - now) <= 0) {
+			result = -EAGAIN;
+			break;
+		}
+
+		if (!blocked) {
+			blocked = true;
+			if (reader) {
+				SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_msgq, get, msgq, timeout);
+			} else {
+				SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_msgq, put, msgq, timeout);
+			}
+		}
+
+		msgq->readers_waiting = reader;
+		result = z_pend_curr(&msgq->lock, key, &msgq->wait_q,
+				     K_TIMEOUT_EQ(timeout, K_FOREVER) ?
+				     K_FOREVER : K_TICKS(end - now));
+		key = k_spin_lock(&msgq->lock);
+		if (result == -ENOMSG) {
+			/* queue was purged */
+			break;
+		}
+	}
+
+	(void)atomic_dec(&msgq->waiters);
+
+	if (result == 0) {
+		msgq_wake(msgq, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+
+	return result;
+}
+
+int z_impl_k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	int result;
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, put, msgq, timeout);
+
+	if ((atomic_get(&msgq->waiters) == 0) && ring_put(msgq, data)) {
+		msgq_kick(msgq);
+		result = 0;
+	} else {
+		result = msgq_wait(msgq, false, (void *)data, timeout);
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put, msgq, timeout, result);
+
+	return result;
+}
+#else
 int z_impl_k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t timeout)
 {
 	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
@@ -172,6 +431,7 @@ int z_impl_k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t timeout
 
 	return result;
 }
+#endif /* CONFIG_MSGQ_LOCKFREE */
 
 #ifdef CONFIG_USERSPACE
 static inline int z_vrfy_k_msgq_put(struct k_msgq *msgq, const void *data,
@@ -189,7 +449,7 @@ void z_impl_k_msgq_get_attrs(struct k_msgq *msgq, struct k_msgq_attrs *attrs)
 {
 	attrs->msg_size = msgq->msg_size;
 	attrs->max_msgs = msgq->max_msgs;
-	attrs->used_msgs = msgq->used_msgs;
+	attrs->used_msgs = z_msgq_used_msgs(msgq);
 }
 
 #ifdef CONFIG_USERSPACE
@@ -203,6 +463,27 @@ static inline void z_vrfy_k_msgq_get_attrs(struct k_msgq *msgq,
 #include <syscalls/k_msgq_get_attrs_mrsh.c>
 #endif
 
+#ifdef CONFIG_MSGQ_LOCKFREE
+int z_impl_k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	int result;
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, get, msgq, timeout);
+
+	if ((atomic_get(&msgq->waiters) == 0) && ring_get(msgq, data)) {
+		msgq_kick(msgq);
+		result = 0;
+	} else {
+		result = msgq_wait(msgq, true, data, timeout);
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, get, msgq, timeout, result);
+
+	return result;
+}
+#else
 int z_impl_k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout)
 {
 	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
@@ -247,6 +528,9 @@ int z_impl_k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout)
 
 			return 0;
 		}
+#ifdef CONFIG_POLL
+		handle_poll_events(msgq, K_POLL_STATE_MSGQ_SPACE_AVAILABLE);
+#endif /* CONFIG_POLL */
 		result = 0;
 	} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
 		/* don't wait for a message to become available */
@@ -268,6 +552,7 @@ int z_impl_k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout)
 
 	return result;
 }
+#endif /* CONFIG_MSGQ_LOCKFREE */
 
 #ifdef CONFIG_USERSPACE
 static inline int z_vrfy_k_msgq_get(struct k_msgq *msgq, void *data,
@@ -283,6 +568,13 @@ static inline int z_vrfy_k_msgq_get(struct k_msgq *msgq, void *data,
 
 int z_impl_k_msgq_peek(struct k_msgq *msgq, void *data)
 {
+#ifdef CONFIG_MSGQ_LOCKFREE
+	int result = ring_peek(msgq, data) ? 0 : -ENOMSG;
+
+	SYS_PORT_TRACING_OBJ_FUNC(k_msgq, peek, msgq, result);
+
+	return result;
+#else
 	k_spinlock_key_t key;
 	int result;
 
@@ -302,6 +594,7 @@ int z_impl_k_msgq_peek(struct k_msgq *msgq, void *data)
 	k_spin_unlock(&msgq->lock, key);
 
 	return result;
+#endif /* CONFIG_MSGQ_LOCKFREE */
 }
 
 #ifdef CONFIG_USERSPACE
@@ -330,8 +623,21 @@ void z_impl_k_msgq_purge(struct k_msgq *msgq)
 		z_ready_thread(pending_thread);
 	}
 
+#ifdef CONFIG_MSGQ_LOCKFREE
+	/* Bounded, as lock-free writers may keep adding messages */
+	for (uint32_t n = z_msgq_used_msgs(msgq); n > 0U; n--) {
+		if (!ring_get(msgq, NULL)) {
+			break;
+		}
+	}
+#else
 	msgq->used_msgs = 0;
 	msgq->read_ptr = msgq->write_ptr;
+#endif
+
+#ifdef CONFIG_POLL
+	handle_poll_events(msgq, K_POLL_STATE_MSGQ_SPACE_AVAILABLE);
+#endif /* CONFIG_POLL */
 
 	z_reschedule(&msgq->lock, key);
 }
@@ -50,8 +50,18 @@ int z_impl_k_mutex_init(struct k_mutex *mutex)
 {
 	mutex->owner = NULL;
 	mutex->lock_count = 0U;
+#ifdef CONFIG_SYNC_FAST_PATH
+	atomic_clear(&mutex->state);
+#endif
+#ifdef CONFIG_MUTEX_ADAPTIVE_SPIN_STATS
+	atomic_clear(&mutex->spin_hits);
+	atomic_clear(&mutex->spin_misses);
+#endif
 
 	z_waitq_init(&mutex->wait_q);
+#ifdef CONFIG_POLL
+	sys_dlist_init(&mutex->poll_events);
+#endif
 
 	z_object_init(mutex);
 
@@ -78,32 +88,147 @@ static int32_t new_prio_for_inheritance(int32_t target, int32_t limit)
 	return new_prio;
 }
 
-static bool adjust_owner_prio(struct k_mutex *mutex, int32_t new_prio)
+#ifdef CONFIG_SYNC_FAST_PATH
+/* The state word holds the owner, and is claimed and released with a
+ * CAS without the lock while Z_MUTEX_WAITERS is clear.  Contenders set
+ * the flag with the lock held, after which the state only changes
+ * with the lock held, and the owner is handed the usual priority
+ * inheritance treatment.  mutex->owner and mutex->lock_count are kept
+ * up to date for the owner's own use.  k_poll() sets the flag too, even
+ * on a free mutex, and it stays set across releases while poll events
+ * are registered.
+ */
+static inline struct k_thread *mutex_owner(struct k_mutex *mutex)
 {
-	if (mutex->owner->base.prio != new_prio) {
+	return (struct k_thread *)(atomic_get(&mutex->state) & ~Z_MUTEX_WAITERS);
+}
 
-		LOG_DBG("%p (ready (y/n): %c) prio changed to %d (was %d)",
-			mutex->owner, z_is_thread_ready(mutex->owner) ?
-			'y' : 'n',
-			new_prio, mutex->owner->base.prio);
+static bool mutex_claim(struct k_mutex *mutex)
+{
+	atomic_val_t free = 0;
+	int prio = _current->base.prio;
+
+	if (mutex->owner == _current) {
+		mutex->lock_count++;
+		return true;
+	}
 
-		return z_set_prio(mutex->owner, new_prio);
+	/* Released while k_poll() events are registered, the flag stays
+	 * set so that the next release signals them too.
+	 */
+	if (IS_ENABLED(CONFIG_POLL)) {
+		free = atomic_get(&mutex->state) & Z_MUTEX_WAITERS;
 	}
+
+	if (atomic_cas(&mutex->state, free, (atomic_val_t)_current | free)) {
+		mutex->owner = _current;
+		mutex->lock_count = 1U;
+		if (free != 0) {
+			/* Contenders only record it when setting the flag */
+			mutex->owner_orig_prio = prio;
+		}
+		return true;
+	}
+
 	return false;
 }
 
-int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
+/* Flags the mutex as contended and returns its owner, or NULL if it
+ * was released meanwhile.
+ */
+static struct k_thread *mutex_contend_locked(struct k_mutex *mutex)
 {
-	int new_prio;
-	k_spinlock_key_t key;
-	bool resched = false;
+	atomic_val_t state;
+
+	do {
+		state = atomic_get(&mutex->state);
+		if ((state & ~Z_MUTEX_WAITERS) == 0) {
+			return NULL;
+		}
+	} while (((state & Z_MUTEX_WAITERS) == 0) &&
+		 !atomic_cas(&mutex->state, state, state | Z_MUTEX_WAITERS));
+
+	/* Not boosted until now, by this mutex at least */
+	if ((state & Z_MUTEX_WAITERS) == 0) {
+		mutex->owner_orig_prio = mutex_owner(mutex)->base.prio;
+	}
 
-	__ASSERT(!arch_is_in_isr(), "mutexes cannot be used inside ISRs");
+	return mutex_owner(mutex);
+}
 
-	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mutex, lock, mutex, timeout);
+/* Owner as seen without the lock, NULL if unlocked.  *waiters is set
+ * when threads are pended, which the mutex will be handed to.
+ */
+static inline struct k_thread *mutex_peek(struct k_mutex *mutex,
+					  bool *waiters)
+{
+	atomic_val_t state = atomic_get(&mutex->state);
 
-	key = k_spin_lock(&lock);
+	*waiters = (state & Z_MUTEX_WAITERS) != 0;
+
+	return (struct k_thread *)(state & ~Z_MUTEX_WAITERS);
+}
+
+static inline bool mutex_has_pollers(struct k_mutex *mutex)
+{
+#ifdef CONFIG_POLL
+	return !sys_dlist_is_empty(&mutex->poll_events);
+#else
+	return false;
+#endif
+}
+
+static inline void mutex_set_state_locked(struct k_mutex *mutex,
+					  struct k_thread *owner)
+{
+	atomic_val_t state = (atomic_val_t)owner;
+
+	if (((owner != NULL) && (z_waitq_head(&mutex->wait_q) != NULL)) ||
+	    mutex_has_pollers(mutex)) {
+		state |= Z_MUTEX_WAITERS;
+	}
+	atomic_set(&mutex->state, state);
+}
+
+/* Lets the owner release without the lock again once nobody waits.
+ * The owner bits may be changed by lock-free claims and releases
+ * meanwhile, so only the flag is cleared.
+ */
+static inline void mutex_clear_waiters_locked(struct k_mutex *mutex)
+{
+	if ((z_waitq_head(&mutex->wait_q) == NULL) &&
+	    !mutex_has_pollers(mutex)) {
+		(void)atomic_and(&mutex->state, ~Z_MUTEX_WAITERS);
+	}
+}
+
+#ifdef CONFIG_POLL
+void z_mutex_poll_contend(struct k_mutex *mutex)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	atomic_val_t state;
+
+	/* Flagged even when free, or a lock-free claim and release
+	 * racing with the registration would never signal the poller.
+	 * A claim of the flagged free mutex records the priority itself.
+	 */
+	state = atomic_or(&mutex->state, Z_MUTEX_WAITERS);
+	if (((state & Z_MUTEX_WAITERS) == 0) &&
+	    ((state & ~Z_MUTEX_WAITERS) != 0)) {
+		/* Not boosted until now, by this mutex at least */
+		mutex->owner_orig_prio = mutex_owner(mutex)->base.prio;
+	}
+	k_spin_unlock(&lock, key);
+}
+#endif
+#else
+static inline struct k_thread *mutex_owner(struct k_mutex *mutex)
+{
+	return mutex->owner;
+}
 
+static inline bool mutex_claim(struct k_mutex *mutex)
+{
 	if (likely((mutex->lock_count == 0U) || (mutex->owner == _current))) {
 
 		mutex->owner_orig_prio = (mutex->lock_count == 0U) ?
@@ -113,33 +238,181 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 		mutex->lock_count++;
 		mutex->owner = _current;
 
-		LOG_DBG("%p took mutex %p, count: %d, orig prio: %d",
-			_current, mutex, mutex->lock_count,
-			mutex->owner_orig_prio);
+		return true;
+	}
 
-		k_spin_unlock(&lock, key);
+	return false;
+}
+
+static inline struct k_thread *mutex_contend_locked(struct k_mutex *mutex)
+{
+	return mutex->owner;
+}
 
+static inline struct k_thread *mutex_peek(struct k_mutex *mutex,
+					  bool *waiters)
+{
+	/* A release with waiters hands the mutex straight to one */
+	*waiters = false;
+
+	return *(struct k_thread *volatile *)&mutex->owner;
+}
+
+static inline void mutex_set_state_locked(struct k_mutex *mutex,
+					  struct k_thread *owner)
+{
+	ARG_UNUSED(mutex);
+	ARG_UNUSED(owner);
+}
+
+static inline void mutex_clear_waiters_locked(struct k_mutex *mutex)
+{
+	ARG_UNUSED(mutex);
+}
+#endif
+
+#ifdef CONFIG_MUTEX_ADAPTIVE_SPIN
+static bool owner_running(struct k_thread *owner)
+{
+	unsigned int key = arch_irq_lock();
+	bool ret = z_thread_active_elsewhere(owner);
+
+	arch_irq_unlock(key);
+
+	return ret;
+}
+
+/* Waits without the lock for an owner running on another CPU to
+ * release the mutex, which is usually sooner than pending and being
+ * switched back in would take.  Gives up once the owner stops
+ * running or hands the mutex over, or the budget runs out.
+ *
+ * Returns true if the mutex was released meanwhile.
+ */
+static bool mutex_spin(struct k_mutex *mutex)
+{
+	uint32_t start = k_cycle_get_32();
+	uint32_t budget = k_us_to_cyc_ceil32(CONFIG_MUTEX_ADAPTIVE_SPIN_US);
+	struct k_thread *owner, *cur;
+	bool waiters;
+
+	owner = mutex_peek(mutex, &waiters);
+	if ((owner == NULL) || waiters || !owner_running(owner)) {
+		return owner == NULL;
+	}
+
+	do {
+		cur = mutex_peek(mutex, &waiters);
+		if (cur == NULL) {
+#ifdef CONFIG_MUTEX_ADAPTIVE_SPIN_STATS
+			atomic_inc(&mutex->spin_hits);
+#endif
+			return true;
+		}
+	} while ((cur == owner) && !waiters && owner_running(owner) &&
+		 ((k_cycle_get_32() - start) < budget));
+
+#ifdef CONFIG_MUTEX_ADAPTIVE_SPIN_STATS
+	atomic_inc(&mutex->spin_misses);
+#endif
+
+	return false;
+}
+
+#ifdef CONFIG_MUTEX_ADAPTIVE_SPIN_STATS
+void k_mutex_spin_stats_get(struct k_mutex *mutex,
+			    struct k_mutex_spin_stats *stats)
+{
+	stats->hits = (uint32_t)atomic_get(&mutex->spin_hits);
+	stats->misses = (uint32_t)atomic_get(&mutex->spin_misses);
+}
+#endif
+#else
+static inline bool mutex_spin(struct k_mutex *mutex)
+{
+	ARG_UNUSED(mutex);
+
+	return false;
+}
+#endif
+
+static bool adjust_owner_prio(struct k_mutex *mutex, int32_t new_prio)
+{
+	struct k_thread *owner = mutex_owner(mutex);
+
+	if ((owner != NULL) && (owner->base.prio != new_prio)) {
+
+		LOG_DBG("%p (ready (y/n): %c) prio changed to %d (was %d)",
+			owner, z_is_thread_ready(owner) ? 'y' : 'n',
+			new_prio, owner->base.prio);
+
+		return z_set_prio(owner, new_prio);
+	}
+	return false;
+}
+
+int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
+{
+	int new_prio;
+	k_spinlock_key_t key;
+	struct k_thread *owner;
+	bool resched = false;
+
+	__ASSERT(!arch_is_in_isr(), "mutexes cannot be used inside ISRs");
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mutex, lock, mutex, timeout);
+
+	if (IS_ENABLED(CONFIG_SYNC_FAST_PATH) && likely(mutex_claim(mutex))) {
 		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, lock, mutex, timeout, 0);
 
 		return 0;
 	}
 
-	if (unlikely(K_TIMEOUT_EQ(timeout, K_NO_WAIT))) {
-		k_spin_unlock(&lock, key);
-
-		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, lock, mutex, timeout, -EBUSY);
+	/* Without the fast path, a release seen while spinning is
+	 * claimed below with the lock held.
+	 */
+	if (IS_ENABLED(CONFIG_MUTEX_ADAPTIVE_SPIN) &&
+	    !K_TIMEOUT_EQ(timeout, K_NO_WAIT) && mutex_spin(mutex) &&
+	    IS_ENABLED(CONFIG_SYNC_FAST_PATH) && mutex_claim(mutex)) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, lock, mutex, timeout, 0);
 
-		return -EBUSY;
+		return 0;
 	}
 
+	key = k_spin_lock(&lock);
+
+	do {
+		if (likely(mutex_claim(mutex))) {
+			LOG_DBG("%p took mutex %p, count: %d, orig prio: %d",
+				_current, mutex, mutex->lock_count,
+				mutex->owner_orig_prio);
+
+			k_spin_unlock(&lock, key);
+
+			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, lock, mutex, timeout, 0);
+
+			return 0;
+		}
+
+		if (unlikely(K_TIMEOUT_EQ(timeout, K_NO_WAIT))) {
+			k_spin_unlock(&lock, key);
+
+			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, lock, mutex, timeout, -EBUSY);
+
+			return -EBUSY;
+		}
+
+		owner = mutex_contend_locked(mutex);
+	} while (owner == NULL);
+
 	SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_mutex, lock, mutex, timeout);
 
 	new_prio = new_prio_for_inheritance(_current->base.prio,
-					    mutex->owner->base.prio);
+					    owner->base.prio);
 
 	LOG_DBG("adjusting prio up on mutex %p", mutex);
 
-	if (z_is_prio_higher(new_prio, mutex->owner->base.prio)) {
+	if (z_is_prio_higher(new_prio, owner->base.prio)) {
 		resched = adjust_owner_prio(mutex, new_prio);
 	}
 
@@ -171,6 +444,9 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 
 	resched = adjust_owner_prio(mutex, new_prio) || resched;
 
+	/* Lets the owner unlock without the lock if we were the last */
+	mutex_clear_waiters_locked(mutex);
+
 	if (resched) {
 		z_reschedule(&lock, key);
 	} else {
@@ -233,6 +509,14 @@ int z_impl_k_mutex_unlock(struct k_mutex *mutex)
 		goto k_mutex_unlock_return;
 	}
 
+#ifdef CONFIG_SYNC_FAST_PATH
+	mutex->owner = NULL;
+	mutex->lock_count = 0U;
+	if (likely(atomic_cas(&mutex->state, (atomic_val_t)_current, 0))) {
+		goto k_mutex_unlock_return;
+	}
+#endif
+
 	k_spinlock_key_t key = k_spin_lock(&lock);
 
 	adjust_owner_prio(mutex, mutex->owner_orig_prio);
@@ -241,6 +525,7 @@ int z_impl_k_mutex_unlock(struct k_mutex *mutex)
 	new_owner = z_unpend_first_thread(&mutex->wait_q);
 
 	mutex->owner = new_owner;
+	mutex_set_state_locked(mutex, new_owner);
 
 	LOG_DBG("new owner of mutex %p: %p (prio: %d)",
 		mutex, new_owner, new_owner ? new_owner->base.prio : -1000);
@@ -252,11 +537,20 @@ int z_impl_k_mutex_unlock(struct k_mutex *mutex)
 		 * adjust its priority
 		 */
 		mutex->owner_orig_prio = new_owner->base.prio;
+		mutex->lock_count = 1U;
 		arch_thread_return_value_set(new_owner, 0);
 		z_ready_thread(new_owner);
 		z_reschedule(&lock, key);
 	} else {
 		mutex->lock_count = 0U;
+#ifdef CONFIG_POLL
+		if (!sys_dlist_is_empty(&mutex->poll_events)) {
+			z_handle_obj_poll_events(&mutex->poll_events,
+						 K_POLL_STATE_MUTEX_AVAILABLE);
+			z_reschedule(&lock, key);
+			goto k_mutex_unlock_return;
+		}
+#endif
 		k_spin_unlock(&lock, key);
 	}
 
@@ -26,6 +26,23 @@ struct k_pipe_desc {
 	size_t bytes_to_xfer;            /* # bytes left to transfer */
 };
 
+/* Signals a poller that data can be read, pipe->lock held.  Returns
+ * true if one was waiting.
+ */
+static inline bool handle_poll_events(struct k_pipe *pipe)
+{
+#ifdef CONFIG_POLL
+	if (!sys_dlist_is_empty(&pipe->poll_events)) {
+		z_handle_obj_poll_events(&pipe->poll_events,
+					 K_POLL_STATE_PIPE_DATA_AVAILABLE);
+		return true;
+	}
+#else
+	ARG_UNUSED(pipe);
+#endif
+	return false;
+}
+
 static int pipe_get_internal(k_spinlock_key_t key, struct k_pipe *pipe,
 			     void *data, size_t bytes_to_read,
 			     size_t *bytes_read, size_t min_xfer,
@@ -38,9 +55,14 @@ void k_pipe_init(struct k_pipe *pipe, unsigned char *buffer, size_t size)
 	pipe->bytes_used = 0;
 	pipe->read_index = 0;
 	pipe->write_index = 0;
+	pipe->put_claimed = 0;
+	pipe->get_claimed = 0;
 	pipe->lock = (struct k_spinlock){};
 	z_waitq_init(&pipe->wait_q.writers);
 	z_waitq_init(&pipe->wait_q.readers);
+#ifdef CONFIG_POLL
+	sys_dlist_init(&pipe->poll_events);
+#endif
 	SYS_PORT_TRACING_OBJ_INIT(k_pipe, pipe);
 
 	pipe->flags = 0;
@@ -483,9 +505,15 @@ int z_impl_k_pipe_put(struct k_pipe *pipe, void *data, size_t bytes_to_write,
 	 * readers. Add as much as possible to the pipe's circular buffer.
 	 */
 
-	num_bytes_written +=
-		pipe_buffer_put(pipe, (uint8_t *)data + num_bytes_written,
-				 bytes_to_write - num_bytes_written);
+	bytes_copied = pipe_buffer_put(pipe, (uint8_t *)data + num_bytes_written,
+				       bytes_to_write - num_bytes_written);
+	num_bytes_written += bytes_copied;
+
+	if (IS_ENABLED(CONFIG_POLL) && (bytes_copied != 0U)) {
+		key = k_spin_lock(&pipe->lock);
+		(void)handle_poll_events(pipe);
+		k_spin_unlock(&pipe->lock, key);
+	}
 
 	if (num_bytes_written == bytes_to_write) {
 		*bytes_written = num_bytes_written;
@@ -522,6 +550,8 @@ int z_impl_k_pipe_put(struct k_pipe *pipe, void *data, size_t bytes_to_write,
 		 */
 		k_spinlock_key_t key2 = k_spin_lock(&pipe->lock);
 		z_sched_unlock_no_reschedule();
+		/* The rest can be read straight from this thread */
+		(void)handle_poll_events(pipe);
 		(void)z_pend_curr(&pipe->lock, key2,
 				  &pipe->wait_q.writers, timeout);
 	} else {
@@ -758,6 +788,196 @@ int z_vrfy_k_pipe_get(struct k_pipe *pipe, void *data, size_t bytes_to_read,
 #include <syscalls/k_pipe_get_mrsh.c>
 #endif
 
+/**
+ * @brief Hand buffered data to readers pended on an empty pipe
+ *
+ * Readers are served in order and readied once their request is complete;
+ * a partially served reader stays pended, as with k_pipe_put().
+ *
+ * @return true if a reader was readied
+ */
+static bool pipe_readers_feed(struct k_pipe *pipe)
+{
+	struct k_thread    *thread;
+	struct k_pipe_desc *desc;
+	size_t              bytes_copied;
+	bool                readied = false;
+
+	while ((pipe->bytes_used != 0U) &&
+	       ((thread = z_waitq_head(&pipe->wait_q.readers)) != NULL)) {
+		desc = (struct k_pipe_desc *)thread->base.swap_data;
+		bytes_copied = pipe_buffer_get(pipe, desc->buffer,
+					       desc->bytes_to_xfer);
+
+		desc->buffer        += bytes_copied;
+		desc->bytes_to_xfer -= bytes_copied;
+
+		if (desc->bytes_to_xfer != 0U) {
+			break;
+		}
+
+		z_unpend_thread(thread);
+		z_ready_thread(thread);
+		readied = true;
+	}
+
+	return readied;
+}
+
+/**
+ * @brief Move the data of writers pended on a full pipe into its buffer
+ *
+ * Writers are served in order and readied once their request is complete;
+ * a partially served writer stays pended, as with k_pipe_get().
+ *
+ * @return true if a writer was readied
+ */
+static bool pipe_writers_drain(struct k_pipe *pipe)
+{
+	struct k_thread    *thread;
+	struct k_pipe_desc *desc;
+	size_t              bytes_copied;
+	bool                readied = false;
+
+	while ((pipe->bytes_used != pipe->size) &&
+	       ((thread = z_waitq_head(&pipe->wait_q.writers)) != NULL)) {
+		desc = (struct k_pipe_desc *)thread->base.swap_data;
+		bytes_copied = pipe_buffer_put(pipe, desc->buffer,
+					       desc->bytes_to_xfer);
+
+		desc->buffer        += bytes_copied;
+		desc->bytes_to_xfer -= bytes_copied;
+
+		if (desc->bytes_to_xfer != 0U) {
+			break;
+		}
+
+		z_unpend_thread(thread);
+		z_ready_thread(thread);
+		readied = true;
+	}
+
+	return readied;
+}
+
+size_t k_pipe_put_claim(struct k_pipe *pipe, unsigned char **data,
+			size_t size)
+{
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+	size_t start;
+
+	/* Pended writers' data must enter the buffer first */
+	if ((pipe->buffer == NULL) ||
+	    (z_waitq_head(&pipe->wait_q.writers) != NULL)) {
+		k_spin_unlock(&pipe->lock, key);
+		return 0;
+	}
+
+	start = pipe->write_index + pipe->put_claimed;
+	if (start >= pipe->size) {
+		start -= pipe->size;
+	}
+
+	size = MIN(size, pipe->size - pipe->bytes_used - pipe->put_claimed);
+	size = MIN(size, pipe->size - start);
+
+	*data = pipe->buffer + start;
+	pipe->put_claimed += size;
+
+	k_spin_unlock(&pipe->lock, key);
+
+	return size;
+}
+
+int k_pipe_put_finish(struct k_pipe *pipe, size_t size)
+{
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+
+	if (size > pipe->put_claimed) {
+		k_spin_unlock(&pipe->lock, key);
+		return -EINVAL;
+	}
+
+	pipe->put_claimed = 0;
+	pipe->bytes_used += size;
+	pipe->write_index += size;
+	if (pipe->write_index >= pipe->size) {
+		pipe->write_index -= pipe->size;
+	}
+
+	/* A consumer holding a get claim owns the read side */
+	if ((size != 0U) && (pipe->get_claimed == 0U)) {
+		bool woken = pipe_readers_feed(pipe);
+
+		if ((pipe->bytes_used != 0U) && handle_poll_events(pipe)) {
+			woken = true;
+		}
+		if (woken) {
+			z_reschedule(&pipe->lock, key);
+			return 0;
+		}
+	}
+
+	k_spin_unlock(&pipe->lock, key);
+
+	return 0;
+}
+
+size_t k_pipe_get_claim(struct k_pipe *pipe, unsigned char **data,
+			size_t size)
+{
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+	size_t start;
+
+	if (pipe->buffer == NULL) {
+		k_spin_unlock(&pipe->lock, key);
+		return 0;
+	}
+
+	start = pipe->read_index + pipe->get_claimed;
+	if (start >= pipe->size) {
+		start -= pipe->size;
+	}
+
+	size = MIN(size, pipe->bytes_used - pipe->get_claimed);
+	size = MIN(size, pipe->size - start);
+
+	*data = pipe->buffer + start;
+	pipe->get_claimed += size;
+
+	k_spin_unlock(&pipe->lock, key);
+
+	return size;
+}
+
+int k_pipe_get_finish(struct k_pipe *pipe, size_t size)
+{
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+
+	if (size > pipe->get_claimed) {
+		k_spin_unlock(&pipe->lock, key);
+		return -EINVAL;
+	}
+
+	pipe->get_claimed = 0;
+	pipe->bytes_used -= size;
+	pipe->read_index += size;
+	if (pipe->read_index >= pipe->size) {
+		pipe->read_index -= pipe->size;
+	}
+
+	/* A producer holding a put claim owns the write side */
+	if ((size != 0U) && (pipe->put_claimed == 0U) &&
+	    pipe_writers_drain(pipe)) {
+		z_reschedule(&pipe->lock, key);
+		return 0;
+	}
+
+	k_spin_unlock(&pipe->lock, key);
+
+	return 0;
+}
+
 size_t z_impl_k_pipe_read_avail(struct k_pipe *pipe)
 {
 	size_t res;
@@ -81,11 +81,39 @@ static inline bool is_condition_met(struct k_poll_event *event, uint32_t *state)
 		}
 		break;
 	case K_POLL_TYPE_MSGQ_DATA_AVAILABLE:
-		if (event->msgq->used_msgs > 0) {
+		if (z_msgq_used_msgs(event->msgq) > 0U) {
 			*state = K_POLL_STATE_MSGQ_DATA_AVAILABLE;
 			return true;
 		}
 		break;
+	case K_POLL_TYPE_MSGQ_SPACE_AVAILABLE:
+		if (z_msgq_used_msgs(event->msgq) < event->msgq->max_msgs) {
+			*state = K_POLL_STATE_MSGQ_SPACE_AVAILABLE;
+			return true;
+		}
+		break;
+	case K_POLL_TYPE_PIPE_DATA_AVAILABLE:
+		/* Buffered data, or a writer waiting to hand it over */
+		if ((event->pipe->bytes_used > 0U) ||
+		    (z_waitq_head(&event->pipe->wait_q.writers) != NULL)) {
+			*state = K_POLL_STATE_PIPE_DATA_AVAILABLE;
+			return true;
+		}
+		break;
+#ifdef CONFIG_EVENTS
+	case K_POLL_TYPE_EVENT_POSTED:
+		if (event->event->events != 0U) {
+			*state = K_POLL_STATE_EVENT_POSTED;
+			return true;
+		}
+		break;
+#endif
+	case K_POLL_TYPE_MUTEX_AVAILABLE:
+		if (z_mutex_is_free(event->mutex)) {
+			*state = K_POLL_STATE_MUTEX_AVAILABLE;
+			return true;
+		}
+		break;
 	case K_POLL_TYPE_IGNORE:
 		break;
 	default:
@@ -133,6 +161,10 @@ static inline void register_event(struct k_poll_event *event,
 	case K_POLL_TYPE_SEM_AVAILABLE:
 		__ASSERT(event->sem != NULL, "invalid semaphore\n");
 		add_event(&event->sem->poll_events, event, poller);
+#ifdef CONFIG_SYNC_FAST_PATH
+		/* Sends k_sem_give() through the semaphore's lock */
+		(void)atomic_or(&event->sem->count, Z_SEM_WAITERS);
+#endif
 		break;
 	case K_POLL_TYPE_DATA_AVAILABLE:
 		__ASSERT(event->queue != NULL, "invalid queue\n");
@@ -145,6 +177,35 @@ static inline void register_event(struct k_poll_event *event,
 	case K_POLL_TYPE_MSGQ_DATA_AVAILABLE:
 		__ASSERT(event->msgq != NULL, "invalid message queue\n");
 		add_event(&event->msgq->poll_events, event, poller);
+#ifdef CONFIG_MSGQ_LOCKFREE
+		/* Keeps the queue's lock-free paths off until unlinked */
+		(void)atomic_inc(&event->msgq->waiters);
+#endif
+		break;
+	case K_POLL_TYPE_MSGQ_SPACE_AVAILABLE:
+		__ASSERT(event->msgq != NULL, "invalid message queue\n");
+		add_event(&event->msgq->space_poll_events, event, poller);
+#ifdef CONFIG_MSGQ_LOCKFREE
+		(void)atomic_inc(&event->msgq->waiters);
+#endif
+		break;
+	case K_POLL_TYPE_PIPE_DATA_AVAILABLE:
+		__ASSERT(event->pipe != NULL, "invalid pipe\n");
+		add_event(&event->pipe->poll_events, event, poller);
+		break;
+#ifdef CONFIG_EVENTS
+	case K_POLL_TYPE_EVENT_POSTED:
+		__ASSERT(event->event != NULL, "invalid event object\n");
+		add_event(&event->event->poll_events, event, poller);
+		break;
+#endif
+	case K_POLL_TYPE_MUTEX_AVAILABLE:
+		__ASSERT(event->mutex != NULL, "invalid mutex\n");
+		add_event(&event->mutex->poll_events, event, poller);
+#ifdef CONFIG_SYNC_FAST_PATH
+		/* Sends k_mutex_unlock() through the mutex's lock */
+		z_mutex_poll_contend(event->mutex);
+#endif
 		break;
 	case K_POLL_TYPE_IGNORE:
 		/* nothing to do */
@@ -178,8 +239,28 @@ static inline void clear_event_registration(struct k_poll_event *event)
 		remove_event = true;
 		break;
 	case K_POLL_TYPE_MSGQ_DATA_AVAILABLE:
+	case K_POLL_TYPE_MSGQ_SPACE_AVAILABLE:
 		__ASSERT(event->msgq != NULL, "invalid message queue\n");
 		remove_event = true;
+#ifdef CONFIG_MSGQ_LOCKFREE
+		if (sys_dnode_is_linked(&event->_node)) {
+			(void)atomic_dec(&event->msgq->waiters);
+		}
+#endif
+		break;
+	case K_POLL_TYPE_PIPE_DATA_AVAILABLE:
+		__ASSERT(event->pipe != NULL, "invalid pipe\n");
+		remove_event = true;
+		break;
+#ifdef CONFIG_EVENTS
+	case K_POLL_TYPE_EVENT_POSTED:
+		__ASSERT(event->event != NULL, "invalid event object\n");
+		remove_event = true;
+		break;
+#endif
+	case K_POLL_TYPE_MUTEX_AVAILABLE:
+		__ASSERT(event->mutex != NULL, "invalid mutex\n");
+		remove_event = true;
 		break;
 	case K_POLL_TYPE_IGNORE:
 		/* nothing to do */
@@ -211,6 +292,24 @@ static inline void set_event_ready(struct k_poll_event *event, uint32_t state)
 	event->state |= state;
 }
 
+/* Objects whose lock-free paths may change the polled condition
+ * without seeing a concurrent registration.
+ */
+static inline bool recheck_after_register(struct k_poll_event *event)
+{
+	switch (event->type) {
+	case K_POLL_TYPE_SEM_AVAILABLE:
+		return IS_ENABLED(CONFIG_SYNC_FAST_PATH);
+	case K_POLL_TYPE_MSGQ_DATA_AVAILABLE:
+	case K_POLL_TYPE_MSGQ_SPACE_AVAILABLE:
+		return IS_ENABLED(CONFIG_MSGQ_LOCKFREE);
+	case K_POLL_TYPE_MUTEX_AVAILABLE:
+		return IS_ENABLED(CONFIG_SYNC_FAST_PATH);
+	default:
+		return false;
+	}
+}
+
 static inline int register_events(struct k_poll_event *events,
 				  int num_events,
 				  struct z_poller *poller,
@@ -228,7 +327,17 @@ static inline int register_events(struct k_poll_event *events,
 			poller->is_polling = false;
 		} else if (!just_check && poller->is_polling) {
 			register_event(&events[ii], poller);
-			events_registered += 1;
+			if (recheck_after_register(&events[ii]) &&
+			    is_condition_met(&events[ii], &state)) {
+				/* A lock-free put or give completed before
+				 * it could see this registration.
+				 */
+				clear_event_registration(&events[ii]);
+				set_event_ready(&events[ii], state);
+				poller->is_polling = false;
+			} else {
+				events_registered += 1;
+			}
 		} else {
 			/* Event is not one of those identified in is_condition_met()
 			 * catching non-polling events, or is marked for just check,
@@ -395,8 +504,20 @@ static inline int z_vrfy_k_poll(struct k_poll_event *events,
 			Z_OOPS(Z_SYSCALL_OBJ(e->queue, K_OBJ_QUEUE));
 			break;
 		case K_POLL_TYPE_MSGQ_DATA_AVAILABLE:
+		case K_POLL_TYPE_MSGQ_SPACE_AVAILABLE:
 			Z_OOPS(Z_SYSCALL_OBJ(e->msgq, K_OBJ_MSGQ));
 			break;
+		case K_POLL_TYPE_PIPE_DATA_AVAILABLE:
+			Z_OOPS(Z_SYSCALL_OBJ(e->pipe, K_OBJ_PIPE));
+			break;
+#ifdef CONFIG_EVENTS
+		case K_POLL_TYPE_EVENT_POSTED:
+			Z_OOPS(Z_SYSCALL_OBJ(e->event, K_OBJ_EVENT));
+			break;
+#endif
+		case K_POLL_TYPE_MUTEX_AVAILABLE:
+			Z_OOPS(Z_SYSCALL_OBJ(e->mutex, K_OBJ_MUTEX));
+			break;
 		default:
 			ret = -EINVAL;
 			goto out_free;
@@ -449,6 +570,12 @@ void z_handle_obj_poll_events(sys_dlist_t *events, uint32_t state)
 
 	poll_event = (struct k_poll_event *)sys_dlist_get(events);
 	if (poll_event != NULL) {
+#ifdef CONFIG_MSGQ_LOCKFREE
+		if ((poll_event->type == K_POLL_TYPE_MSGQ_DATA_AVAILABLE) ||
+		    (poll_event->type == K_POLL_TYPE_MSGQ_SPACE_AVAILABLE)) {
+			(void)atomic_dec(&poll_event->msgq->waiters);
+		}
+#endif
 		(void) signal_poll_event(poll_event, state);
 	}
 }
@@ -22,10 +22,9 @@
 #include <kernel_internal.h>
 #include <sys/check.h>
 
-struct alloc_node {
-	sys_sfnode_t node;
-	void *data;
-};
+/* Flags of a struct k_queue_node put in the queue in place of the data */
+#define NODE_HEAP 0x1
+#define NODE_POOL 0x2
 
 void *z_queue_node_peek(sys_sfnode_t *node, bool needs_free)
 {
@@ -33,15 +32,16 @@ void *z_queue_node_peek(sys_sfnode_t *node, bool needs_free)
 
 	if ((node != NULL) && (sys_sfnode_flags_get(node) != (uint8_t)0)) {
 		/* If the flag is set, then the enqueue operation for this item
-		 * did a behind-the scenes memory allocation of an alloc_node
+		 * did a behind-the scenes memory allocation of a k_queue_node
 		 * struct, which is what got put in the queue. Free it and pass
-		 * back the data pointer.
+		 * back the data pointer. Nodes from the queue's own pool are
+		 * given back by the caller, which holds the queue's lock.
 		 */
-		struct alloc_node *anode;
+		struct k_queue_node *anode;
 
-		anode = CONTAINER_OF(node, struct alloc_node, node);
+		anode = CONTAINER_OF(node, struct k_queue_node, node);
 		ret = anode->data;
-		if (needs_free) {
+		if (needs_free && (sys_sfnode_flags_get(node) == NODE_HEAP)) {
 			k_free(anode);
 		}
 	} else {
@@ -63,6 +63,9 @@ void z_impl_k_queue_init(struct k_queue *queue)
 #if defined(CONFIG_POLL)
 	sys_dlist_init(&queue->poll_events);
 #endif
+#if defined(CONFIG_QUEUE_NODE_POOL)
+	sys_sflist_init(&queue->node_pool);
+#endif
 
 	SYS_PORT_TRACING_OBJ_INIT(k_queue, queue);
 
@@ -78,6 +81,59 @@ static inline void z_vrfy_k_queue_init(struct k_queue *queue)
 #include <syscalls/k_queue_init_mrsh.c>
 #endif
 
+#ifdef CONFIG_QUEUE_NODE_POOL
+void k_queue_node_pool_init(struct k_queue *queue, struct k_queue_node *nodes,
+			    size_t count)
+{
+	k_spinlock_key_t key = k_spin_lock(&queue->lock);
+
+	sys_sflist_init(&queue->node_pool);
+	for (size_t i = 0; i < count; i++) {
+		sys_sflist_prepend(&queue->node_pool, &nodes[i].node);
+	}
+
+	k_spin_unlock(&queue->lock, key);
+}
+#endif
+
+/* Takes a node for an item added with k_queue_alloc_append() or
+ * k_queue_alloc_prepend(), preferring the queue's own pool.
+ */
+static struct k_queue_node *queue_node_alloc(struct k_queue *queue)
+{
+	struct k_queue_node *anode;
+
+#ifdef CONFIG_QUEUE_NODE_POOL
+	sys_sfnode_t *node = sys_sflist_get(&queue->node_pool);
+
+	if (node != NULL) {
+		anode = CONTAINER_OF(node, struct k_queue_node, node);
+		sys_sfnode_init(&anode->node, NODE_POOL);
+		return anode;
+	}
+#endif
+
+	anode = z_thread_malloc(sizeof(*anode));
+	if (anode != NULL) {
+		sys_sfnode_init(&anode->node, NODE_HEAP);
+	}
+
+	return anode;
+}
+
+/* Returns a node just removed from the queue to the queue's pool if it
+ * came from there. Must be called with the queue's lock held.
+ */
+static inline void queue_node_release(struct k_queue *queue,
+				      sys_sfnode_t *node)
+{
+#ifdef CONFIG_QUEUE_NODE_POOL
+	if (sys_sfnode_flags_get(node) == NODE_POOL) {
+		sys_sflist_prepend(&queue->node_pool, node);
+	}
+#endif
+}
+
 static void prepare_thread_to_run(struct k_thread *thread, void *data)
 {
 	z_thread_return_value_set_with_data(thread, 0, data);
@@ -143,9 +199,9 @@ static int32_t queue_insert(struct k_queue *queue, void *prev, void *data,
 
 	/* Only need to actually allocate if no threads are pending */
 	if (alloc) {
-		struct alloc_node *anode;
+		struct k_queue_node *anode;
 
-		anode = z_thread_malloc(sizeof(*anode));
+		anode = queue_node_alloc(queue);
 		if (anode == NULL) {
 			k_spin_unlock(&queue->lock, key);
 
@@ -155,7 +211,6 @@ static int32_t queue_insert(struct k_queue *queue, void *prev, void *data,
 			return -ENOMEM;
 		}
 		anode->data = data;
-		sys_sfnode_init(&anode->node, 0x1);
 		data = anode;
 	} else {
 		sys_sfnode_init(data, 0x0);
@@ -323,6 +378,7 @@ void *z_impl_k_queue_get(struct k_queue *queue, k_timeout_t timeout)
 
 		node = sys_sflist_get_not_empty(&queue->data_q);
 		data = z_queue_node_peek(node, true);
+		queue_node_release(queue, node);
 		k_spin_unlock(&queue->lock, key);
 
 		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_queue, get, queue, timeout, data);
@@ -51,6 +51,10 @@ static ALWAYS_INLINE void z_priq_mq_remove(struct _priq_mq *pq,
 #define z_priq_wait_add		z_priq_dumb_add
 #define _priq_wait_remove	z_priq_dumb_remove
 #define _priq_wait_best		z_priq_dumb_best
+#elif defined(CONFIG_WAITQ_MULTIQ)
+#define z_priq_wait_add		z_priq_bm_add
+#define _priq_wait_remove	z_priq_bm_remove
+#define _priq_wait_best		z_priq_bm_best
 #endif
 
 struct k_spinlock sched_spinlock;
@@ -210,6 +214,11 @@ static ALWAYS_INLINE void *thread_runq(struct k_thread *thread)
 	cpu = m == 0 ? 0 : u32_count_trailing_zeros(m);
 
 	return &_kernel.cpus[cpu].ready_q.runq;
+#elif defined(CONFIG_SCHED_CPU_RUNQ)
+	/* A queued thread lives in the run queue of the CPU recorded
+	 * in base.cpu, see runq_target_cpu()
+	 */
+	return &_kernel.cpus[thread->base.cpu].ready_q.runq;
 #else
 	return &_kernel.ready_q.runq;
 #endif
@@ -217,15 +226,82 @@ static ALWAYS_INLINE void *thread_runq(struct k_thread *thread)
 
 static ALWAYS_INLINE void *curr_cpu_runq(void)
 {
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#ifdef CONFIG_SCHED_CPU_READY_Q
 	return &arch_curr_cpu()->ready_q.runq;
 #else
 	return &_kernel.ready_q.runq;
 #endif
 }
 
+#ifdef CONFIG_SCHED_CPU_RUNQ
+/* Picks the CPU whose run queue a thread being made runnable goes
+ * to: the CPU it last ran on if its mask still allows that (so it
+ * stays cache-warm), otherwise the current CPU or the first one
+ * allowed by the mask.
+ */
+static ALWAYS_INLINE uint8_t runq_target_cpu(struct k_thread *thread)
+{
+	unsigned int cpu = thread->base.cpu;
+	unsigned int curr = arch_curr_cpu()->id;
+
+#ifdef CONFIG_SCHED_CPU_MASK
+	uint32_t m = thread->base.cpu_mask;
+
+	if ((cpu < CONFIG_MP_NUM_CPUS) && ((m & BIT(cpu)) != 0U)) {
+		return cpu;
+	}
+
+	/* Same edge case as PIN_ONLY: a thread with all CPUs masked
+	 * off is legal but will never be selected anyway.
+	 */
+	if ((m == 0U) || ((m & BIT(curr)) != 0U)) {
+		return curr;
+	}
+
+	return u32_count_trailing_zeros(m);
+#else
+	return (cpu < CONFIG_MP_NUM_CPUS) ? cpu : curr;
+#endif
+}
+
+/* Work stealing: the best thread of the local run queue is passed
+ * in.  Only when there is none, i.e. the CPU would otherwise go idle,
+ * are the peer queues scanned and the best of their heads taken, so
+ * the common pick stays O(1) in the number of CPUs.  The stolen
+ * thread is taken out of its peer queue by the regular
+ * dequeue_thread() path, as its base.cpu still names it.
+ */
+static ALWAYS_INLINE struct k_thread *runq_steal(struct k_thread *best)
+{
+	unsigned int curr = arch_curr_cpu()->id;
+
+	if (best != NULL) {
+		return best;
+	}
+
+	for (unsigned int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		struct k_thread *thread;
+
+		if (i == curr) {
+			continue;
+		}
+
+		thread = _priq_run_best(&_kernel.cpus[i].ready_q.runq);
+		if ((thread != NULL) &&
+		    ((best == NULL) || (z_sched_prio_cmp(thread, best) > 0))) {
+			best = thread;
+		}
+	}
+
+	return best;
+}
+#endif
+
 static ALWAYS_INLINE void runq_add(struct k_thread *thread)
 {
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	thread->base.cpu = runq_target_cpu(thread);
+#endif
 	_priq_run_add(thread_runq(thread), thread);
 }
 
@@ -236,7 +312,11 @@ static ALWAYS_INLINE void runq_remove(struct k_thread *thread)
 
 static ALWAYS_INLINE struct k_thread *runq_best(void)
 {
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	return runq_steal(_priq_run_best(curr_cpu_runq()));
+#else
 	return _priq_run_best(curr_cpu_runq());
+#endif
 }
 
 /* _current is never in the run queue until context switch on
@@ -280,9 +360,29 @@ static void signal_pending_ipi(void)
 	 */
 #if defined(CONFIG_SMP) && defined(CONFIG_SCHED_IPI_SUPPORTED)
 	if (CONFIG_MP_NUM_CPUS > 1) {
-		if (_kernel.pending_ipi) {
-			_kernel.pending_ipi = false;
+		if (atomic_get(&_kernel.pending_ipi) != 0) {
+			unsigned int key = arch_irq_lock();
+			uint32_t cpus = atomic_clear(&_kernel.pending_ipi);
+
+			/* This CPU reschedules by itself.  Interrupts are
+			 * locked so that we can't migrate in between.
+			 */
+			cpus &= ~BIT(_current_cpu->id);
+			arch_irq_unlock(key);
+
+			if (cpus == 0U) {
+				return;
+			}
+#ifdef CONFIG_TRACE_SCHED_IPI
+			atomic_inc(&_kernel.ipi_stats.sent);
+			atomic_add(&_kernel.ipi_stats.targets,
+				   popcount(cpus));
+#endif
+#ifdef CONFIG_SCHED_DIRECTED_IPI_SUPPORTED
+			arch_sched_directed_ipi(cpus);
+#else
 			arch_sched_ipi();
+#endif
 		}
 	}
 #endif
@@ -584,7 +684,7 @@ static void update_cache(int preempt_ok)
 #endif
 }
 
-static bool thread_active_elsewhere(struct k_thread *thread)
+bool z_thread_active_elsewhere(struct k_thread *thread)
 {
 	/* True if the thread is currently running on another CPU.
 	 * There are more scalable designs to answer this question in
@@ -603,15 +703,190 @@ static bool thread_active_elsewhere(struct k_thread *thread)
 	return false;
 }
 
-static void flag_ipi(void)
+#define IPI_ALL_CPUS BIT_MASK(CONFIG_MP_NUM_CPUS)
+
+#if defined(CONFIG_SMP) && defined(CONFIG_SCHED_IPI_SUPPORTED)
+/* Returns the CPUs other than this one that should be interrupted to
+ * switch to a thread just made ready: those allowed to run it that are
+ * idle, or whose current thread it would preempt.  Called with
+ * sched_spinlock held after the thread is queued, so a CPU that isn't
+ * picked here and reschedules later finds it in the run queue anyway.
+ */
+static uint32_t ipi_mask_create(struct k_thread *thread)
+{
+	uint32_t ipi_mask = 0;
+	unsigned int id = _current_cpu->id;
+
+	for (unsigned int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		struct k_thread *curr = _kernel.cpus[i].current;
+
+		if ((i == id) || (curr == NULL)) {
+			continue;
+		}
+#ifdef CONFIG_SCHED_CPU_MASK
+		if ((thread->base.cpu_mask & BIT(i)) == 0U) {
+			continue;
+		}
+#endif
+		if (z_is_idle_thread_object(curr) ||
+		    ((is_preempt(curr) || is_metairq(thread)) &&
+		     (z_sched_prio_cmp(thread, curr) > 0))) {
+			ipi_mask |= BIT(i);
+		}
+	}
+
+	return ipi_mask;
+}
+#else
+static inline uint32_t ipi_mask_create(struct k_thread *thread)
+{
+	ARG_UNUSED(thread);
+
+	return 0;
+}
+#endif
+
+/* Adds CPUs to interrupt at the next scheduling point.  Readies in
+ * the same critical section are coalesced into a single IPI.
+ */
+static void flag_ipi(uint32_t ipi_mask)
 {
 #if defined(CONFIG_SMP) && defined(CONFIG_SCHED_IPI_SUPPORTED)
 	if (CONFIG_MP_NUM_CPUS > 1) {
-		_kernel.pending_ipi = true;
+#ifdef CONFIG_TRACE_SCHED_IPI
+		atomic_inc((ipi_mask != 0U) ? &_kernel.ipi_stats.flagged
+					    : &_kernel.ipi_stats.skipped);
+#endif
+		if (ipi_mask != 0U) {
+			(void)atomic_or(&_kernel.pending_ipi, ipi_mask);
+		}
 	}
+#else
+	ARG_UNUSED(ipi_mask);
 #endif
 }
 
+#ifdef CONFIG_SCHED_CBS
+/* Constant bandwidth servers.  A server may run for cbs_budget cycles
+ * in every cbs_period, and is ordered in the run queue by a deadline
+ * derived from the two.  The server on the CPU is charged at context
+ * switch, and cbs_timeout fires when it would exhaust its budget.  An
+ * exhausted server isn't throttled: it gets a fresh budget with its
+ * deadline postponed by a period, so it only runs ahead of the other
+ * servers while they have nothing to do.
+ */
+
+/* Reserved bandwidth is kept in parts per million */
+#define CBS_UNIT 1000000ULL
+
+static struct _timeout cbs_timeout;
+static struct k_thread *cbs_thread;
+static uint32_t cbs_bandwidth;
+
+static void cbs_postpone(struct k_thread *thread)
+{
+	thread->base.prio_deadline += thread->base.cbs_period;
+	thread->base.cbs_left = thread->base.cbs_budget;
+	if (z_is_thread_queued(thread)) {
+		dequeue_thread(thread);
+		queue_thread(thread);
+	}
+}
+
+static void cbs_charge(struct k_thread *thread)
+{
+	uint32_t used = k_cycle_get_32() - thread->base.cbs_start;
+
+	thread->base.cbs_start += used;
+	thread->base.cbs_left -= MIN(used, thread->base.cbs_left);
+}
+
+static void cbs_expired(struct _timeout *t);
+
+static void cbs_arm(struct k_thread *thread)
+{
+	uint32_t ticks = k_cyc_to_ticks_ceil32(thread->base.cbs_left);
+
+	cbs_thread = thread;
+	thread->base.cbs_start = k_cycle_get_32();
+	z_add_timeout(&cbs_timeout, cbs_expired, Z_TIMEOUT_TICKS(ticks));
+}
+
+static void cbs_expired(struct _timeout *t)
+{
+	ARG_UNUSED(t);
+
+	LOCKED(&sched_spinlock) {
+		struct k_thread *thread = cbs_thread;
+
+		if (thread != NULL) {
+			cbs_charge(thread);
+			if (thread->base.cbs_left == 0U) {
+				cbs_postpone(thread);
+				update_cache(thread == _current);
+			}
+			cbs_arm(thread);
+		}
+	}
+}
+
+void z_sched_cbs_start(struct k_thread *thread)
+{
+	if (thread->base.cbs_budget != 0U) {
+		cbs_arm(thread);
+	}
+}
+
+void z_sched_cbs_stop(void)
+{
+	struct k_thread *thread = cbs_thread;
+
+	if (thread == NULL) {
+		return;
+	}
+
+	(void)z_abort_timeout(&cbs_timeout);
+	cbs_thread = NULL;
+	cbs_charge(thread);
+	if ((thread->base.cbs_budget != 0U) && (thread->base.cbs_left == 0U)) {
+		cbs_postpone(thread);
+	}
+}
+
+/* A server waking up keeps its deadline and what is left of its
+ * budget only if running that out before the deadline stays within
+ * its bandwidth, otherwise it starts a new period from now.
+ */
+static void cbs_wakeup(struct k_thread *thread)
+{
+	uint32_t now = k_cycle_get_32();
+	int32_t until = (int32_t)((uint32_t)thread->base.prio_deadline - now);
+
+	if (thread->base.cbs_budget == 0U) {
+		return;
+	}
+
+	if ((until <= 0) ||
+	    ((uint64_t)thread->base.cbs_left * thread->base.cbs_period >=
+	     (uint64_t)until * thread->base.cbs_budget)) {
+		thread->base.prio_deadline = now + thread->base.cbs_period;
+		thread->base.cbs_left = thread->base.cbs_budget;
+	}
+}
+
+static void cbs_release(struct k_thread *thread)
+{
+	if (thread == cbs_thread) {
+		(void)z_abort_timeout(&cbs_timeout);
+		cbs_thread = NULL;
+	}
+	cbs_bandwidth -= thread->base.cbs_share;
+	thread->base.cbs_share = 0;
+	thread->base.cbs_budget = 0;
+	thread->base.cbs_left = 0;
+}
+#endif /* CONFIG_SCHED_CBS */
+
 static void ready_thread(struct k_thread *thread)
 {
 #ifdef CONFIG_KERNEL_COHERENCE
@@ -624,16 +899,20 @@ static void ready_thread(struct k_thread *thread)
 	if (!z_is_thread_queued(thread) && z_is_thread_ready(thread)) {
 		SYS_PORT_TRACING_OBJ_FUNC(k_thread, sched_ready, thread);
 
+		z_sched_latency_ready(thread);
+#ifdef CONFIG_SCHED_CBS
+		cbs_wakeup(thread);
+#endif
 		queue_thread(thread);
 		update_cache(0);
-		flag_ipi();
+		flag_ipi(ipi_mask_create(thread));
 	}
 }
 
 void z_ready_thread(struct k_thread *thread)
 {
 	LOCKED(&sched_spinlock) {
-		if (!thread_active_elsewhere(thread)) {
+		if (!z_thread_active_elsewhere(thread)) {
 			ready_thread(thread);
 		}
 	}
@@ -913,7 +1192,10 @@ void z_thread_priority_set(struct k_thread *thread, int prio)
 {
 	bool need_sched = z_set_prio(thread, prio);
 
-	flag_ipi();
+	/* The thread may be running elsewhere and no longer be the best
+	 * choice there, so every other CPU has to look
+	 */
+	flag_ipi(IPI_ALL_CPUS);
 
 	if (need_sched && _current->base.sched_locked == 0U) {
 		z_reschedule_unlocked();
@@ -1074,6 +1356,7 @@ void *z_get_next_switch_handle(void *interrupted)
 			arch_cohere_stacks(old_thread, interrupted, new_thread);
 
 			_current_cpu->swap_ok = 0;
+			new_thread->base.cpu = _current_cpu->id;
 			set_current(new_thread);
 
 #ifdef CONFIG_TIMESLICING
@@ -1242,6 +1525,68 @@ struct k_thread *z_priq_mq_best(struct _priq_mq *pq)
 	return thread;
 }
 
+#ifdef CONFIG_WAITQ_MULTIQ
+# if Z_PRIQ_BM_LEVELS > 32
+# error Too many priorities for multiqueue wait_q (max 32)
+# endif
+
+static inline struct k_thread *bm_thread(sys_dnode_t *n)
+{
+	return CONTAINER_OF(n, struct k_thread, base.qnode_dlist);
+}
+
+void z_priq_bm_add(struct _priq_bm *pq, struct k_thread *thread)
+{
+	int level = thread->base.prio - K_HIGHEST_THREAD_PRIO;
+	unsigned int above = pq->bitmask & ((BIT(level) - 1U) | BIT(level));
+
+	__ASSERT_NO_MSG(!z_is_idle_thread_object(thread));
+	__ASSERT_NO_MSG(level >= 0 && level < Z_PRIQ_BM_LEVELS);
+
+	/* Behind the last thread of the same priority, or else of the
+	 * nearest higher one, or at the head if there is none.
+	 */
+	if (above != 0U) {
+		struct k_thread *t = pq->tails[31 - __builtin_clz(above)];
+
+		sys_dlist_insert(t->base.qnode_dlist.next,
+				 &thread->base.qnode_dlist);
+	} else {
+		sys_dlist_prepend(&pq->list, &thread->base.qnode_dlist);
+	}
+
+	thread->base.order_key = level;
+	pq->tails[level] = thread;
+	pq->bitmask |= BIT(level);
+}
+
+void z_priq_bm_remove(struct _priq_bm *pq, struct k_thread *thread)
+{
+	int level = thread->base.order_key;
+	sys_dnode_t *prev = thread->base.qnode_dlist.prev;
+
+	__ASSERT_NO_MSG(!z_is_idle_thread_object(thread));
+
+	if (pq->tails[level] == thread) {
+		if (prev != &pq->list &&
+		    bm_thread(prev)->base.order_key == level) {
+			pq->tails[level] = bm_thread(prev);
+		} else {
+			pq->bitmask &= ~BIT(level);
+		}
+	}
+
+	sys_dlist_remove(&thread->base.qnode_dlist);
+}
+
+struct k_thread *z_priq_bm_best(struct _priq_bm *pq)
+{
+	sys_dnode_t *n = sys_dlist_peek_head(&pq->list);
+
+	return (n != NULL) ? bm_thread(n) : NULL;
+}
+#endif
+
 int z_unpend_all(_wait_q_t *wait_q)
 {
 	int need_sched = 0;
@@ -1265,7 +1610,7 @@ void init_ready_q(struct _ready_q *rq)
 		}
 	};
 #elif defined(CONFIG_SCHED_MULTIQ)
-	for (int i = 0; i < ARRAY_SIZE(_kernel.ready_q.runq.queues); i++) {
+	for (int i = 0; i < ARRAY_SIZE(rq->runq.queues); i++) {
 		sys_dlist_init(&rq->runq.queues[i]);
 	}
 #else
@@ -1275,7 +1620,7 @@ void init_ready_q(struct _ready_q *rq)
 
 void z_sched_init(void)
 {
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#ifdef CONFIG_SCHED_CPU_READY_Q
 	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
 		init_ready_q(&_kernel.cpus[i].ready_q);
 	}
@@ -1362,6 +1707,61 @@ static inline void z_vrfy_k_thread_deadline_set(k_tid_t tid, int deadline)
 #endif
 #endif
 
+#ifdef CONFIG_SCHED_CBS
+int k_thread_cbs_set(k_tid_t tid, uint32_t budget_us, uint32_t period_us)
+{
+	struct k_thread *thread = tid;
+	uint64_t budget = k_us_to_cyc_ceil64(budget_us);
+	uint64_t period = k_us_to_cyc_ceil64(period_us);
+	uint32_t limit = CONFIG_SCHED_CBS_MAX_UTILIZATION * (CBS_UNIT / 100);
+	uint32_t share = 0;
+	int ret = 0;
+
+	if (budget_us == 0U) {
+		budget = 0U;
+	} else if ((budget_us > period_us) || (period > INT32_MAX)) {
+		return -EINVAL;
+	} else {
+		share = (budget_us * CBS_UNIT + period_us - 1) / period_us;
+	}
+
+	LOCKED(&sched_spinlock) {
+		uint32_t others = cbs_bandwidth - thread->base.cbs_share;
+
+		if ((thread->base.thread_state & _THREAD_DEAD) != 0U) {
+			ret = -EINVAL;
+		} else if (others + share > limit) {
+			ret = -ENOSPC;
+		} else {
+			if (thread == cbs_thread) {
+				z_sched_cbs_stop();
+			}
+
+			cbs_bandwidth = others + share;
+			thread->base.cbs_share = share;
+			thread->base.cbs_budget = budget;
+			thread->base.cbs_period = period;
+			thread->base.cbs_left = budget;
+
+			if (budget != 0U) {
+				thread->base.prio_deadline = k_cycle_get_32() +
+							     (int)period;
+				if (z_is_thread_queued(thread)) {
+					dequeue_thread(thread);
+					queue_thread(thread);
+				}
+			}
+
+			if (thread == _current) {
+				z_sched_cbs_start(thread);
+			}
+		}
+	}
+
+	return ret;
+}
+#endif
+
 bool k_can_yield(void)
 {
 	return !(k_is_pre_kernel() || k_is_in_isr() ||
@@ -1518,15 +1918,16 @@ void z_impl_k_wakeup(k_tid_t thread)
 	z_mark_thread_as_not_suspended(thread);
 	z_ready_thread(thread);
 
-	flag_ipi();
-
 	if (!arch_is_in_isr()) {
 		z_reschedule_unlocked();
 	}
 }
 
 #ifdef CONFIG_TRACE_SCHED_IPI
-extern void z_trace_sched_ipi(void);
+/* Test hook, overridden by tests that check IPIs are delivered */
+__weak void z_trace_sched_ipi(void)
+{
+}
 #endif
 
 #ifdef CONFIG_SMP
@@ -1536,6 +1937,7 @@ void z_sched_ipi(void)
 	 * at appropriate location when !CONFIG_SCHED_IPI_SUPPORTED.
 	 */
 #ifdef CONFIG_TRACE_SCHED_IPI
+	atomic_inc(&_kernel.ipi_stats.received);
 	z_trace_sched_ipi();
 #endif
 }
@@ -1689,6 +2091,9 @@ static void end_thread(struct k_thread *thread)
 		}
 		(void)z_abort_thread_timeout(thread);
 		unpend_all(&thread->join_queue);
+#ifdef CONFIG_SCHED_CBS
+		cbs_release(thread);
+#endif
 		update_cache(1);
 
 		SYS_PORT_TRACING_FUNC(k_thread, sched_abort, thread);
@@ -1723,7 +2128,7 @@ void z_thread_abort(struct k_thread *thread)
 		end_thread(thread);
 	}
 
-	bool active = thread_active_elsewhere(thread);
+	bool active = z_thread_active_elsewhere(thread);
 
 	if (active) {
 		/* It's running somewhere else, flag and poke */
@@ -32,9 +32,8 @@
 /* We use a system-wide lock to synchronize semaphores, which has
  * unfortunate performance impact vs. using a per-object lock
  * (semaphores are *very* widely used).  But per-object locks require
- * significant extra RAM.  A properly spin-aware semaphore
- * implementation would spin on atomic access to the count variable,
- * and not a spinlock per se.  Useful optimization for the future...
+ * significant extra RAM.  With CONFIG_SYNC_FAST_PATH, uncontended
+ * gives and takes work on the count atomically and skip the lock.
  */
 static struct k_spinlock lock;
 
@@ -50,8 +49,9 @@ int z_impl_k_sem_init(struct k_sem *sem, unsigned int initial_count,
 		return -EINVAL;
 	}
 
-	sem->count = initial_count;
-	sem->limit = limit;
+	/* With the fast path, one bit of the count flags waiters */
+	sem->count = MIN(initial_count, Z_SEM_COUNT_MAX);
+	sem->limit = MIN(limit, Z_SEM_COUNT_MAX);
 
 	SYS_PORT_TRACING_OBJ_FUNC(k_sem, init, sem, 0);
 
@@ -83,11 +83,119 @@ static inline void handle_poll_events(struct k_sem *sem)
 #endif
 }
 
+#ifdef CONFIG_SYNC_FAST_PATH
+/* The count is only changed with a CAS, so that decrements and
+ * increments made without the lock can't be lost, and increments
+ * without the lock are only made while Z_SEM_WAITERS is clear.  The
+ * flag is set with the lock held before a thread pends, and by k_poll()
+ * after it registers an event, and cleared with the lock held once
+ * neither are left.
+ */
+static bool sem_count_take(struct k_sem *sem)
+{
+	atomic_val_t count;
+
+	do {
+		count = atomic_get(&sem->count);
+		if ((count & Z_SEM_COUNT_MASK) == 0) {
+			return false;
+		}
+	} while (!atomic_cas(&sem->count, count, count - 1));
+
+	return true;
+}
+
+static bool sem_count_give(struct k_sem *sem, bool locked)
+{
+	atomic_val_t count;
+
+	do {
+		count = atomic_get(&sem->count);
+		if (!locked && ((count & Z_SEM_WAITERS) != 0)) {
+			return false;
+		}
+		if ((unsigned int)(count & Z_SEM_COUNT_MASK) == sem->limit) {
+			return true;
+		}
+	} while (!atomic_cas(&sem->count, count, count + 1));
+
+	return true;
+}
+
+static inline void sem_count_reset(struct k_sem *sem)
+{
+	(void)atomic_and(&sem->count, Z_SEM_WAITERS);
+}
+
+static inline void sem_mark_waiters(struct k_sem *sem)
+{
+	(void)atomic_or(&sem->count, Z_SEM_WAITERS);
+}
+
+static void sem_settle_waiters(struct k_sem *sem)
+{
+	if (z_waitq_head(&sem->wait_q) != NULL) {
+		return;
+	}
+
+	(void)atomic_and(&sem->count, ~Z_SEM_WAITERS);
+
+#ifdef CONFIG_POLL
+	/* k_poll() flags the semaphore after registering, without our
+	 * lock, so look again after clearing.
+	 */
+	if (!sys_dlist_is_empty(&sem->poll_events)) {
+		sem_mark_waiters(sem);
+	}
+#endif
+}
+#else
+static inline bool sem_count_take(struct k_sem *sem)
+{
+	if (sem->count > 0U) {
+		sem->count--;
+		return true;
+	}
+	return false;
+}
+
+static inline bool sem_count_give(struct k_sem *sem, bool locked)
+{
+	ARG_UNUSED(locked);
+
+	sem->count += (sem->count != sem->limit) ? 1U : 0U;
+	return true;
+}
+
+static inline void sem_count_reset(struct k_sem *sem)
+{
+	sem->count = 0U;
+}
+
+static inline void sem_mark_waiters(struct k_sem *sem)
+{
+	ARG_UNUSED(sem);
+}
+
+static inline void sem_settle_waiters(struct k_sem *sem)
+{
+	ARG_UNUSED(sem);
+}
+#endif
+
 void z_impl_k_sem_give(struct k_sem *sem)
 {
-	k_spinlock_key_t key = k_spin_lock(&lock);
+	k_spinlock_key_t key;
 	struct k_thread *thread;
 
+	if (IS_ENABLED(CONFIG_SYNC_FAST_PATH) && sem_count_give(sem, false)) {
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_sem, give, sem);
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_sem, give, sem);
+		return;
+	}
+
+	key = k_spin_lock(&lock);
+
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_sem, give, sem);
 
 	thread = z_unpend_first_thread(&sem->wait_q);
@@ -96,10 +204,12 @@ void z_impl_k_sem_give(struct k_sem *sem)
 		arch_thread_return_value_set(thread, 0);
 		z_ready_thread(thread);
 	} else {
-		sem->count += (sem->count != sem->limit) ? 1U : 0U;
+		(void)sem_count_give(sem, true);
 		handle_poll_events(sem);
 	}
 
+	sem_settle_waiters(sem);
+
 	z_reschedule(&lock, key);
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_sem, give, sem);
@@ -121,12 +231,16 @@ int z_impl_k_sem_take(struct k_sem *sem, k_timeout_t timeout)
 	__ASSERT(((arch_is_in_isr() == false) ||
 		  K_TIMEOUT_EQ(timeout, K_NO_WAIT)), "");
 
+	if (IS_ENABLED(CONFIG_SYNC_FAST_PATH) && likely(sem_count_take(sem))) {
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_sem, take, sem, timeout);
+		goto out;
+	}
+
 	k_spinlock_key_t key = k_spin_lock(&lock);
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_sem, take, sem, timeout);
 
-	if (likely(sem->count > 0U)) {
-		sem->count--;
+	if (likely(sem_count_take(sem))) {
 		k_spin_unlock(&lock, key);
 		ret = 0;
 		goto out;
@@ -138,6 +252,16 @@ int z_impl_k_sem_take(struct k_sem *sem, k_timeout_t timeout)
 		goto out;
 	}
 
+	/* Once flagged, gives come through the lock and will see us on
+	 * the wait queue, but one may have slipped in before.
+	 */
+	sem_mark_waiters(sem);
+	if (IS_ENABLED(CONFIG_SYNC_FAST_PATH) && sem_count_take(sem)) {
+		k_spin_unlock(&lock, key);
+		ret = 0;
+		goto out;
+	}
+
 	SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_sem, take, sem, timeout);
 
 	ret = z_pend_curr(&lock, key, &sem->wait_q, timeout);
@@ -161,12 +285,14 @@ void z_impl_k_sem_reset(struct k_sem *sem)
 		arch_thread_return_value_set(thread, -EAGAIN);
 		z_ready_thread(thread);
 	}
-	sem->count = 0;
+	sem_count_reset(sem);
 
 	SYS_PORT_TRACING_OBJ_FUNC(k_sem, reset, sem);
 
 	handle_poll_events(sem);
 
+	sem_settle_waiters(sem);
+
 	z_reschedule(&lock, key);
 }
 
@@ -623,6 +623,11 @@ char *z_setup_new_thread(struct k_thread *new_thread,
 #endif
 #ifdef CONFIG_SCHED_DEADLINE
 	new_thread->base.prio_deadline = 0;
+#endif
+#ifdef CONFIG_SCHED_CBS
+	new_thread->base.cbs_budget = 0;
+	new_thread->base.cbs_share = 0;
+	new_thread->base.cbs_left = 0;
 #endif
 	new_thread->resource_pool = _current->resource_pool;
 
@@ -631,6 +636,10 @@ char *z_setup_new_thread(struct k_thread *new_thread,
 	new_thread->base.usage.track_usage =
 		CONFIG_SCHED_THREAD_USAGE_AUTO_ENABLE;
 #endif
+#ifdef CONFIG_SCHED_LATENCY_STATS
+	new_thread->base.ready_stamp = 0;
+	new_thread->base.latency = (struct k_sched_latency_stats) {};
+#endif
 
 	SYS_PORT_TRACING_OBJ_FUNC(k_thread, create, new_thread);
 
@@ -1045,6 +1054,9 @@ void z_thread_mark_switched_in(void)
 #if defined(CONFIG_SCHED_THREAD_USAGE) && !defined(CONFIG_USE_SWITCH)
 	z_sched_usage_start(_current);
 #endif
+#if defined(CONFIG_SCHED_CBS) && !defined(CONFIG_USE_SWITCH)
+	z_sched_cbs_start(_current);
+#endif
 
 #ifdef CONFIG_TRACING
 	SYS_PORT_TRACING_FUNC(k_thread, switched_in);
@@ -1056,6 +1068,9 @@ void z_thread_mark_switched_out(void)
 #if defined(CONFIG_SCHED_THREAD_USAGE) && !defined(CONFIG_USE_SWITCH)
 	z_sched_usage_stop();
 #endif
+#if defined(CONFIG_SCHED_CBS) && !defined(CONFIG_USE_SWITCH)
+	z_sched_cbs_stop();
+#endif
 
 #ifdef CONFIG_TRACING
 	SYS_PORT_TRACING_FUNC(k_thread, switched_out);
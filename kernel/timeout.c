@@ -11,10 +11,13 @@
 #include <syscall_handler.h>
 #include <drivers/timer/system_timer.h>
 #include <sys_clock.h>
+#include <sys/math_extras.h>
 
 static uint64_t curr_tick;
 
+#ifndef CONFIG_TIMEOUT_QUEUE_WHEEL
 static sys_dlist_t timeout_list = SYS_DLIST_STATIC_INIT(&timeout_list);
+#endif
 
 static struct k_spinlock timeout_lock;
 
@@ -36,6 +39,173 @@ static inline int z_vrfy_sys_clock_hw_cycles_per_sec_runtime_get(void)
 #endif /* CONFIG_USERSPACE */
 #endif /* CONFIG_TIMER_READS_ITS_FREQUENCY_AT_RUNTIME */
 
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+/* Hierarchical timing wheel.  Level L has WHEEL_SLOTS slots, each
+ * spanning WHEEL_SLOTS^L ticks.  A timeout lives at the lowest level
+ * whose enclosing block of WHEEL_SLOTS^(L+1) ticks also contains
+ * curr_tick, in the slot selected by the bits of its expiry at that
+ * level.  Timeouts beyond the top level wait in an unsorted overflow
+ * list.  Whenever curr_tick moves into a new block, the slot of the
+ * level above that covers it is redistributed ("cascaded") to lower
+ * levels.  Insertion and removal are O(1), finding the earliest
+ * timeout only scans a single slot.
+ *
+ * In this mode _timeout.dticks holds the absolute expiry tick.
+ */
+#define WHEEL_BITS	6
+#define WHEEL_SLOTS	BIT(WHEEL_BITS)
+#define WHEEL_MASK	(WHEEL_SLOTS - 1)
+#define WHEEL_LEVELS	CONFIG_TIMEOUT_WHEEL_LEVELS
+
+/* A slot list is only valid while its bit is set in wheel_used, so
+ * the (zeroed) array needs no initialization.
+ */
+static sys_dlist_t wheel[WHEEL_LEVELS][WHEEL_SLOTS];
+static uint64_t wheel_used[WHEEL_LEVELS];
+static sys_dlist_t wheel_overflow = SYS_DLIST_STATIC_INIT(&wheel_overflow);
+
+static inline bool wheel_same_block(uint64_t a, uint64_t b, int level)
+{
+	unsigned int shift = WHEEL_BITS * (level + 1);
+
+	return (a >> shift) == (b >> shift);
+}
+
+static inline unsigned int wheel_index(uint64_t expiry, int level)
+{
+	return (expiry >> (WHEEL_BITS * level)) & WHEEL_MASK;
+}
+
+static void wheel_place(struct _timeout *t)
+{
+	uint64_t expiry = t->dticks;
+
+	for (int l = 0; l < WHEEL_LEVELS; l++) {
+		if (wheel_same_block(expiry, curr_tick, l)) {
+			unsigned int s = wheel_index(expiry, l);
+
+			if ((wheel_used[l] & BIT64(s)) == 0U) {
+				sys_dlist_init(&wheel[l][s]);
+				wheel_used[l] |= BIT64(s);
+			}
+			sys_dlist_append(&wheel[l][s], &t->node);
+			return;
+		}
+	}
+
+	sys_dlist_append(&wheel_overflow, &t->node);
+}
+
+/* Must be called after curr_tick moved forward from @a prev, but not
+ * past the earliest pending expiry.  Only the slots covering the new
+ * curr_tick can then hold timeouts placed too high, and they are
+ * cascaded top-down so timeouts with equal expiry keep their order.
+ */
+static void wheel_cascade(uint64_t prev)
+{
+	struct _timeout *t, *tmp;
+
+	if (!wheel_same_block(prev, curr_tick, WHEEL_LEVELS - 1)) {
+		SYS_DLIST_FOR_EACH_CONTAINER_SAFE(&wheel_overflow, t, tmp, node) {
+			if (wheel_same_block(t->dticks, curr_tick,
+					     WHEEL_LEVELS - 1)) {
+				sys_dlist_remove(&t->node);
+				wheel_place(t);
+			}
+		}
+	}
+
+	for (int l = WHEEL_LEVELS - 1; l > 0; l--) {
+		unsigned int s = wheel_index(curr_tick, l);
+		sys_dnode_t *n;
+
+		if (wheel_same_block(prev, curr_tick, l - 1) ||
+		    ((wheel_used[l] & BIT64(s)) == 0U)) {
+			continue;
+		}
+
+		wheel_used[l] &= ~BIT64(s);
+		while ((n = sys_dlist_get(&wheel[l][s])) != NULL) {
+			wheel_place(CONTAINER_OF(n, struct _timeout, node));
+		}
+	}
+}
+
+/* Earliest timeout of a list, first inserted one on ties */
+static struct _timeout *wheel_list_min(sys_dlist_t *list)
+{
+	struct _timeout *t, *ret = NULL;
+
+	SYS_DLIST_FOR_EACH_CONTAINER(list, t, node) {
+		if ((ret == NULL) || (t->dticks < ret->dticks)) {
+			ret = t;
+		}
+	}
+
+	return ret;
+}
+
+static struct _timeout *first(void)
+{
+	/* Pending timeouts never sit in a slot before the one covering
+	 * curr_tick, so the lowest used slot of the lowest non-empty
+	 * level holds the earliest expiry.  All timeouts of a level 0
+	 * slot share the same expiry tick.
+	 */
+	for (int l = 0; l < WHEEL_LEVELS; l++) {
+		if (wheel_used[l] != 0U) {
+			sys_dlist_t *slot =
+				&wheel[l][u64_count_trailing_zeros(wheel_used[l])];
+
+			if (l == 0) {
+				return CONTAINER_OF(sys_dlist_peek_head(slot),
+						    struct _timeout, node);
+			}
+			return wheel_list_min(slot);
+		}
+	}
+
+	return wheel_list_min(&wheel_overflow);
+}
+
+static void remove_timeout(struct _timeout *t)
+{
+	uint64_t expiry = t->dticks;
+
+	sys_dlist_remove(&t->node);
+
+	for (int l = 0; l < WHEEL_LEVELS; l++) {
+		if (wheel_same_block(expiry, curr_tick, l)) {
+			unsigned int s = wheel_index(expiry, l);
+
+			if (sys_dlist_is_empty(&wheel[l][s])) {
+				wheel_used[l] &= ~BIT64(s);
+			}
+			return;
+		}
+	}
+}
+
+/* Ticks from curr_tick until @a t expires */
+static k_ticks_t timeout_dticks(const struct _timeout *t)
+{
+	return t->dticks - (k_ticks_t)curr_tick;
+}
+
+static void timeout_insert(struct _timeout *to)
+{
+	to->dticks += curr_tick;
+	wheel_place(to);
+}
+
+static void advance(int32_t ticks)
+{
+	uint64_t prev = curr_tick;
+
+	curr_tick += ticks;
+	wheel_cascade(prev);
+}
+#else
 static struct _timeout *first(void)
 {
 	sys_dnode_t *t = sys_dlist_peek_head(&timeout_list);
@@ -59,6 +229,55 @@ static void remove_timeout(struct _timeout *t)
 	sys_dlist_remove(&t->node);
 }
 
+/* Ticks from curr_tick until @a t expires, walking the deltas of all
+ * preceding timeouts
+ */
+static k_ticks_t timeout_dticks(const struct _timeout *timeout)
+{
+	k_ticks_t ticks = 0;
+
+	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
+		ticks += t->dticks;
+		if (timeout == t) {
+			break;
+		}
+	}
+
+	return ticks;
+}
+
+/* Inserts @a to, whose dticks is relative to curr_tick, into the
+ * delta list
+ */
+static void timeout_insert(struct _timeout *to)
+{
+	struct _timeout *t;
+
+	for (t = first(); t != NULL; t = next(t)) {
+		if (t->dticks > to->dticks) {
+			t->dticks -= to->dticks;
+			sys_dlist_insert(&t->node, &to->node);
+			break;
+		}
+		to->dticks -= t->dticks;
+	}
+
+	if (t == NULL) {
+		sys_dlist_append(&timeout_list, &to->node);
+	}
+}
+
+static void advance(int32_t ticks)
+{
+	struct _timeout *t = first();
+
+	if (t != NULL) {
+		t->dticks -= ticks;
+	}
+	curr_tick += ticks;
+}
+#endif /* CONFIG_TIMEOUT_QUEUE_WHEEL */
+
 static int32_t elapsed(void)
 {
 	return announce_remaining == 0 ? sys_clock_elapsed() : 0U;
@@ -71,10 +290,10 @@ static int32_t next_timeout(void)
 	int32_t ret;
 
 	if ((to == NULL) ||
-	    ((int64_t)(to->dticks - ticks_elapsed) > (int64_t)INT_MAX)) {
+	    ((int64_t)(timeout_dticks(to) - ticks_elapsed) > (int64_t)INT_MAX)) {
 		ret = MAX_WAIT;
 	} else {
-		ret = MAX(0, to->dticks - ticks_elapsed);
+		ret = MAX(0, timeout_dticks(to) - ticks_elapsed);
 	}
 
 #ifdef CONFIG_TIMESLICING
@@ -100,8 +319,6 @@ void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 	to->fn = fn;
 
 	LOCKED(&timeout_lock) {
-		struct _timeout *t;
-
 		if (IS_ENABLED(CONFIG_TIMEOUT_64BIT) &&
 		    Z_TICK_ABS(timeout.ticks) >= 0) {
 			k_ticks_t ticks = Z_TICK_ABS(timeout.ticks) - curr_tick;
@@ -111,18 +328,7 @@ void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 			to->dticks = timeout.ticks + 1 + elapsed();
 		}
 
-		for (t = first(); t != NULL; t = next(t)) {
-			if (t->dticks > to->dticks) {
-				t->dticks -= to->dticks;
-				sys_dlist_insert(&t->node, &to->node);
-				break;
-			}
-			to->dticks -= t->dticks;
-		}
-
-		if (t == NULL) {
-			sys_dlist_append(&timeout_list, &to->node);
-		}
+		timeout_insert(to);
 
 		if (to == first()) {
 #if CONFIG_TIMESLICING
@@ -170,12 +376,7 @@ static k_ticks_t timeout_rem(const struct _timeout *timeout)
 		return 0;
 	}
 
-	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
-		ticks += t->dticks;
-		if (timeout == t) {
-			break;
-		}
-	}
+	ticks = timeout_dticks(timeout);
 
 	return ticks - elapsed();
 }
@@ -258,13 +459,13 @@ void sys_clock_announce(int32_t ticks)
 
 	announce_remaining = ticks;
 
-	while (first() != NULL && first()->dticks <= announce_remaining) {
-		struct _timeout *t = first();
-		int dt = t->dticks;
+	for (struct _timeout *t = first();
+	     (t != NULL) && (timeout_dticks(t) <= announce_remaining);
+	     t = first()) {
+		int dt = timeout_dticks(t);
 
-		curr_tick += dt;
 		announce_remaining -= dt;
-		t->dticks = 0;
+		advance(dt);
 		remove_timeout(t);
 
 		k_spin_unlock(&timeout_lock, key);
@@ -272,11 +473,7 @@ void sys_clock_announce(int32_t ticks)
 		key = k_spin_lock(&timeout_lock);
 	}
 
-	if (first() != NULL) {
-		first()->dticks -= announce_remaining;
-	}
-
-	curr_tick += announce_remaining;
+	advance(announce_remaining);
 	announce_remaining = 0;
 
 	sys_clock_set_timeout(next_timeout(), false);
@@ -10,6 +10,7 @@
 #include <ksched.h>
 #include <spinlock.h>
 #include <sys/check.h>
+#include <sys/math_extras.h>
 
 /* Need one of these for this to work */
 #if !defined(CONFIG_USE_SWITCH) && !defined(CONFIG_INSTRUMENT_THREAD_SWITCHING)
@@ -55,6 +56,65 @@ static void sched_cpu_update_usage(struct _cpu *cpu, uint32_t cycles)
 #define sched_cpu_update_usage(cpu, cycles)   do { } while (0)
 #endif
 
+#ifdef CONFIG_SCHED_LATENCY_STATS
+static void latency_hist_add(uint32_t *hist, uint32_t cycles)
+{
+	int bucket = 31 - u32_count_leading_zeros(cycles | 1U);
+
+	hist[MIN(bucket, CONFIG_SCHED_LATENCY_STATS_BUCKETS - 1)]++;
+}
+
+void z_sched_latency_ready(struct k_thread *thread)
+{
+	thread->base.ready_stamp = usage_now();
+}
+
+/* Accounts the wakeup latency of a thread about to run */
+static void sched_latency_start(struct _cpu *cpu, struct k_thread *thread)
+{
+	uint32_t now = usage_now();
+	uint32_t stamp = thread->base.ready_stamp;
+
+	if (z_is_idle_thread_object(thread)) {
+		cpu->slice0 = 0;
+		return;
+	}
+
+	cpu->slice0 = now;
+
+	if (stamp != 0) {
+		latency_hist_add(thread->base.latency.wakeup, now - stamp);
+		latency_hist_add(cpu->latency.wakeup, now - stamp);
+		thread->base.ready_stamp = 0;
+	}
+}
+
+/* Accounts the run slice of the thread being switched out */
+static void sched_latency_stop(struct _cpu *cpu)
+{
+	struct k_thread *thread = cpu->current;
+	uint32_t cycles;
+
+	if (cpu->slice0 == 0) {
+		return;
+	}
+
+	cycles = usage_now() - cpu->slice0;
+	latency_hist_add(thread->base.latency.slice, cycles);
+	latency_hist_add(cpu->latency.slice, cycles);
+
+	if (z_is_thread_ready(thread)) {
+		thread->base.latency.preempted++;
+		cpu->latency.preempted++;
+	}
+
+	cpu->slice0 = 0;
+}
+#else
+#define sched_latency_start(cpu, thread)   do { } while (0)
+#define sched_latency_stop(cpu)            do { } while (0)
+#endif
+
 static void sched_thread_update_usage(struct k_thread *thread, uint32_t cycles)
 {
 	thread->base.usage.total += cycles;
@@ -91,6 +151,8 @@ void z_sched_usage_start(struct k_thread *thread)
 
 	_current_cpu->usage0 = usage_now();
 #endif
+
+	sched_latency_start(_current_cpu, thread);
 }
 
 void z_sched_usage_stop(void)
@@ -109,6 +171,8 @@ void z_sched_usage_stop(void)
 		sched_cpu_update_usage(cpu, cycles);
 	}
 
+	sched_latency_stop(cpu);
+
 	cpu->usage0 = 0;
 	k_spin_unlock(&usage_lock, k);
 }
@@ -331,3 +395,36 @@ void k_sys_runtime_stats_disable(void)
 	k_spin_unlock(&usage_lock, key);
 }
 #endif
+
+#ifdef CONFIG_SCHED_LATENCY_STATS
+int k_thread_latency_stats_get(k_tid_t thread,
+			       struct k_sched_latency_stats *stats)
+{
+	k_spinlock_key_t  key;
+
+	if ((thread == NULL) || (stats == NULL)) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&usage_lock);
+	*stats = thread->base.latency;
+	k_spin_unlock(&usage_lock, key);
+
+	return 0;
+}
+
+int k_cpu_latency_stats_get(int cpu, struct k_sched_latency_stats *stats)
+{
+	k_spinlock_key_t  key;
+
+	if ((cpu < 0) || (cpu >= CONFIG_MP_NUM_CPUS) || (stats == NULL)) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&usage_lock);
+	*stats = _kernel.cpus[cpu].latency;
+	k_spin_unlock(&usage_lock, key);
+
+	return 0;
+}
+#endif
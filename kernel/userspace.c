@@ -8,7 +8,6 @@
 #include <kernel.h>
 #include <string.h>
 #include <sys/math_extras.h>
-#include <sys/rb.h>
 #include <kernel_structs.h>
 #include <sys/sys_io.h>
 #include <ksched.h>
@@ -47,7 +46,7 @@ LOG_MODULE_DECLARE(os, CONFIG_KERNEL_LOG_LEVEL);
  * not.
  */
 #ifdef CONFIG_DYNAMIC_OBJECTS
-static struct k_spinlock lists_lock;       /* kobj rbtree/dlist */
+static struct k_spinlock lists_lock;       /* kobj hash table */
 static struct k_spinlock objfree_lock;     /* k_object_free */
 #endif
 static struct k_spinlock obj_lock;         /* kobj struct data */
@@ -135,8 +134,6 @@ uint8_t *z_priv_stack_find(k_thread_stack_t *stack)
 
 struct dyn_obj {
 	struct z_object kobj;
-	sys_dnode_t dobj_list;
-	struct rbnode node; /* must be immediately before data member */
 
 	/* The object itself */
 	uint8_t data[] __aligned(DYN_OBJ_DATA_ALIGN_K_THREAD);
@@ -146,26 +143,24 @@ extern struct z_object *z_object_gperf_find(const void *obj);
 extern void z_object_gperf_wordlist_foreach(_wordlist_cb_func_t func,
 					     void *context);
 
-static bool node_lessthan(struct rbnode *a, struct rbnode *b);
-
-/*
- * Red/black tree of allocated kernel objects, for reasonably fast lookups
- * based on object pointer values.
- */
-static struct rbtree obj_rb_tree = {
-	.lessthan_fn = node_lessthan
-};
-
 /*
- * Linked list of allocated kernel objects, for iteration over all allocated
- * objects (and potentially deleting them during iteration).
- */
-static sys_dlist_t obj_list = SYS_DLIST_STATIC_INIT(&obj_list);
-
-/*
- * TODO: Write some hash table code that will replace both obj_rb_tree
- * and obj_list.
+ * Open-addressing hash table of allocated kernel objects, keyed by
+ * object address, with linear probing.  Removed entries are replaced
+ * with a marker so that probe sequences stay intact, which also lets
+ * objects be freed while iterating over the table.  The table is
+ * doubled, or rebuilt to drop markers, when more than 3/4 full.
  */
+#define OBJ_TABLE_MIN_BITS	4U
+#define OBJ_TABLE_MIN_SIZE	BIT(OBJ_TABLE_MIN_BITS)
+#define OBJ_TABLE_REMOVED	((struct dyn_obj *)&obj_table)
+
+static struct {
+	struct dyn_obj **slots;
+	size_t size;	/* power of two, zero until first use */
+	unsigned int bits; /* log2(size) */
+	size_t count;	/* objects in the table */
+	size_t used;	/* objects plus removed markers */
+} obj_table;
 
 static size_t obj_size_get(enum k_objects otype)
 {
@@ -201,41 +196,116 @@ static size_t obj_align_get(enum k_objects otype)
 	return ret;
 }
 
-static bool node_lessthan(struct rbnode *a, struct rbnode *b)
+static inline size_t obj_table_hash(const void *obj)
 {
-	return a < b;
+	/* Fibonacci hashing, objects are at least pointer-aligned */
+	uint32_t key = (uint32_t)((uintptr_t)obj / sizeof(void *));
+
+	return (size_t)((key * 2654435769U) >> (32U - obj_table.bits));
 }
 
-static inline struct dyn_obj *node_to_dyn_obj(struct rbnode *node)
+static struct dyn_obj **obj_table_slot(const void *obj)
 {
-	return CONTAINER_OF(node, struct dyn_obj, node);
+	size_t i;
+
+	if (obj_table.size == 0U) {
+		return NULL;
+	}
+
+	for (i = obj_table_hash(obj); obj_table.slots[i] != NULL;
+	     i = (i + 1U) & (obj_table.size - 1U)) {
+		if ((obj_table.slots[i] != OBJ_TABLE_REMOVED) &&
+		    (obj_table.slots[i]->kobj.name == obj)) {
+			return &obj_table.slots[i];
+		}
+	}
+
+	return NULL;
 }
 
-static inline struct rbnode *dyn_obj_to_node(void *obj)
+static void obj_table_place(struct dyn_obj *dyn)
 {
-	struct dyn_obj *dobj = CONTAINER_OF(obj, struct dyn_obj, data);
+	size_t i = obj_table_hash(dyn->kobj.name);
 
-	return &dobj->node;
+	while ((obj_table.slots[i] != NULL) &&
+	       (obj_table.slots[i] != OBJ_TABLE_REMOVED)) {
+		i = (i + 1U) & (obj_table.size - 1U);
+	}
+
+	if (obj_table.slots[i] == NULL) {
+		obj_table.used++;
+	}
+	obj_table.slots[i] = dyn;
+	obj_table.count++;
+}
+
+static bool obj_table_resize(void)
+{
+	struct dyn_obj **old_slots = obj_table.slots;
+	size_t old_size = obj_table.size;
+	size_t size = OBJ_TABLE_MIN_SIZE;
+	unsigned int bits = OBJ_TABLE_MIN_BITS;
+
+	while ((size * 3U) / 4U <= obj_table.count * 2U) {
+		size *= 2U;
+		bits++;
+	}
+
+	obj_table.slots = z_thread_malloc(size * sizeof(struct dyn_obj *));
+	if (obj_table.slots == NULL) {
+		obj_table.slots = old_slots;
+		return false;
+	}
+	(void)memset(obj_table.slots, 0, size * sizeof(struct dyn_obj *));
+	obj_table.size = size;
+	obj_table.bits = bits;
+	obj_table.count = 0U;
+	obj_table.used = 0U;
+
+	for (size_t i = 0; i < old_size; i++) {
+		if ((old_slots[i] != NULL) &&
+		    (old_slots[i] != OBJ_TABLE_REMOVED)) {
+			obj_table_place(old_slots[i]);
+		}
+	}
+	k_free(old_slots);
+
+	return true;
+}
+
+static bool obj_table_insert(struct dyn_obj *dyn)
+{
+	if (((obj_table.used + 1U) * 4U > obj_table.size * 3U) &&
+	    !obj_table_resize()) {
+		return false;
+	}
+
+	obj_table_place(dyn);
+
+	return true;
+}
+
+static void obj_table_remove(struct dyn_obj **slot)
+{
+	*slot = OBJ_TABLE_REMOVED;
+	obj_table.count--;
+
+	if (obj_table.count == 0U) {
+		/* Nothing left to probe past */
+		(void)memset(obj_table.slots, 0,
+			     obj_table.size * sizeof(struct dyn_obj *));
+		obj_table.used = 0U;
+	}
 }
 
 static struct dyn_obj *dyn_object_find(void *obj)
 {
-	struct rbnode *node;
+	struct dyn_obj **slot;
 	struct dyn_obj *ret;
 
-	/* For any dynamically allocated kernel object, the object
-	 * pointer is just a member of the containing struct dyn_obj,
-	 * so just a little arithmetic is necessary to locate the
-	 * corresponding struct rbnode
-	 */
-	node = dyn_obj_to_node(obj);
-
 	k_spinlock_key_t key = k_spin_lock(&lists_lock);
-	if (rb_contains(&obj_rb_tree, node)) {
-		ret = node_to_dyn_obj(node);
-	} else {
-		ret = NULL;
-	}
+	slot = obj_table_slot(obj);
+	ret = (slot != NULL) ? *slot : NULL;
 	k_spin_unlock(&lists_lock, key);
 
 	return ret;
@@ -321,8 +391,12 @@ struct z_object *z_dynamic_object_aligned_create(size_t align, size_t size)
 
 	k_spinlock_key_t key = k_spin_lock(&lists_lock);
 
-	rb_insert(&obj_rb_tree, &dyn->node);
-	sys_dlist_append(&obj_list, &dyn->dobj_list);
+	if (!obj_table_insert(dyn)) {
+		k_spin_unlock(&lists_lock, key);
+		k_free(dyn);
+		LOG_ERR("could not index kernel object, out of memory");
+		return NULL;
+	}
 	k_spin_unlock(&lists_lock, key);
 
 	return &dyn->kobj;
@@ -387,7 +461,8 @@ void *z_impl_k_object_alloc(enum k_objects otype)
 
 void k_object_free(void *obj)
 {
-	struct dyn_obj *dyn;
+	struct dyn_obj **slot;
+	struct dyn_obj *dyn = NULL;
 
 	/* This function is intentionally not exposed to user mode.
 	 * There's currently no robust way to track that an object isn't
@@ -395,15 +470,17 @@ void k_object_free(void *obj)
 	 */
 
 	k_spinlock_key_t key = k_spin_lock(&objfree_lock);
+	k_spinlock_key_t lists_key = k_spin_lock(&lists_lock);
 
-	dyn = dyn_object_find(obj);
-	if (dyn != NULL) {
-		rb_remove(&obj_rb_tree, &dyn->node);
-		sys_dlist_remove(&dyn->dobj_list);
+	slot = obj_table_slot(obj);
+	if (slot != NULL) {
+		dyn = *slot;
+		obj_table_remove(slot);
+	}
+	k_spin_unlock(&lists_lock, lists_key);
 
-		if (dyn->kobj.type == K_OBJ_THREAD) {
-			thread_idx_free(dyn->kobj.data.thread_id);
-		}
+	if ((dyn != NULL) && (dyn->kobj.type == K_OBJ_THREAD)) {
+		thread_idx_free(dyn->kobj.data.thread_id);
 	}
 	k_spin_unlock(&objfree_lock, key);
 
@@ -436,14 +513,20 @@ struct z_object *z_object_find(const void *obj)
 
 void z_object_wordlist_foreach(_wordlist_cb_func_t func, void *context)
 {
-	struct dyn_obj *obj, *next;
+	struct dyn_obj *obj;
 
 	z_object_gperf_wordlist_foreach(func, context);
 
 	k_spinlock_key_t key = k_spin_lock(&lists_lock);
 
-	SYS_DLIST_FOR_EACH_CONTAINER_SAFE(&obj_list, obj, next, dobj_list) {
-		func(&obj->kobj, context);
+	/* func may remove the object it is given, which only marks its
+	 * slot, the table isn't resized until the next insertion.
+	 */
+	for (size_t i = 0; i < obj_table.size; i++) {
+		obj = obj_table.slots[i];
+		if ((obj != NULL) && (obj != OBJ_TABLE_REMOVED)) {
+			func(&obj->kobj, context);
+		}
 	}
 	k_spin_unlock(&lists_lock, key);
 }
@@ -462,7 +545,11 @@ static unsigned int thread_index_get(struct k_thread *thread)
 	return ko->data.thread_id;
 }
 
-static void unref_check(struct z_object *ko, uintptr_t index)
+/* With CONFIG_DYNAMIC_OBJECTS the caller must hold lists_lock, as a
+ * released object is removed from the hash table, which a concurrent
+ * insertion could otherwise resize and free under us.
+ */
+static void unref_check_locked(struct z_object *ko, uintptr_t index)
 {
 	k_spinlock_key_t key = k_spin_lock(&obj_lock);
 
@@ -506,14 +593,28 @@ static void unref_check(struct z_object *ko, uintptr_t index)
 		break;
 	}
 
-	rb_remove(&obj_rb_tree, &dyn->node);
-	sys_dlist_remove(&dyn->dobj_list);
+	struct dyn_obj **slot = obj_table_slot(dyn->kobj.name);
+
+	__ASSERT_NO_MSG((slot != NULL) && (*slot == dyn));
+	obj_table_remove(slot);
 	k_free(dyn);
 out:
 #endif
 	k_spin_unlock(&obj_lock, key);
 }
 
+static void unref_check(struct z_object *ko, uintptr_t index)
+{
+#ifdef CONFIG_DYNAMIC_OBJECTS
+	k_spinlock_key_t key = k_spin_lock(&lists_lock);
+
+	unref_check_locked(ko, index);
+	k_spin_unlock(&lists_lock, key);
+#else
+	unref_check_locked(ko, index);
+#endif
+}
+
 static void wordlist_cb(struct z_object *ko, void *ctx_ptr)
 {
 	struct perm_ctx *ctx = (struct perm_ctx *)ctx_ptr;
@@ -560,7 +661,10 @@ static void clear_perms_cb(struct z_object *ko, void *ctx_ptr)
 {
 	uintptr_t id = (uintptr_t)ctx_ptr;
 
-	unref_check(ko, id);
+	/* Called from z_object_wordlist_foreach(), which holds lists_lock
+	 * for dynamic objects, static ones never touch the table.
+	 */
+	unref_check_locked(ko, id);
 }
 
 void z_thread_perms_all_clear(struct k_thread *thread)
@@ -236,7 +236,7 @@ static inline bool notify_queue_locked(struct k_work_q *queue)
  * thread (chained submission).
  *
  * Invoked with work lock held.
- * Conditionally notifies queue.
+ * Caller must notify queue of pending work.
  *
  * @param queue the queue to which work should be submitted.  This may
  * be null, in which case the submission will fail.
@@ -276,7 +276,6 @@ static inline int queue_submit_locked(struct k_work_q *queue,
 	} else {
 		sys_slist_append(&queue->pending, &work->node);
 		ret = 1;
-		(void)notify_queue_locked(queue);
 	}
 
 	return ret;
@@ -290,7 +289,7 @@ static inline int queue_submit_locked(struct k_work_q *queue,
  * * the candidate queue rejects the submission.
  *
  * Invoked with work lock held.
- * Conditionally notifies queue.
+ * Caller must notify the queue returned in @p queuep.
  *
  * @param work the work structure to be submitted
 
@@ -308,8 +307,8 @@ static inline int queue_submit_locked(struct k_work_q *queue,
  * @retval -EINVAL if no queue is provided
  * @retval -ENODEV if the queue is not started
  */
-static int submit_to_queue_locked(struct k_work *work,
-				  struct k_work_q **queuep)
+static int submit_to_queue_quiet_locked(struct k_work *work,
+					struct k_work_q **queuep)
 {
 	int ret = 0;
 
@@ -355,6 +354,25 @@ static int submit_to_queue_locked(struct k_work *work,
 	return ret;
 }
 
+/* Attempt to submit work to a queue and notify the queue.
+ *
+ * Invoked with work lock held.
+ * Conditionally notifies queue.
+ *
+ * See submit_to_queue_quiet_locked() for parameters and return values.
+ */
+static int submit_to_queue_locked(struct k_work *work,
+				  struct k_work_q **queuep)
+{
+	int ret = submit_to_queue_quiet_locked(work, queuep);
+
+	if (ret > 0) {
+		(void)notify_queue_locked(*queuep);
+	}
+
+	return ret;
+}
+
 int k_work_submit_to_queue(struct k_work_q *queue,
 			    struct k_work *work)
 {
@@ -393,6 +411,56 @@ int k_work_submit(struct k_work *work)
 	return ret;
 }
 
+int k_work_submit_batch_to_queue(struct k_work_q *queue,
+				 struct k_work **works,
+				 size_t count)
+{
+	__ASSERT_NO_MSG((works != NULL) || (count == 0U));
+
+	struct k_work_q *notify = NULL;
+	int submitted = 0;
+	int err = 0;
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	for (size_t i = 0; i < count; i++) {
+		struct k_work_q *target = queue;
+
+		__ASSERT_NO_MSG(works[i] != NULL);
+
+		int rc = submit_to_queue_quiet_locked(works[i], &target);
+
+		if (rc > 0) {
+			submitted += 1;
+
+			/* Wake each queue once per run of items, which is
+			 * once per batch unless items were diverted to the
+			 * queue they are running on.
+			 */
+			if (target != notify) {
+				(void)notify_queue_locked(notify);
+				notify = target;
+			}
+		} else if ((rc < 0) && (err == 0)) {
+			err = rc;
+		}
+	}
+
+	(void)notify_queue_locked(notify);
+
+	k_spin_unlock(&lock, key);
+
+	if (submitted > 0) {
+		z_reschedule_unlocked();
+	}
+
+	return (submitted > 0) ? submitted : err;
+}
+
+int k_work_submit_batch(struct k_work **works, size_t count)
+{
+	return k_work_submit_batch_to_queue(&k_sys_work_q, works, count);
+}
+
 /* Flush the work item if necessary.
  *
  * Flushing is necessary only if the work is either queued or running.
@@ -580,12 +648,12 @@ bool k_work_cancel_sync(struct k_work *work,
 static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 {
 	struct k_work_q *queue = (struct k_work_q *)workq_ptr;
+	k_spinlock_key_t key = k_spin_lock(&lock);
 
 	while (true) {
 		sys_snode_t *node;
 		struct k_work *work = NULL;
 		k_work_handler_t handler = NULL;
-		k_spinlock_key_t key = k_spin_lock(&lock);
 		bool yield;
 
 		/* Check for and prepare any new work. */
@@ -640,6 +708,7 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 
 			(void)z_sched_wait(&lock, key, &queue->notifyq,
 					   K_FOREVER, NULL);
+			key = k_spin_lock(&lock);
 			continue;
 		}
 
@@ -661,14 +730,19 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 		}
 
 		flag_clear(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
-		yield = !flag_test(&queue->flags, K_WORK_QUEUE_NO_YIELD_BIT);
-		k_spin_unlock(&lock, key);
 
-		/* Optionally yield to prevent the work queue from
-		 * starving other threads.
+		/* Yielding is only needed if there is more work: otherwise
+		 * the thread is about to sleep anyway.  Without a yield the
+		 * next item is taken under the same lock, so a backlog
+		 * costs one lock acquisition per item rather than two.
 		 */
+		yield = !flag_test(&queue->flags, K_WORK_QUEUE_NO_YIELD_BIT)
+			&& !sys_slist_is_empty(&queue->pending);
+
 		if (yield) {
+			k_spin_unlock(&lock, key);
 			k_yield();
+			key = k_spin_lock(&lock);
 		}
 	}
 }
@@ -34,6 +34,42 @@ K_APPMEM_PARTITION_DEFINE(z_malloc_partition);
 Z_GENERIC_SECTION(POOL_SECTION) static struct sys_heap z_malloc_heap;
 Z_GENERIC_SECTION(POOL_SECTION) struct sys_mutex z_malloc_heap_mutex;
 Z_GENERIC_SECTION(POOL_SECTION) static char z_malloc_heap_mem[HEAP_BYTES];
+#ifdef CONFIG_SYS_HEAP_CACHE
+/* Small blocks freed to the arena, protected by z_malloc_heap_mutex */
+Z_GENERIC_SECTION(POOL_SECTION) static struct sys_heap_cache z_malloc_cache;
+#endif
+
+/* z_malloc_heap_mutex held */
+static void *malloc_locked(size_t size)
+{
+	void *ret = NULL;
+
+#ifdef CONFIG_SYS_HEAP_CACHE
+	ret = sys_heap_cache_get(&z_malloc_cache, size);
+	if (ret == NULL) {
+		ret = sys_heap_cache_refill(&z_malloc_cache, &z_malloc_heap,
+					    size);
+	}
+	if (ret != NULL) {
+		return ret;
+	}
+#endif
+
+	ret = sys_heap_aligned_alloc(&z_malloc_heap,
+				     __alignof__(z_max_align_t),
+				     size);
+
+#ifdef CONFIG_SYS_HEAP_CACHE
+	if (ret == NULL && size != 0) {
+		sys_heap_cache_flush(&z_malloc_cache, &z_malloc_heap);
+		ret = sys_heap_aligned_alloc(&z_malloc_heap,
+					     __alignof__(z_max_align_t),
+					     size);
+	}
+#endif
+
+	return ret;
+}
 
 void *malloc(size_t size)
 {
@@ -42,9 +78,8 @@ void *malloc(size_t size)
 	lock_ret = sys_mutex_lock(&z_malloc_heap_mutex, K_FOREVER);
 	__ASSERT_NO_MSG(lock_ret == 0);
 
-	void *ret = sys_heap_aligned_alloc(&z_malloc_heap,
-					   __alignof__(z_max_align_t),
-					   size);
+	void *ret = malloc_locked(size);
+
 	if (ret == NULL && size != 0) {
 		errno = ENOMEM;
 	}
@@ -59,6 +94,9 @@ static int malloc_prepare(const struct device *unused)
 	ARG_UNUSED(unused);
 
 	sys_heap_init(&z_malloc_heap, z_malloc_heap_mem, HEAP_BYTES);
+#ifdef CONFIG_SYS_HEAP_CACHE
+	sys_heap_cache_init(&z_malloc_cache, __alignof__(z_max_align_t));
+#endif
 	sys_mutex_init(&z_malloc_heap_mutex);
 
 	return 0;
@@ -75,6 +113,15 @@ void *realloc(void *ptr, size_t requested_size)
 					     __alignof__(z_max_align_t),
 					     requested_size);
 
+#ifdef CONFIG_SYS_HEAP_CACHE
+	if (ret == NULL && requested_size != 0) {
+		sys_heap_cache_flush(&z_malloc_cache, &z_malloc_heap);
+		ret = sys_heap_aligned_realloc(&z_malloc_heap, ptr,
+					       __alignof__(z_max_align_t),
+					       requested_size);
+	}
+#endif
+
 	if (ret == NULL && requested_size != 0) {
 		errno = ENOMEM;
 	}
@@ -90,7 +137,14 @@ void free(void *ptr)
 
 	lock_ret = sys_mutex_lock(&z_malloc_heap_mutex, K_FOREVER);
 	__ASSERT_NO_MSG(lock_ret == 0);
+#ifdef CONFIG_SYS_HEAP_CACHE
+	if (ptr != NULL &&
+	    !sys_heap_cache_put(&z_malloc_cache, &z_malloc_heap, ptr)) {
+		sys_heap_cache_trim(&z_malloc_cache, &z_malloc_heap, ptr);
+	}
+#else
 	sys_heap_free(&z_malloc_heap, ptr);
+#endif
 	(void) sys_mutex_unlock(&z_malloc_heap_mutex);
 }
 
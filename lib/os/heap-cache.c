@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <zephyr/sys/sys_heap.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/kernel.h>
+
+#define CACHE_DEPTH	CONFIG_SYS_HEAP_CACHE_DEPTH
+#define CACHE_BATCH	(CONFIG_SYS_HEAP_CACHE_DEPTH / 2)
+
+/* Classes are spaced at most 1.5x apart, which bounds the internal
+ * waste of rounding a request up to its class.
+ */
+static const uint16_t class_bytes[SYS_HEAP_CACHE_CLASSES] = {
+	16, 32, 48, 64, 96, 128, 192, 256
+};
+
+#define MAX_CLASS_BYTES	class_bytes[SYS_HEAP_CACHE_CLASSES - 1]
+
+/* Smallest class fitting a request, or -1 */
+static int request_class(size_t bytes)
+{
+	int i;
+
+	if (bytes == 0U || bytes > MAX_CLASS_BYTES) {
+		return -1;
+	}
+
+	for (i = 0; class_bytes[i] < bytes; i++) {
+	}
+
+	return i;
+}
+
+/* Largest class a block can serve, or -1.  Only reads the block's own
+ * chunk header, so the heap lock isn't needed.  Blocks too big for
+ * the top class aren't cached, to not pin large chunks.
+ */
+static int block_class(struct sys_heap_cache *cache, struct sys_heap *heap,
+		       void *mem)
+{
+	size_t usable;
+	int i;
+
+	if ((mem == NULL) || (((uintptr_t)mem & (cache->align - 1)) != 0U)) {
+		return -1;
+	}
+
+	usable = sys_heap_usable_size(heap, mem);
+	if (usable < class_bytes[0] ||
+	    usable >= MAX_CLASS_BYTES + MAX_CLASS_BYTES / 2U) {
+		return -1;
+	}
+
+	for (i = SYS_HEAP_CACHE_CLASSES - 1; class_bytes[i] > usable; i--) {
+	}
+
+	return i;
+}
+
+static void bin_push(struct sys_heap_cache *cache, int cls, void *mem)
+{
+	*(void **)mem = cache->bins[cls];
+	cache->bins[cls] = mem;
+	cache->count[cls]++;
+}
+
+static void *bin_pop(struct sys_heap_cache *cache, int cls)
+{
+	void *mem = cache->bins[cls];
+
+	if (mem != NULL) {
+		cache->bins[cls] = *(void **)mem;
+		cache->count[cls]--;
+	}
+
+	return mem;
+}
+
+static void bin_release(struct sys_heap_cache *cache, struct sys_heap *heap,
+			int cls, int n)
+{
+	while (n-- > 0) {
+		void *mem = bin_pop(cache, cls);
+
+		if (mem == NULL) {
+			break;
+		}
+		sys_heap_free(heap, mem);
+	}
+}
+
+void sys_heap_cache_init(struct sys_heap_cache *cache, size_t align)
+{
+	__ASSERT((align & (align - 1)) == 0, "align must be a power of 2");
+
+	*cache = (struct sys_heap_cache) {
+		.align = MAX(align, sizeof(void *)),
+	};
+}
+
+void *sys_heap_cache_get(struct sys_heap_cache *cache, size_t bytes)
+{
+	int cls = request_class(bytes);
+	void *mem;
+
+	if (cls < 0) {
+		return NULL;
+	}
+
+	mem = bin_pop(cache, cls);
+	if (mem != NULL) {
+		cache->hits++;
+	} else {
+		cache->misses++;
+	}
+
+	return mem;
+}
+
+bool sys_heap_cache_put(struct sys_heap_cache *cache, struct sys_heap *heap,
+			void *mem)
+{
+	int cls = block_class(cache, heap, mem);
+
+	if (cls < 0 || cache->count[cls] >= CACHE_DEPTH) {
+		return false;
+	}
+
+	bin_push(cache, cls, mem);
+
+	return true;
+}
+
+void *sys_heap_cache_refill(struct sys_heap_cache *cache,
+			    struct sys_heap *heap, size_t bytes)
+{
+	int cls = request_class(bytes);
+	void *ret;
+
+	if (cls < 0) {
+		return NULL;
+	}
+
+	ret = sys_heap_aligned_alloc(heap, cache->align, class_bytes[cls]);
+
+	for (int n = 0; (ret != NULL) && (n < CACHE_BATCH) &&
+	     (cache->count[cls] < CACHE_DEPTH); n++) {
+		void *mem = sys_heap_aligned_alloc(heap, cache->align,
+						   class_bytes[cls]);
+
+		if (mem == NULL) {
+			break;
+		}
+		bin_push(cache, cls, mem);
+	}
+
+	return ret;
+}
+
+void sys_heap_cache_trim(struct sys_heap_cache *cache, struct sys_heap *heap,
+			 void *mem)
+{
+	int cls = block_class(cache, heap, mem);
+
+	if (cls >= 0 && cache->count[cls] >= CACHE_DEPTH) {
+		bin_release(cache, heap, cls, CACHE_BATCH);
+	}
+
+	sys_heap_free(heap, mem);
+}
+
+void sys_heap_cache_flush(struct sys_heap_cache *cache, struct sys_heap *heap)
+{
+	for (int cls = 0; cls < SYS_HEAP_CACHE_CLASSES; cls++) {
+		bin_release(cache, heap, cls, CACHE_DEPTH);
+	}
+}
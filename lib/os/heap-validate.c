@@ -48,15 +48,15 @@ static bool valid_chunk(struct z_heap *h, chunkid_t c)
 	return true;
 }
 
-/* Validate multiple state dimensions for the bucket "next" pointer
+/* Validate multiple state dimensions for the free list "next" pointer
  * and see that they match.  Probably should unify the design a
  * bit...
  */
-static inline void check_nexts(struct z_heap *h, int bidx)
+static inline void check_nexts(struct z_heap *h, int lidx)
 {
-	struct z_heap_bucket *b = &h->buckets[bidx];
+	struct z_heap_bucket *b = &h->buckets[lidx];
 
-	bool emptybit = (h->avail_buckets & BIT(bidx)) == 0;
+	bool emptybit = !free_list_avail(h, lidx);
 	bool emptylist = b->next == 0;
 	bool empties_match = emptybit == emptylist;
 
@@ -124,7 +124,7 @@ bool sys_heap_validate(struct sys_heap *heap)
 	 * should be correct, and all chunk entries should point into
 	 * valid unused chunks.  Mark those chunks USED, temporarily.
 	 */
-	for (int b = 0; b <= bucket_idx(h, h->end_chunk); b++) {
+	for (int b = 0; b < nb_free_lists(h); b++) {
 		chunkid_t c0 = h->buckets[b].next;
 		uint32_t n = 0;
 
@@ -135,10 +135,14 @@ bool sys_heap_validate(struct sys_heap *heap)
 			if (!valid_chunk(h, c)) {
 				return false;
 			}
+			/* Chunks must be filed in the list for their size */
+			if (free_list_idx(h, chunk_size(h, c)) != b) {
+				return false;
+			}
 			set_chunk_used(h, c, true);
 		}
 
-		bool empty = (h->avail_buckets & BIT(b)) == 0;
+		bool empty = !free_list_avail(h, b);
 		bool zero = n == 0;
 
 		if (empty != zero) {
@@ -150,6 +154,19 @@ bool sys_heap_validate(struct sys_heap *heap)
 		}
 	}
 
+	/* A bucket is marked non-empty iff one of its lists is */
+	for (int b = 0; b <= bucket_idx(h, h->end_chunk); b++) {
+		bool avail = false;
+
+		for (int l = b * SL_COUNT; l < (b + 1) * SL_COUNT; l++) {
+			avail = avail || free_list_avail(h, l);
+		}
+
+		if (avail != ((h->avail_buckets & BIT(b)) != 0U)) {
+			return false;
+		}
+	}
+
 	/*
 	 * Walk through the chunks linearly again, verifying that all chunks
 	 * but solo headers are now USED (i.e. all free blocks were found
@@ -176,7 +193,7 @@ bool sys_heap_validate(struct sys_heap *heap)
 	 * pass caught all the blocks and that they now show UNUSED.
 	 * Mark them USED.
 	 */
-	for (int b = 0; b <= bucket_idx(h, h->end_chunk); b++) {
+	for (int b = 0; b < nb_free_lists(h); b++) {
 		chunkid_t c0 = h->buckets[b].next;
 		int n = 0;
 
@@ -351,6 +368,7 @@ void sys_heap_stress(void *(*alloc_fn)(void *arg, size_t bytes),
 void heap_print_info(struct z_heap *h, bool dump_chunks)
 {
 	int i, nb_buckets = bucket_idx(h, h->end_chunk) + 1;
+	int nb_lists = nb_free_lists(h);
 	size_t free_bytes, allocated_bytes, total, overhead;
 
 	printk("Heap at %p contains %d units in %d buckets\n\n",
@@ -359,7 +377,7 @@ void heap_print_info(struct z_heap *h, bool dump_chunks)
 	printk("  bucket#    min units        total      largest      largest\n"
 	       "             threshold       chunks      (units)      (bytes)\n"
 	       "  -----------------------------------------------------------\n");
-	for (i = 0; i < nb_buckets; i++) {
+	for (i = 0; i < nb_lists; i++) {
 		chunkid_t first = h->buckets[i].next;
 		chunksz_t largest = 0;
 		int count = 0;
@@ -372,7 +390,12 @@ void heap_print_info(struct z_heap *h, bool dump_chunks)
 				curr = next_free_chunk(h, curr);
 			} while (curr != first);
 		}
-		if (count) {
+		if (count && SL_COUNT > 1U) {
+			printk("%6d.%-2d %12d %12d %12d %12zd\n",
+			       i / SL_COUNT, i % SL_COUNT,
+			       free_list_min_size(h, i), count,
+			       largest, chunksz_to_bytes(h, largest));
+		} else if (count) {
 			printk("%9d %12d %12d %12d %12zd\n",
 			       i, (1 << i) - 1 + min_chunk_size(h), count,
 			       largest, chunksz_to_bytes(h, largest));
@@ -28,17 +28,40 @@ static void *chunk_mem(struct z_heap *h, chunkid_t c)
 	return ret;
 }
 
-static void free_list_remove_bidx(struct z_heap *h, chunkid_t c, int bidx)
+static void set_free_list_avail(struct z_heap *h, int lidx, bool avail)
 {
-	struct z_heap_bucket *b = &h->buckets[bidx];
+#ifdef CONFIG_SYS_HEAP_TLSF
+	int bidx = lidx / SL_COUNT;
+
+	if (avail) {
+		h->avail_lists[bidx] |= BIT(lidx % SL_COUNT);
+		h->avail_buckets |= BIT(bidx);
+	} else {
+		h->avail_lists[bidx] &= ~BIT(lidx % SL_COUNT);
+		if (h->avail_lists[bidx] == 0U) {
+			h->avail_buckets &= ~BIT(bidx);
+		}
+	}
+#else
+	if (avail) {
+		h->avail_buckets |= BIT(lidx);
+	} else {
+		h->avail_buckets &= ~BIT(lidx);
+	}
+#endif
+}
+
+static void free_list_remove_lidx(struct z_heap *h, chunkid_t c, int lidx)
+{
+	struct z_heap_bucket *b = &h->buckets[lidx];
 
 	CHECK(!chunk_used(h, c));
 	CHECK(b->next != 0);
-	CHECK(h->avail_buckets & BIT(bidx));
+	CHECK(free_list_avail(h, lidx));
 
 	if (next_free_chunk(h, c) == c) {
 		/* this is the last chunk */
-		h->avail_buckets &= ~BIT(bidx);
+		set_free_list_avail(h, lidx, false);
 		b->next = 0;
 	} else {
 		chunkid_t first = prev_free_chunk(h, c),
@@ -57,25 +80,25 @@ static void free_list_remove_bidx(struct z_heap *h, chunkid_t c, int bidx)
 static void free_list_remove(struct z_heap *h, chunkid_t c)
 {
 	if (!solo_free_header(h, c)) {
-		int bidx = bucket_idx(h, chunk_size(h, c));
-		free_list_remove_bidx(h, c, bidx);
+		int lidx = free_list_idx(h, chunk_size(h, c));
+		free_list_remove_lidx(h, c, lidx);
 	}
 }
 
-static void free_list_add_bidx(struct z_heap *h, chunkid_t c, int bidx)
+static void free_list_add_lidx(struct z_heap *h, chunkid_t c, int lidx)
 {
-	struct z_heap_bucket *b = &h->buckets[bidx];
+	struct z_heap_bucket *b = &h->buckets[lidx];
 
 	if (b->next == 0U) {
-		CHECK((h->avail_buckets & BIT(bidx)) == 0);
+		CHECK(!free_list_avail(h, lidx));
 
 		/* Empty list, first item */
-		h->avail_buckets |= BIT(bidx);
+		set_free_list_avail(h, lidx, true);
 		b->next = c;
 		set_prev_free_chunk(h, c, c);
 		set_next_free_chunk(h, c, c);
 	} else {
-		CHECK(h->avail_buckets & BIT(bidx));
+		CHECK(free_list_avail(h, lidx));
 
 		/* Insert before (!) the "next" pointer */
 		chunkid_t second = b->next;
@@ -95,8 +118,8 @@ static void free_list_add_bidx(struct z_heap *h, chunkid_t c, int bidx)
 static void free_list_add(struct z_heap *h, chunkid_t c)
 {
 	if (!solo_free_header(h, c)) {
-		int bidx = bucket_idx(h, chunk_size(h, c));
-		free_list_add_bidx(h, c, bidx);
+		int lidx = free_list_idx(h, chunk_size(h, c));
+		free_list_add_lidx(h, c, lidx);
 	}
 }
 
@@ -205,6 +228,58 @@ size_t sys_heap_usable_size(struct sys_heap *heap, void *mem)
 	return chunk_sz - (addr - chunk_base);
 }
 
+#ifdef CONFIG_SYS_HEAP_TLSF
+/* Two-level segregated fit.  The head of the list that sz maps to
+ * gets one look, as that list also holds chunks slightly smaller than
+ * sz.  Otherwise every chunk in a higher list fits, and the lowest
+ * non-empty one is found with two bit scans, so allocation is O(1)
+ * and returns the smallest chunk class that fits.
+ */
+static chunkid_t alloc_chunk(struct z_heap *h, chunksz_t sz)
+{
+	int li = free_list_idx(h, sz);
+	struct z_heap_bucket *b = &h->buckets[li];
+
+	if (li >= nb_free_lists(h)) {
+		return 0;
+	}
+
+	if (b->next != 0U && chunk_size(h, b->next) >= sz) {
+		chunkid_t c = b->next;
+
+		free_list_remove_lidx(h, c, li);
+		return c;
+	}
+
+	li++;
+
+	int bi = li / SL_COUNT;
+	uint32_t slmask;
+
+	if (li >= nb_free_lists(h)) {
+		return 0;
+	}
+
+	slmask = h->avail_lists[bi] & ~BIT_MASK(li % SL_COUNT);
+	if (slmask == 0U) {
+		uint32_t bmask = h->avail_buckets & ~BIT_MASK(bi + 1);
+
+		if (bmask == 0U) {
+			return 0;
+		}
+		bi = __builtin_ctz(bmask);
+		slmask = h->avail_lists[bi];
+	}
+
+	li = bi * SL_COUNT + __builtin_ctz(slmask);
+
+	chunkid_t c = h->buckets[li].next;
+
+	free_list_remove_lidx(h, c, li);
+	CHECK(chunk_size(h, c) >= sz);
+	return c;
+}
+#else
 static chunkid_t alloc_chunk(struct z_heap *h, chunksz_t sz)
 {
 	int bi = bucket_idx(h, sz);
@@ -232,7 +307,7 @@ static chunkid_t alloc_chunk(struct z_heap *h, chunksz_t sz)
 		do {
 			chunkid_t c = b->next;
 			if (chunk_size(h, c) >= sz) {
-				free_list_remove_bidx(h, c, bi);
+				free_list_remove_lidx(h, c, bi);
 				return c;
 			}
 			b->next = next_free_chunk(h, c);
@@ -249,13 +324,14 @@ static chunkid_t alloc_chunk(struct z_heap *h, chunksz_t sz)
 		int minbucket = __builtin_ctz(bmask);
 		chunkid_t c = h->buckets[minbucket].next;
 
-		free_list_remove_bidx(h, c, minbucket);
+		free_list_remove_lidx(h, c, minbucket);
 		CHECK(chunk_size(h, c) >= sz);
 		return c;
 	}
 
 	return 0;
 }
+#endif /* CONFIG_SYS_HEAP_TLSF */
 
 void *sys_heap_alloc(struct sys_heap *heap, size_t bytes)
 {
@@ -509,13 +585,19 @@ void sys_heap_init(struct sys_heap *heap, void *mem, size_t bytes)
 	h->max_allocated_bytes = 0;
 #endif
 
-	int nb_buckets = bucket_idx(h, heap_sz) + 1;
+#ifdef CONFIG_SYS_HEAP_TLSF
+	for (int i = 0; i < MAX_BUCKETS; i++) {
+		h->avail_lists[i] = 0;
+	}
+#endif
+
+	int nb_lists = nb_free_lists(h);
 	chunksz_t chunk0_size = chunksz(sizeof(struct z_heap) +
-				     nb_buckets * sizeof(struct z_heap_bucket));
+				     nb_lists * sizeof(struct z_heap_bucket));
 
 	__ASSERT(chunk0_size + min_chunk_size(h) <= heap_sz, "heap size is too small");
 
-	for (int i = 0; i < nb_buckets; i++) {
+	for (int i = 0; i < nb_lists; i++) {
 		h->buckets[i].next = 0;
 	}
 
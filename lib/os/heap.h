@@ -41,9 +41,11 @@
  *   FREE_NEXT: Chunk ID of the next node in a free list.
  *
  * The free lists are circular lists, one for each power-of-two size
- * category.  The free list pointers exist only for free chunks,
- * obviously.  This memory is part of the user's buffer when
- * allocated.
+ * category ("bucket").  With CONFIG_SYS_HEAP_TLSF each bucket is
+ * further split into 2^SL_BITS lists of equal size ranges (a Two-Level
+ * Segregated Fit arrangement).  The free list pointers exist only for
+ * free chunks, obviously.  This memory is part of the user's buffer
+ * when allocated.
  *
  * The field order is so that allocated buffers are immediately bounded
  * by SIZE_AND_USED of the current chunk at the bottom, and LEFT_SIZE of
@@ -61,6 +63,18 @@ typedef struct { char bytes[CHUNK_UNIT]; } chunk_unit_t;
 typedef uint32_t chunkid_t;
 typedef uint32_t chunksz_t;
 
+#ifdef CONFIG_SYS_HEAP_TLSF
+#define SL_BITS CONFIG_SYS_HEAP_TLSF_SL_BITS
+#else
+#define SL_BITS 0
+#endif
+
+/* Number of free lists per bucket */
+#define SL_COUNT (1U << SL_BITS)
+
+/* A heap has at most one bucket per bit of a chunk size */
+#define MAX_BUCKETS 32
+
 struct z_heap_bucket {
 	chunkid_t next;
 };
@@ -69,6 +83,10 @@ struct z_heap {
 	chunkid_t chunk0_hdr[2];
 	chunkid_t end_chunk;
 	uint32_t avail_buckets;
+#ifdef CONFIG_SYS_HEAP_TLSF
+	/* Non-empty lists within each bucket */
+	uint16_t avail_lists[MAX_BUCKETS];
+#endif
 #ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
 	size_t free_bytes;
 	size_t allocated_bytes;
@@ -253,6 +271,55 @@ static inline int bucket_idx(struct z_heap *h, chunksz_t sz)
 	return 31 - __builtin_clz(usable_sz);
 }
 
+/* Index of the free list for a chunk size.  A bucket's lists split
+ * its range evenly.  The lists of buckets narrower than SL_COUNT sizes
+ * each hold a single size, some of them stay unused.
+ */
+static inline int free_list_idx(struct z_heap *h, chunksz_t sz)
+{
+	unsigned int usable_sz = sz - min_chunk_size(h) + 1;
+	int bidx = 31 - __builtin_clz(usable_sz);
+	unsigned int sl;
+
+	if (bidx >= SL_BITS) {
+		sl = usable_sz >> (bidx - SL_BITS);
+	} else {
+		sl = usable_sz << (SL_BITS - bidx);
+	}
+
+	return bidx * SL_COUNT + (sl & (SL_COUNT - 1U));
+}
+
+/* Smallest chunk size filed in a free list */
+static inline chunksz_t free_list_min_size(struct z_heap *h, int lidx)
+{
+	int bidx = lidx / SL_COUNT;
+	unsigned int sl = lidx % SL_COUNT;
+	unsigned int usable_sz;
+
+	if (bidx >= SL_BITS) {
+		usable_sz = (1U << bidx) + (sl << (bidx - SL_BITS));
+	} else {
+		usable_sz = (1U << bidx) + (sl >> (SL_BITS - bidx));
+	}
+
+	return usable_sz - 1 + min_chunk_size(h);
+}
+
+static inline int nb_free_lists(struct z_heap *h)
+{
+	return (bucket_idx(h, h->end_chunk) + 1) * SL_COUNT;
+}
+
+static inline bool free_list_avail(struct z_heap *h, int lidx)
+{
+#ifdef CONFIG_SYS_HEAP_TLSF
+	return (h->avail_lists[lidx / SL_COUNT] & BIT(lidx % SL_COUNT)) != 0U;
+#else
+	return (h->avail_buckets & BIT(lidx)) != 0U;
+#endif
+}
+
 static inline bool size_too_big(struct z_heap *h, size_t bytes)
 {
 	/*
@@ -0,0 +1,460 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <zephyr/sys/wsq.h>
+#include <zephyr/kernel.h>
+
+/* Internal flag: a struct k_wsq_sync may be waiting on the item */
+#define WORK_WAITED	BIT(3)
+
+#define WORK_BUSY_MASK	(K_WSQ_WORK_QUEUED | K_WSQ_WORK_RUNNING | \
+			 K_WSQ_WORK_CANCELING)
+
+/* An item's state is protected by the lock of the worker in
+ * work->worker.  That pointer only changes with both the old and the
+ * new worker locked, so it is stable once the lock it names is held.
+ * Locks are nested in address order to avoid deadlock, and the queue
+ * lock nests inside worker locks.
+ */
+static k_spinlock_key_t lock_pair(struct k_wsq_worker *a,
+				  struct k_wsq_worker *b)
+{
+	k_spinlock_key_t key;
+
+	if ((b == NULL) || (b == a)) {
+		return k_spin_lock(&a->lock);
+	}
+
+	if ((uintptr_t)b < (uintptr_t)a) {
+		struct k_wsq_worker *tmp = a;
+
+		a = b;
+		b = tmp;
+	}
+
+	key = k_spin_lock(&a->lock);
+	(void)k_spin_lock(&b->lock);
+
+	return key;
+}
+
+static void unlock_pair(struct k_wsq_worker *a, struct k_wsq_worker *b,
+			k_spinlock_key_t key)
+{
+	if ((b != NULL) && (b != a)) {
+		k_spin_release(&b->lock);
+	}
+	k_spin_unlock(&a->lock, key);
+}
+
+/* Locks the worker guarding @p work, plus @p also if not NULL.
+ * Returns the guarding worker.
+ */
+static struct k_wsq_worker *work_lock(struct k_wsq_work *work,
+				      struct k_wsq_worker *also,
+				      k_spinlock_key_t *key)
+{
+	while (true) {
+		struct k_wsq_worker *guard = work->worker;
+
+		*key = lock_pair(guard, also);
+		if (work->worker == guard) {
+			return guard;
+		}
+		unlock_pair(guard, also, *key);
+	}
+}
+
+static struct k_wsq_worker *current_worker(struct k_wsq *queue)
+{
+	struct k_wsq_worker *w = CONTAINER_OF(k_current_get(),
+					      struct k_wsq_worker, thread);
+	uintptr_t first = (uintptr_t)&queue->workers[0];
+	uintptr_t last = (uintptr_t)&queue->workers[queue->num_workers - 1];
+
+	if (k_is_in_isr() || ((uintptr_t)w < first) || ((uintptr_t)w > last)) {
+		return NULL;
+	}
+
+	return w;
+}
+
+/* Wakes the flush and cancel_sync callers waiting on @p work whose
+ * target has been reached, and lowers targets that can no longer be
+ * reached because a queued instance was canceled.  Guarding worker
+ * lock held.
+ */
+static void settle_waiters_locked(struct k_wsq *queue, struct k_wsq_work *work)
+{
+	uint32_t reach = work->completions +
+		(((work->flags & K_WSQ_WORK_QUEUED) != 0U) ? 1U : 0U) +
+		(((work->flags & K_WSQ_WORK_RUNNING) != 0U) ? 1U : 0U);
+	struct k_wsq_sync *sync, *tmp;
+	sys_snode_t *prev = NULL;
+	bool waited = false;
+
+	(void)k_spin_lock(&queue->lock);
+
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&queue->waiters, sync, tmp, node) {
+		if (sync->work != work) {
+			prev = &sync->node;
+			continue;
+		}
+
+		if ((int32_t)(sync->target - reach) > 0) {
+			sync->target = reach;
+		}
+
+		if ((int32_t)(work->completions - sync->target) >= 0) {
+			sys_slist_remove(&queue->waiters, prev, &sync->node);
+			k_sem_give(&sync->sem);
+		} else {
+			prev = &sync->node;
+			waited = true;
+		}
+	}
+
+	if (!waited) {
+		work->flags &= ~WORK_WAITED;
+	}
+
+	k_spin_release(&queue->lock);
+}
+
+/* Guarding worker lock held */
+static void add_waiter_locked(struct k_wsq *queue, struct k_wsq_work *work,
+			      struct k_wsq_sync *sync, uint32_t completions)
+{
+	k_sem_init(&sync->sem, 0, 1);
+	sync->work = work;
+	sync->target = work->completions + completions;
+	work->flags |= WORK_WAITED;
+
+	(void)k_spin_lock(&queue->lock);
+	sys_slist_append(&queue->waiters, &sync->node);
+	k_spin_release(&queue->lock);
+}
+
+static struct k_wsq_work *take_locked(struct k_wsq_worker *self,
+				      sys_dnode_t *node)
+{
+	struct k_wsq_work *work = CONTAINER_OF(node, struct k_wsq_work, node);
+
+	sys_dlist_remove(node);
+	work->flags &= ~K_WSQ_WORK_QUEUED;
+	work->flags |= K_WSQ_WORK_RUNNING;
+	work->worker = self;
+
+	return work;
+}
+
+/* Newest item from the worker's own deque */
+static struct k_wsq_work *take_local(struct k_wsq_worker *self)
+{
+	struct k_wsq_work *work = NULL;
+	k_spinlock_key_t key = k_spin_lock(&self->lock);
+	sys_dnode_t *node = sys_dlist_peek_tail(&self->deque);
+
+	if (node != NULL) {
+		work = take_locked(self, node);
+	}
+
+	k_spin_unlock(&self->lock, key);
+
+	return work;
+}
+
+/* Oldest item from another worker's deque.  Items that are queued
+ * again while running stay with the worker running them.
+ */
+static struct k_wsq_work *steal(struct k_wsq_worker *self)
+{
+	struct k_wsq *queue = self->queue;
+	uint32_t n = queue->num_workers;
+	uint32_t start = (uint32_t)(self - queue->workers);
+
+	for (uint32_t i = 1; i < n; i++) {
+		struct k_wsq_worker *victim = &queue->workers[(start + i) % n];
+		struct k_wsq_work *work = NULL;
+		k_spinlock_key_t key;
+		sys_dnode_t *node;
+
+		/* Unlocked peek, just to skip idle workers cheaply */
+		if (sys_dlist_is_empty(&victim->deque)) {
+			continue;
+		}
+
+		key = lock_pair(self, victim);
+
+		SYS_DLIST_FOR_EACH_NODE(&victim->deque, node) {
+			struct k_wsq_work *w = CONTAINER_OF(node,
+							    struct k_wsq_work,
+							    node);
+
+			if ((w->flags & K_WSQ_WORK_RUNNING) == 0U) {
+				work = take_locked(self, node);
+				break;
+			}
+		}
+
+		unlock_pair(self, victim, key);
+
+		if (work != NULL) {
+			return work;
+		}
+	}
+
+	return NULL;
+}
+
+static struct k_wsq_work *find_work(struct k_wsq_worker *self)
+{
+	struct k_wsq_work *work = take_local(self);
+
+	if (work == NULL) {
+		work = steal(self);
+	}
+
+	return work;
+}
+
+static void wsq_thread(void *p0, void *p1, void *p2)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	struct k_wsq_worker *self = p0;
+	struct k_wsq *queue = self->queue;
+
+	while (true) {
+		struct k_wsq_work *work = find_work(self);
+		k_spinlock_key_t key;
+
+		if (work == NULL) {
+			/* Announce ourselves before the final look, so a
+			 * submitter either sees us or we see its item.
+			 */
+			(void)atomic_inc(&queue->idle);
+			work = find_work(self);
+			if (work == NULL) {
+				(void)k_sem_take(&queue->idle_sem, K_FOREVER);
+			}
+			(void)atomic_dec(&queue->idle);
+			if (work == NULL) {
+				continue;
+			}
+		}
+
+		work->handler(work);
+
+		key = k_spin_lock(&self->lock);
+		__ASSERT_NO_MSG(work->worker == self);
+		work->flags &= ~(K_WSQ_WORK_RUNNING | K_WSQ_WORK_CANCELING);
+		work->completions++;
+		if ((work->flags & WORK_WAITED) != 0U) {
+			settle_waiters_locked(queue, work);
+		}
+		k_spin_unlock(&self->lock, key);
+	}
+}
+
+void k_wsq_start(struct k_wsq *queue, int prio)
+{
+	uintptr_t ssz = K_THREAD_STACK_LEN(queue->stack_size);
+
+	__ASSERT_NO_MSG(queue->num_workers > 0U);
+
+	queue->lock = (struct k_spinlock) {};
+	sys_slist_init(&queue->waiters);
+	(void)atomic_set(&queue->next, 0);
+	(void)atomic_set(&queue->idle, 0);
+	k_sem_init(&queue->idle_sem, 0, queue->num_workers);
+
+	for (uint32_t i = 0; i < queue->num_workers; i++) {
+		struct k_wsq_worker *w = &queue->workers[i];
+
+		w->lock = (struct k_spinlock) {};
+		sys_dlist_init(&w->deque);
+		w->queue = queue;
+	}
+
+	for (uint32_t i = 0; i < queue->num_workers; i++) {
+		struct k_wsq_worker *w = &queue->workers[i];
+
+		k_thread_create(&w->thread,
+				(k_thread_stack_t *)&queue->stacks[ssz * i],
+				queue->stack_size, wsq_thread, w, NULL, NULL,
+				prio, 0, K_NO_WAIT);
+	}
+}
+
+void k_wsq_work_init(struct k_wsq_work *work, k_wsq_handler_t handler)
+{
+	__ASSERT_NO_MSG(handler != NULL);
+
+	*work = (struct k_wsq_work) {
+		.handler = handler,
+	};
+}
+
+int k_wsq_work_busy_get(struct k_wsq_work *work)
+{
+	struct k_wsq_worker *guard;
+	k_spinlock_key_t key;
+	int ret;
+
+	if (work->worker == NULL) {
+		return 0;
+	}
+
+	guard = work_lock(work, NULL, &key);
+	ret = work->flags & WORK_BUSY_MASK;
+	unlock_pair(guard, NULL, key);
+
+	return ret;
+}
+
+int k_wsq_submit(struct k_wsq *queue, struct k_wsq_work *work)
+{
+	struct k_wsq_worker *self = current_worker(queue);
+	struct k_wsq_worker *guard;
+	k_spinlock_key_t key;
+	int ret;
+
+	if (work->worker == NULL) {
+		/* First submission: pick a home for the item */
+		key = k_spin_lock(&queue->lock);
+		if (work->worker == NULL) {
+			work->worker = (self != NULL) ? self :
+				&queue->workers[(uint32_t)atomic_inc(&queue->next) %
+						queue->num_workers];
+		}
+		k_spin_unlock(&queue->lock, key);
+	}
+
+	__ASSERT(work->worker->queue == queue, "work submitted to another queue");
+
+	guard = work_lock(work, self, &key);
+
+	if ((work->flags & K_WSQ_WORK_CANCELING) != 0U) {
+		ret = -EBUSY;
+	} else if ((work->flags & K_WSQ_WORK_QUEUED) != 0U) {
+		ret = 0;
+	} else if ((work->flags & K_WSQ_WORK_RUNNING) != 0U) {
+		/* Stays with the worker running it */
+		sys_dlist_append(&guard->deque, &work->node);
+		work->flags |= K_WSQ_WORK_QUEUED;
+		ret = 2;
+	} else {
+		struct k_wsq_worker *target = (self != NULL) ? self : guard;
+
+		work->worker = target;
+		sys_dlist_append(&target->deque, &work->node);
+		work->flags |= K_WSQ_WORK_QUEUED;
+		ret = 1;
+	}
+
+	unlock_pair(guard, self, key);
+
+	if ((ret > 0) && (atomic_get(&queue->idle) > 0)) {
+		k_sem_give(&queue->idle_sem);
+	}
+
+	return ret;
+}
+
+/* Guarding worker lock held */
+static int cancel_locked(struct k_wsq_work *work)
+{
+	if (((work->flags & K_WSQ_WORK_CANCELING) == 0U) &&
+	    ((work->flags & K_WSQ_WORK_QUEUED) != 0U)) {
+		sys_dlist_remove(&work->node);
+		work->flags &= ~K_WSQ_WORK_QUEUED;
+		if ((work->flags & WORK_WAITED) != 0U) {
+			settle_waiters_locked(work->worker->queue, work);
+		}
+	}
+
+	if ((work->flags & WORK_BUSY_MASK) != 0U) {
+		work->flags |= K_WSQ_WORK_CANCELING;
+	}
+
+	return work->flags & WORK_BUSY_MASK;
+}
+
+int k_wsq_cancel(struct k_wsq_work *work)
+{
+	struct k_wsq_worker *guard;
+	k_spinlock_key_t key;
+	int ret;
+
+	if (work->worker == NULL) {
+		return 0;
+	}
+
+	guard = work_lock(work, NULL, &key);
+	ret = cancel_locked(work);
+	unlock_pair(guard, NULL, key);
+
+	return ret;
+}
+
+bool k_wsq_cancel_sync(struct k_wsq_work *work, struct k_wsq_sync *sync)
+{
+	struct k_wsq_worker *guard;
+	k_spinlock_key_t key;
+	bool pending, need_wait;
+
+	__ASSERT_NO_MSG(!k_is_in_isr());
+
+	if (work->worker == NULL) {
+		return false;
+	}
+
+	guard = work_lock(work, NULL, &key);
+	pending = (work->flags & WORK_BUSY_MASK) != 0U;
+	need_wait = pending && (cancel_locked(work) != 0);
+	if (need_wait) {
+		/* Only the running instance is left */
+		add_waiter_locked(guard->queue, work, sync, 1U);
+	}
+	unlock_pair(guard, NULL, key);
+
+	if (need_wait) {
+		(void)k_sem_take(&sync->sem, K_FOREVER);
+	}
+
+	return pending;
+}
+
+bool k_wsq_flush(struct k_wsq_work *work, struct k_wsq_sync *sync)
+{
+	struct k_wsq_worker *guard;
+	k_spinlock_key_t key;
+	uint32_t runs = 0U;
+
+	__ASSERT_NO_MSG(!k_is_in_isr());
+
+	if (work->worker == NULL) {
+		return false;
+	}
+
+	guard = work_lock(work, NULL, &key);
+	if ((work->flags & K_WSQ_WORK_QUEUED) != 0U) {
+		runs++;
+	}
+	if ((work->flags & K_WSQ_WORK_RUNNING) != 0U) {
+		runs++;
+	}
+	if (runs != 0U) {
+		add_waiter_locked(guard->queue, work, sync, runs);
+	}
+	unlock_pair(guard, NULL, key);
+
+	if (runs != 0U) {
+		(void)k_sem_take(&sync->sem, K_FOREVER);
+	}
+
+	return runs != 0U;
+}
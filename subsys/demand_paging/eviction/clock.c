@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * CLOCK (second chance) eviction algorithm for demand paging
+ */
+#include <kernel.h>
+#include <mmu.h>
+#include <kernel_arch_interface.h>
+
+/* Index of the next page frame the clock hand will look at */
+static size_t clock_hand;
+
+/* The hand moves over the page frames in physical address order. An
+ * evictable page that was accessed since the hand last passed it gets a
+ * second chance: its accessed state is cleared and the hand moves on.
+ * The first page found not accessed is evicted.
+ *
+ * A full sweep clears the accessed state of every evictable page, so at
+ * most two sweeps are needed to find one.
+ */
+struct z_page_frame *k_mem_paging_eviction_select(bool *dirty_ptr)
+{
+	struct z_page_frame *pf;
+	uintptr_t flags;
+
+	for (size_t i = 0; i < 2 * Z_NUM_PAGE_FRAMES; i++) {
+		pf = &z_page_frames[clock_hand];
+		clock_hand = (clock_hand + 1) % Z_NUM_PAGE_FRAMES;
+
+		if (!z_page_frame_is_evictable(pf)) {
+			continue;
+		}
+
+		/* Reports the accessed state before clearing it */
+		flags = arch_page_info_get(pf->addr, NULL, true);
+
+		/* Implies a mismatch with page frame ontology and page
+		 * tables
+		 */
+		__ASSERT((flags & ARCH_DATA_PAGE_LOADED) != 0U,
+			 "non-present page, %s",
+			 ((flags & ARCH_DATA_PAGE_NOT_MAPPED) != 0U) ?
+			 "un-mapped" : "paged out");
+
+		if ((flags & ARCH_DATA_PAGE_ACCESSED) == 0U) {
+			*dirty_ptr = (flags & ARCH_DATA_PAGE_DIRTY) != 0U;
+			return pf;
+		}
+	}
+
+	/* Shouldn't ever happen unless every page is pinned */
+	__ASSERT(false, "no page to evict");
+
+	return NULL;
+}
+
+void k_mem_paging_eviction_init(void)
+{
+	clock_hand = 0;
+}
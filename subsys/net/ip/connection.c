@@ -59,6 +59,107 @@ static struct net_conn conns[CONFIG_NET_MAX_CONN];
 static sys_slist_t conn_unused;
 static sys_slist_t conn_used;
 
+#if defined(CONFIG_NET_CONN_HASH)
+BUILD_ASSERT((CONFIG_NET_CONN_HASH_SIZE &
+	      (CONFIG_NET_CONN_HASH_SIZE - 1)) == 0,
+	      "CONFIG_NET_CONN_HASH_SIZE must be a power of two");
+
+/** Flags of the handlers that are hashed by the 4-tuple */
+#define NET_CONN_HASH4_FLAGS (NET_CONN_REMOTE_ADDR_SPEC |		\
+			      NET_CONN_REMOTE_PORT_SPEC |		\
+			      NET_CONN_LOCAL_PORT_SPEC)
+
+/* Every used handler is also in exactly one of these lists. Handlers of
+ * connected sockets are hashed by protocol, remote address, remote port
+ * and local port. Handlers with only a local port are hashed by protocol
+ * and local port, whatever their local address. The rest, like handlers
+ * without a local port or for packet sockets, are wildcards.
+ */
+static sys_slist_t conn_hash4[CONFIG_NET_CONN_HASH_SIZE];
+static sys_slist_t conn_hash3[CONFIG_NET_CONN_HASH_SIZE];
+static sys_slist_t conn_wild;
+
+/* FNV-1a, ports are in network byte order */
+static uint32_t conn_hash(uint16_t proto, const uint8_t *addr, size_t len,
+			  uint16_t remote_port, uint16_t local_port)
+{
+	uint16_t key[] = { proto, local_port, remote_port };
+	const uint8_t *p = (const uint8_t *)key;
+	uint32_t hash = 2166136261U;
+
+	for (size_t i = 0; i < sizeof(key); i++) {
+		hash = (hash ^ p[i]) * 16777619U;
+	}
+
+	for (size_t i = 0; i < len; i++) {
+		hash = (hash ^ addr[i]) * 16777619U;
+	}
+
+	return (hash ^ (hash >> 16)) & (CONFIG_NET_CONN_HASH_SIZE - 1);
+}
+
+static const uint8_t *conn_ip_addr(const struct sockaddr *addr, size_t *len)
+{
+	if (IS_ENABLED(CONFIG_NET_IPV6) && addr->sa_family == AF_INET6) {
+		*len = sizeof(struct in6_addr);
+		return net_sin6(addr)->sin6_addr.s6_addr;
+	}
+
+	*len = sizeof(struct in_addr);
+	return net_sin(addr)->sin_addr.s4_addr;
+}
+
+static sys_slist_t *conn_hash_list(struct net_conn *conn)
+{
+	const uint8_t *addr;
+	size_t len;
+
+	if ((conn->proto != IPPROTO_UDP && conn->proto != IPPROTO_TCP) ||
+	    (conn->family != AF_INET && conn->family != AF_INET6)) {
+		return &conn_wild;
+	}
+
+	if ((conn->flags & NET_CONN_HASH4_FLAGS) == NET_CONN_HASH4_FLAGS) {
+		addr = conn_ip_addr(&conn->remote_addr, &len);
+
+		return &conn_hash4[conn_hash(conn->proto, addr, len,
+				       net_sin(&conn->remote_addr)->sin_port,
+				       net_sin(&conn->local_addr)->sin_port)];
+	}
+
+	if (conn->flags & NET_CONN_LOCAL_PORT_SPEC) {
+		return &conn_hash3[conn_hash(conn->proto, NULL, 0, 0U,
+				       net_sin(&conn->local_addr)->sin_port)];
+	}
+
+	return &conn_wild;
+}
+
+static void conn_hash_add(struct net_conn *conn)
+{
+	sys_slist_prepend(conn_hash_list(conn), &conn->hash_node);
+}
+
+static void conn_hash_del(struct net_conn *conn)
+{
+	sys_slist_find_and_remove(conn_hash_list(conn), &conn->hash_node);
+}
+
+static void conn_hash_init(void)
+{
+	for (int i = 0; i < CONFIG_NET_CONN_HASH_SIZE; i++) {
+		sys_slist_init(&conn_hash4[i]);
+		sys_slist_init(&conn_hash3[i]);
+	}
+
+	sys_slist_init(&conn_wild);
+}
+#else
+#define conn_hash_add(...)
+#define conn_hash_del(...)
+#define conn_hash_init(...)
+#endif /* CONFIG_NET_CONN_HASH */
+
 #if (CONFIG_NET_CONN_LOG_LEVEL >= LOG_LEVEL_DBG)
 static inline
 void conn_register_debug(struct net_conn *conn,
@@ -356,6 +457,7 @@ int net_conn_register(uint16_t proto, uint8_t family,
 	}
 
 	conn_set_used(conn);
+	conn_hash_add(conn);
 
 	conn_register_debug(conn, remote_port, local_port);
 
@@ -380,6 +482,7 @@ int net_conn_unregister(struct net_conn_handle *handle)
 	NET_DBG("Connection handler %p removed", conn);
 
 	sys_slist_find_and_remove(&conn_used, &conn->node);
+	conn_hash_del(conn);
 
 	conn_set_unused(conn);
 
@@ -459,6 +562,45 @@ static bool conn_addr_cmp(struct net_pkt *pkt,
 	return true;
 }
 
+static bool conn_iface_match(struct net_conn *conn, struct net_pkt *pkt)
+{
+	return conn->context == NULL ||
+	       !net_context_is_bound_to_iface(conn->context) ||
+	       net_pkt_iface(pkt) == net_context_get_iface(conn->context);
+}
+
+/* Check the ports and the addresses of a UDP or TCP handler */
+static bool conn_endpoints_match(struct net_conn *conn, struct net_pkt *pkt,
+				 union net_ip_header *ip_hdr,
+				 uint16_t src_port, uint16_t dst_port)
+{
+	if (net_sin(&conn->remote_addr)->sin_port) {
+		if (net_sin(&conn->remote_addr)->sin_port != src_port) {
+			return false;
+		}
+	}
+
+	if (net_sin(&conn->local_addr)->sin_port) {
+		if (net_sin(&conn->local_addr)->sin_port != dst_port) {
+			return false;
+		}
+	}
+
+	if (conn->flags & NET_CONN_REMOTE_ADDR_SET) {
+		if (!conn_addr_cmp(pkt, ip_hdr, &conn->remote_addr, true)) {
+			return false;
+		}
+	}
+
+	if (conn->flags & NET_CONN_LOCAL_ADDR_SET) {
+		if (!conn_addr_cmp(pkt, ip_hdr, &conn->local_addr, false)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
 static inline void conn_send_icmp_error(struct net_pkt *pkt)
 {
 	if (IS_ENABLED(CONFIG_NET_DISABLE_ICMP_DESTINATION_UNREACHABLE)) {
@@ -550,6 +692,90 @@ static enum net_verdict conn_raw_socket(struct net_pkt *pkt,
 	return NET_CONTINUE;
 }
 
+#if defined(CONFIG_NET_CONN_HASH)
+static bool conn_hash_match(struct net_conn *conn, struct net_pkt *pkt,
+			    union net_ip_header *ip_hdr, uint8_t proto,
+			    uint16_t src_port, uint16_t dst_port)
+{
+	if (!conn_iface_match(conn, pkt) || conn->proto != proto) {
+		return false;
+	}
+
+	if (conn->family != AF_UNSPEC && conn->family != net_pkt_family(pkt)) {
+		return false;
+	}
+
+	return conn_endpoints_match(conn, pkt, ip_hdr, src_port, dst_port);
+}
+
+/* Rank the handlers of a list like net_conn_input() does */
+static void conn_hash_rank(sys_slist_t *list, struct net_pkt *pkt,
+			   union net_ip_header *ip_hdr, uint8_t proto,
+			   uint16_t src_port, uint16_t dst_port,
+			   struct net_conn **best_match, int16_t *best_rank)
+{
+	struct net_conn *conn;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(list, conn, hash_node) {
+		if (!conn_hash_match(conn, pkt, ip_hdr, proto, src_port,
+				     dst_port)) {
+			continue;
+		}
+
+		if (*best_match != NULL &&
+		    (*best_match)->flags & NET_CONN_REMOTE_PORT_SPEC) {
+			return;
+		}
+
+		if (*best_rank < NET_CONN_RANK(conn->flags)) {
+			*best_rank = NET_CONN_RANK(conn->flags);
+			*best_match = conn;
+		}
+	}
+}
+
+/* Find the handler of a unicast UDP or TCP packet. A handler of a
+ * connected socket is preferred, then the best ranked listening or
+ * wildcard handler.
+ */
+static struct net_conn *conn_hash_lookup(struct net_pkt *pkt,
+					 union net_ip_header *ip_hdr,
+					 uint8_t proto, uint16_t src_port,
+					 uint16_t dst_port)
+{
+	struct net_conn *best_match = NULL;
+	int16_t best_rank = -1;
+	const uint8_t *addr;
+	size_t len;
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && net_pkt_family(pkt) == AF_INET6) {
+		addr = ip_hdr->ipv6->src;
+		len = sizeof(struct in6_addr);
+	} else {
+		addr = ip_hdr->ipv4->src;
+		len = sizeof(struct in_addr);
+	}
+
+	conn_hash_rank(&conn_hash4[conn_hash(proto, addr, len, src_port,
+					     dst_port)],
+		       pkt, ip_hdr, proto, src_port, dst_port,
+		       &best_match, &best_rank);
+	if (best_match) {
+		return best_match;
+	}
+
+	conn_hash_rank(&conn_hash3[conn_hash(proto, NULL, 0, 0U, dst_port)],
+		       pkt, ip_hdr, proto, src_port, dst_port,
+		       &best_match, &best_rank);
+	conn_hash_rank(&conn_wild, pkt, ip_hdr, proto, src_port, dst_port,
+		       &best_match, &best_rank);
+
+	return best_match;
+}
+#else
+#define conn_hash_lookup(...) NULL
+#endif /* CONFIG_NET_CONN_HASH */
+
 enum net_verdict net_conn_input(struct net_pkt *pkt,
 				union net_ip_header *ip_hdr,
 				uint8_t proto,
@@ -627,10 +853,18 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		}
 	}
 
+	/* Unicast UDP and TCP packets have a single recipient */
+	if (IS_ENABLED(CONFIG_NET_CONN_HASH) && !is_mcast_pkt &&
+	    !is_bcast_pkt && (proto == IPPROTO_UDP || proto == IPPROTO_TCP) &&
+	    (net_pkt_family(pkt) == AF_INET ||
+	     net_pkt_family(pkt) == AF_INET6)) {
+		best_match = conn_hash_lookup(pkt, ip_hdr, proto, src_port,
+					      dst_port);
+		goto deliver;
+	}
+
 	SYS_SLIST_FOR_EACH_CONTAINER(&conn_used, conn, node) {
-		if (conn->context != NULL &&
-		    net_context_is_bound_to_iface(conn->context) &&
-		    net_pkt_iface(pkt) != net_context_get_iface(conn->context)) {
+		if (!conn_iface_match(conn, pkt)) {
 			continue;
 		}
 
@@ -697,34 +931,9 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 
 		if (IS_ENABLED(CONFIG_NET_UDP) ||
 		    IS_ENABLED(CONFIG_NET_TCP)) {
-			if (net_sin(&conn->remote_addr)->sin_port) {
-				if (net_sin(&conn->remote_addr)->sin_port !=
-				    src_port) {
-					continue;
-				}
-			}
-
-			if (net_sin(&conn->local_addr)->sin_port) {
-				if (net_sin(&conn->local_addr)->sin_port !=
-				    dst_port) {
-					continue;
-				}
-			}
-
-			if (conn->flags & NET_CONN_REMOTE_ADDR_SET) {
-				if (!conn_addr_cmp(pkt, ip_hdr,
-						   &conn->remote_addr,
-						   true)) {
-					continue;
-				}
-			}
-
-			if (conn->flags & NET_CONN_LOCAL_ADDR_SET) {
-				if (!conn_addr_cmp(pkt, ip_hdr,
-						   &conn->local_addr,
-						   false)) {
-					continue;
-				}
+			if (!conn_endpoints_match(conn, pkt, ip_hdr, src_port,
+						  dst_port)) {
+				continue;
 			}
 
 			/* If we have an existing best_match, and that one
@@ -800,6 +1009,7 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		}
 	}
 
+deliver:
 	conn = best_match;
 	if (conn) {
 		NET_DBG("[%p] match found cb %p ud %p rank 0x%02x",
@@ -859,6 +1069,7 @@ void net_conn_init(void)
 
 	sys_slist_init(&conn_unused);
 	sys_slist_init(&conn_used);
+	conn_hash_init();
 
 	for (i = 0; i < CONFIG_NET_MAX_CONN; i++) {
 		sys_slist_prepend(&conn_unused, &conns[i].node);
@@ -1480,6 +1480,18 @@ static void tcp_cb(struct tcp *conn, void *user_data)
 	(*count)++;
 }
 
+static void tcp_rtt_cb(struct tcp *conn, void *user_data)
+{
+	struct net_shell_user_data *data = user_data;
+	const struct shell *shell = data->shell;
+	struct net_tcp_rtt_stats stats;
+
+	net_tcp_get_rtt_stats(conn, &stats);
+
+	PR("%p %6u %6u %6u %6u %6u %7u\n", conn, stats.srtt, stats.rttvar,
+	   stats.rto, stats.last, stats.min, stats.samples);
+}
+
 #if CONFIG_NET_TCP_LOG_LEVEL >= LOG_LEVEL_DBG
 static void tcp_sent_list_cb(struct tcp *conn, void *user_data)
 {
@@ -2038,6 +2050,11 @@ static int cmd_net_conn(const struct shell *shell, size_t argc, char *argv[])
 	if (count == 0) {
 		PR("No TCP connections\n");
 	} else {
+		/* Round-trip times and retransmission timeouts in ms */
+		PR("\nTCP          SRTT RTTVAR    RTO   Last    Min Samples\n");
+
+		net_tcp_foreach(tcp_rtt_cb, &user_data);
+
 #if CONFIG_NET_TCP_LOG_LEVEL >= LOG_LEVEL_DBG
 		/* Print information about pending packets */
 		struct tcp_detail_info details;
@@ -25,12 +25,15 @@ LOG_MODULE_REGISTER(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
 #include "net_stats.h"
 #include "net_private.h"
 #include "tcp_internal.h"
+#include "tcp_cc.h"
 
 #define ACK_TIMEOUT_MS CONFIG_NET_TCP_ACK_TIMEOUT
 #define ACK_TIMEOUT K_MSEC(ACK_TIMEOUT_MS)
 /* Allow for (tcp_retries + 1) transmissions */
 #define FIN_TIMEOUT_MS (tcp_rto * (tcp_retries + 1))
 #define FIN_TIMEOUT K_MSEC(FIN_TIMEOUT_MS)
+#define TCP_RTO_MIN CONFIG_NET_TCP_RTO_MIN
+#define TCP_RTO_MAX CONFIG_NET_TCP_RTO_MAX
 
 static int tcp_rto = CONFIG_NET_TCP_INIT_RETRANSMISSION_TIMEOUT;
 static int tcp_retries = CONFIG_NET_TCP_RETRY_COUNT;
@@ -41,6 +44,13 @@ static int tcp_window =
 	(CONFIG_NET_BUF_RX_COUNT * CONFIG_NET_BUF_DATA_SIZE) / 3;
 #endif
 
+/* Largest receive window that can be advertised */
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+#define TCP_MAX_RECV_WIN (UINT16_MAX << NET_TCP_MAX_WINDOW_SCALE)
+#else
+#define TCP_MAX_RECV_WIN UINT16_MAX
+#endif
+
 static sys_slist_t tcp_conns = SYS_SLIST_STATIC_INIT(&tcp_conns);
 
 static K_MUTEX_DEFINE(tcp_lock);
@@ -53,6 +63,7 @@ static K_KERNEL_STACK_DEFINE(work_q_stack, CONFIG_NET_TCP_WORKQ_STACK_SIZE);
 
 static void tcp_in(struct tcp *conn, struct net_pkt *pkt);
 static bool is_destination_local(struct net_pkt *pkt);
+static void tcp_rtt_backoff(struct tcp *conn);
 
 int (*tcp_send_cb)(struct net_pkt *pkt) = NULL;
 size_t (*tcp_recv_cb)(struct tcp *conn, struct net_pkt *pkt) = NULL;
@@ -474,6 +485,7 @@ static bool tcp_send_process_no_lock(struct tcp *conn)
 			if (clone) {
 				tcp_send(clone);
 				conn->send_retries--;
+				tcp_rtt_backoff(conn);
 			}
 		} else {
 			unref = true;
@@ -507,7 +519,7 @@ static bool tcp_send_process_no_lock(struct tcp *conn)
 
 	if (conn->in_retransmission) {
 		k_work_reschedule_for_queue(&tcp_work_q, &conn->send_timer,
-					    K_MSEC(tcp_rto));
+					    K_MSEC(conn->rtt.rto));
 	} else if (local && !sys_slist_is_empty(&conn->send_queue)) {
 		k_work_reschedule_for_queue(&tcp_work_q, &conn->send_timer,
 					    K_NO_WAIT);
@@ -556,7 +568,7 @@ static void tcp_send_timer_cancel(struct tcp *conn)
 	} else {
 		conn->send_retries = tcp_retries;
 		k_work_reschedule_for_queue(&tcp_work_q, &conn->send_timer,
-					    K_MSEC(tcp_rto));
+					    K_MSEC(conn->rtt.rto));
 	}
 }
 
@@ -615,8 +627,9 @@ static uint8_t *tcp_options_get(struct net_pkt *pkt, int tcp_options_len,
 	return buf;
 }
 
+/* The options that are only valid in a SYN are kept from the last SYN */
 static bool tcp_options_check(struct tcp_options *recv_options,
-			      struct net_pkt *pkt, ssize_t len)
+			      struct net_pkt *pkt, ssize_t len, bool syn)
 {
 	uint8_t options_buf[40]; /* TCP header max options size is 40 */
 	bool result = len > 0 && ((len % 4) == 0) ? true : false;
@@ -626,8 +639,11 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 
 	NET_DBG("len=%zd", len);
 
-	recv_options->mss_found = false;
-	recv_options->wnd_found = false;
+	if (syn) {
+		recv_options->mss_found = false;
+		recv_options->wnd_found = false;
+		recv_options->sack_perm_found = false;
+	}
 
 	for ( ; options && len >= 1; options += opt_len, len -= opt_len) {
 		opt = options[0];
@@ -662,6 +678,10 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 				goto end;
 			}
 
+			if (!syn) {
+				break;
+			}
+
 			recv_options->mss =
 				ntohs(UNALIGNED_GET((uint16_t *)(options + 2)));
 			recv_options->mss_found = true;
@@ -673,9 +693,58 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 				goto end;
 			}
 
-			recv_options->window = opt;
+			if (!syn) {
+				break;
+			}
+
+			recv_options->window = MIN(options[2],
+						   NET_TCP_MAX_WINDOW_SCALE);
 			recv_options->wnd_found = true;
+			NET_DBG("WS=%hu", recv_options->window);
+			break;
+		case NET_TCP_SACK_PERM_OPT:
+			if (opt_len != NET_TCP_SACK_PERM_SIZE) {
+				result = false;
+				goto end;
+			}
+
+			if (syn) {
+				recv_options->sack_perm_found = true;
+			}
 			break;
+#if defined(CONFIG_NET_TCP_SACK)
+		case NET_TCP_SACK_OPT:
+			if (opt_len < 2 + NET_TCP_SACK_BLOCK_SIZE ||
+			    opt_len > 2 + sizeof(recv_options->sack) ||
+			    (opt_len - 2) % NET_TCP_SACK_BLOCK_SIZE) {
+				result = false;
+				goto end;
+			}
+
+			recv_options->sack_count = 0U;
+
+			for (int i = 2; i < opt_len;
+			     i += NET_TCP_SACK_BLOCK_SIZE) {
+				struct tcp_sack_block *sb = &recv_options->sack[
+					recv_options->sack_count++];
+
+				sb->start = sys_get_be32(options + i);
+				sb->end = sys_get_be32(options + i + 4);
+			}
+			break;
+#endif
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+		case NET_TCP_TIMESTAMP_OPT:
+			if (opt_len != NET_TCP_TIMESTAMP_SIZE) {
+				result = false;
+				goto end;
+			}
+
+			recv_options->tsval = sys_get_be32(options + 2);
+			recv_options->tsecr = sys_get_be32(options + 6);
+			recv_options->ts_found = true;
+			break;
+#endif
 		default:
 			continue;
 		}
@@ -772,8 +841,20 @@ static int tcp_finalize_pkt(struct net_pkt *pkt)
 	return -EINVAL;
 }
 
+/* The window in a SYN is never scaled, RFC 7323 chapter 2.2 */
+static uint16_t tcp_recv_win_field(struct tcp *conn, uint8_t flags)
+{
+	uint32_t win = conn->recv_win;
+
+	if (!(flags & SYN) && conn->wscale_ok) {
+		win >>= conn->rcv_wscale;
+	}
+
+	return MIN(win, UINT16_MAX);
+}
+
 static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
-			  uint32_t seq)
+			  uint32_t seq, size_t options_len)
 {
 	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
 	struct tcphdr *th;
@@ -787,14 +868,10 @@ static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
 
 	UNALIGNED_PUT(conn->src.sin.sin_port, &th->th_sport);
 	UNALIGNED_PUT(conn->dst.sin.sin_port, &th->th_dport);
-	th->th_off = 5;
-
-	if (conn->send_options.mss_found) {
-		th->th_off++;
-	}
+	th->th_off = 5 + options_len / 4;
 
 	UNALIGNED_PUT(flags, &th->th_flags);
-	UNALIGNED_PUT(htons(conn->recv_win), &th->th_win);
+	UNALIGNED_PUT(htons(tcp_recv_win_field(conn, flags)), &th->th_win);
 	UNALIGNED_PUT(htonl(seq), &th->th_seq);
 
 	if (ACK & flags) {
@@ -821,23 +898,268 @@ static int ip_header_add(struct tcp *conn, struct net_pkt *pkt)
 	return -EINVAL;
 }
 
-static int net_tcp_set_mss_opt(struct tcp *conn, struct net_pkt *pkt)
+#if defined(CONFIG_NET_TCP_SACK)
+/* Report the out-of-order data held in the receive queue. The queue only
+ * holds contiguous data, so there is a single block.
+ */
+static bool tcp_sack_pending(struct tcp *conn)
+{
+	return CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT &&
+	       !net_pkt_is_empty(conn->queue_recv_data) &&
+	       net_tcp_seq_cmp(tcp_get_seq(conn->queue_recv_data->buffer),
+			       conn->ack) > 0;
+}
+
+static size_t tcp_sack_options_add(struct tcp *conn, uint8_t *buf)
 {
-	NET_PKT_DATA_ACCESS_DEFINE(mss_opt_access, struct tcp_mss_option);
-	struct tcp_mss_option *mss;
-	uint32_t recv_mss;
+	struct net_buf *last;
+	uint32_t start;
 
-	mss = net_pkt_get_data(pkt, &mss_opt_access);
-	if (!mss) {
-		return -ENOBUFS;
+	if (!tcp_sack_pending(conn)) {
+		return 0;
+	}
+
+	start = tcp_get_seq(conn->queue_recv_data->buffer);
+	last = net_buf_frag_last(conn->queue_recv_data->buffer);
+
+	buf[0] = NET_TCP_NOP_OPT;
+	buf[1] = NET_TCP_NOP_OPT;
+	buf[2] = NET_TCP_SACK_OPT;
+	buf[3] = 2 + NET_TCP_SACK_BLOCK_SIZE;
+	sys_put_be32(start, &buf[4]);
+	sys_put_be32(tcp_get_seq(last) + last->len, &buf[8]);
+
+	return 4 + NET_TCP_SACK_BLOCK_SIZE;
+}
+#endif
+
+/* Build the options of an outgoing segment, every option is padded to a
+ * multiple of four bytes. Returns the length of the options.
+ */
+static size_t tcp_options_add(struct tcp *conn, uint8_t flags, uint8_t *buf)
+{
+	size_t len = 0;
+
+	if (conn->send_options.mss_found) {
+		buf[len++] = NET_TCP_MSS_OPT;
+		buf[len++] = NET_TCP_MSS_SIZE;
+		sys_put_be16(net_tcp_get_recv_mss(conn), &buf[len]);
+		len += 2;
+	}
+
+	if ((flags & SYN) && conn->wscale_ok) {
+		buf[len++] = NET_TCP_NOP_OPT;
+		buf[len++] = NET_TCP_WINDOW_SCALE_OPT;
+		buf[len++] = NET_TCP_WINDOW_SCALE_SIZE;
+		buf[len++] = conn->rcv_wscale;
+	}
+
+	if ((flags & SYN) && conn->sack_ok) {
+		buf[len++] = NET_TCP_NOP_OPT;
+		buf[len++] = NET_TCP_NOP_OPT;
+		buf[len++] = NET_TCP_SACK_PERM_OPT;
+		buf[len++] = NET_TCP_SACK_PERM_SIZE;
+	}
+
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	if (conn->ts_ok) {
+		buf[len++] = NET_TCP_NOP_OPT;
+		buf[len++] = NET_TCP_NOP_OPT;
+		buf[len++] = NET_TCP_TIMESTAMP_OPT;
+		buf[len++] = NET_TCP_TIMESTAMP_SIZE;
+		sys_put_be32(k_uptime_get_32(), &buf[len]);
+		sys_put_be32((flags & ACK) ? conn->ts_recent : 0U,
+			     &buf[len + 4]);
+		len += 8;
+	}
+#endif
+
+#if defined(CONFIG_NET_TCP_SACK)
+	if (!(flags & SYN) && (flags & ACK) && conn->sack_ok) {
+		len += tcp_sack_options_add(conn, &buf[len]);
+	}
+#endif
+
+	return len;
+}
+
+/* Maximum payload of a data segment. The options carried by data segments
+ * come out of the MSS, RFC 6691 and RFC 7323 chapter 3.
+ */
+static uint16_t tcp_send_mss(struct tcp *conn)
+{
+	uint16_t mss = conn_mss(conn);
+	uint16_t opts_len = 0U;
+
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	if (conn->ts_ok) {
+		opts_len += 2 + NET_TCP_TIMESTAMP_SIZE;
+	}
+#endif
+
+#if defined(CONFIG_NET_TCP_SACK)
+	if (conn->sack_ok && tcp_sack_pending(conn)) {
+		opts_len += 4 + NET_TCP_SACK_BLOCK_SIZE;
+	}
+#endif
+
+	return mss > opts_len ? mss - opts_len : 1U;
+}
+
+/* Options offered in our SYN */
+static void tcp_options_offer(struct tcp *conn)
+{
+	conn->wscale_ok = IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE);
+	conn->sack_ok = IS_ENABLED(CONFIG_NET_TCP_SACK);
+	conn->ts_ok = IS_ENABLED(CONFIG_NET_TCP_TIMESTAMPS);
+	conn->rcv_wscale = 0U;
+
+	/* Smallest shift that lets the whole receive window be advertised */
+	while (conn->wscale_ok &&
+	       (conn->recv_win >> conn->rcv_wscale) > UINT16_MAX &&
+	       conn->rcv_wscale < NET_TCP_MAX_WINDOW_SCALE) {
+		conn->rcv_wscale++;
+	}
+}
+
+/* Only the options that both SYNs carry are used, RFC 7323 and RFC 2018 */
+static void tcp_options_negotiate(struct tcp *conn)
+{
+	struct tcp_options *opts = &conn->recv_options;
+
+	conn->wscale_ok = conn->wscale_ok && opts->wnd_found;
+	conn->sack_ok = conn->sack_ok && opts->sack_perm_found;
+	conn->ts_ok = conn->ts_ok && opts->ts_found;
+
+	if (conn->wscale_ok) {
+		conn->snd_wscale = opts->window;
+	} else {
+		conn->snd_wscale = 0U;
+		conn->rcv_wscale = 0U;
+	}
+
+	NET_DBG("conn: %p wscale %d (%hu/%hu) sack %d ts %d", conn,
+		conn->wscale_ok, (uint16_t)conn->rcv_wscale,
+		(uint16_t)conn->snd_wscale, conn->sack_ok, conn->ts_ok);
+}
+
+/* Update the estimators with a round-trip time of r ms and compute the
+ * retransmission timeout, RFC 6298 chapter 2. The clock granularity G is
+ * one millisecond.
+ */
+static void tcp_rtt_update(struct tcp *conn, uint32_t r)
+{
+	struct tcp_rtt *rtt = &conn->rtt;
+	int32_t delta, err;
+	uint32_t rto;
+
+	r = MIN(r, (uint32_t)TCP_RTO_MAX);
+
+	if (rtt->samples == 0U) {
+		rtt->srtt = r << TCP_RTT_SHIFT;
+		rtt->rttvar = rtt->srtt / 2U;
+		rtt->min = r;
+	} else {
+		/* RTTVAR += (|SRTT - R| - RTTVAR) / 4, SRTT += (R - SRTT) / 8 */
+		delta = (int32_t)((r << TCP_RTT_SHIFT) - rtt->srtt);
+		err = delta < 0 ? -delta : delta;
+		rtt->rttvar = (uint32_t)((int32_t)rtt->rttvar +
+					 (err - (int32_t)rtt->rttvar) / 4);
+		rtt->srtt = (uint32_t)((int32_t)rtt->srtt + delta / 8);
+		rtt->min = MIN(rtt->min, r);
 	}
 
-	recv_mss = net_tcp_get_recv_mss(conn);
-	recv_mss |= (NET_TCP_MSS_OPT << 24) | (NET_TCP_MSS_SIZE << 16);
+	rtt->last = r;
+	rtt->samples++;
 
-	UNALIGNED_PUT(htonl(recv_mss), (uint32_t *)mss);
+	/* RTO = SRTT + max(G, 4 * RTTVAR) */
+	rto = (rtt->srtt >> TCP_RTT_SHIFT) +
+	      MAX(1U, (4U * rtt->rttvar) >> TCP_RTT_SHIFT);
+	rtt->rto = CLAMP(rto, (uint32_t)TCP_RTO_MIN, (uint32_t)TCP_RTO_MAX);
 
-	return net_pkt_set_data(pkt, &mss_opt_access);
+	NET_DBG("conn: %p rtt=%u ms srtt=%u rttvar=%u rto=%u ms", conn, r,
+		rtt->srtt >> TCP_RTT_SHIFT, rtt->rttvar >> TCP_RTT_SHIFT,
+		rtt->rto);
+}
+
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+/* Remember the timestamp to echo, RFC 7323 chapter 4.3. Segments beyond
+ * the last ACK sent and old timestamps are not used.
+ */
+static void tcp_ts_received(struct tcp *conn, struct tcphdr *th)
+{
+	struct tcp_options *opts = &conn->recv_options;
+
+	if (!opts->ts_found) {
+		return;
+	}
+
+	if ((th_flags(th) & SYN) ||
+	    (net_tcp_seq_cmp(th_seq(th), conn->ack) <= 0 &&
+	     net_tcp_seq_cmp(opts->tsval, conn->ts_recent) >= 0)) {
+		conn->ts_recent = opts->tsval;
+	}
+}
+
+/* Measure the round-trip time from the timestamp echoed in an ACK that
+ * acknowledges new data, RFC 7323 chapter 4.1. Unlike a timed segment,
+ * the echoed timestamp is not ambiguous after a retransmission.
+ */
+static bool tcp_ts_rtt(struct tcp *conn)
+{
+	struct tcp_options *opts = &conn->recv_options;
+
+	if (!conn->ts_ok || !opts->ts_found || opts->tsecr == 0U) {
+		return false;
+	}
+
+	tcp_rtt_update(conn, k_uptime_get_32() - opts->tsecr);
+
+	return true;
+}
+#else
+#define tcp_ts_received(...)
+#define tcp_ts_rtt(...) false
+#endif /* CONFIG_NET_TCP_TIMESTAMPS */
+
+/* Time the segment ending at end unless one is already being timed */
+static void tcp_rtt_start(struct tcp *conn, uint32_t end)
+{
+	if (conn->rtt.timing) {
+		return;
+	}
+
+	conn->rtt.timing = true;
+	conn->rtt.seq = end;
+	conn->rtt.start = k_uptime_get_32();
+}
+
+/* Measure the round-trip time from an ACK that acknowledges new data */
+static void tcp_rtt_ack(struct tcp *conn, uint32_t ack)
+{
+	struct tcp_rtt *rtt = &conn->rtt;
+
+	if (tcp_ts_rtt(conn)) {
+		rtt->timing = false;
+		return;
+	}
+
+	if (rtt->timing && net_tcp_seq_cmp(ack, rtt->seq) >= 0) {
+		rtt->timing = false;
+		tcp_rtt_update(conn, k_uptime_get_32() - rtt->start);
+	}
+}
+
+/* Back off the timer after a retransmission, RFC 6298 chapter 5.5. The
+ * timeout stays doubled until a new measurement is taken. By Karn's
+ * algorithm the retransmitted data cannot be timed.
+ */
+static void tcp_rtt_backoff(struct tcp *conn)
+{
+	conn->rtt.rto = MIN(conn->rtt.rto * 2U, (uint32_t)TCP_RTO_MAX);
+	conn->rtt.timing = false;
+
+	NET_DBG("conn: %p rto=%u ms", conn, conn->rtt.rto);
 }
 
 static bool is_destination_local(struct net_pkt *pkt)
@@ -866,14 +1188,12 @@ static bool is_destination_local(struct net_pkt *pkt)
 static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		       uint32_t seq)
 {
-	size_t alloc_len = sizeof(struct tcphdr);
+	uint8_t options[40]; /* TCP header max options size is 40 */
+	size_t options_len = tcp_options_add(conn, flags, options);
+	size_t alloc_len = sizeof(struct tcphdr) + options_len;
 	struct net_pkt *pkt;
 	int ret = 0;
 
-	if (conn->send_options.mss_found) {
-		alloc_len += sizeof(uint32_t);
-	}
-
 	pkt = tcp_pkt_alloc(conn, alloc_len);
 	if (!pkt) {
 		ret = -ENOBUFS;
@@ -892,14 +1212,14 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		goto out;
 	}
 
-	ret = tcp_header_add(conn, pkt, flags, seq);
+	ret = tcp_header_add(conn, pkt, flags, seq, options_len);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
 		goto out;
 	}
 
-	if (conn->send_options.mss_found) {
-		ret = net_tcp_set_mss_opt(conn, pkt);
+	if (options_len) {
+		ret = net_pkt_write(pkt, options, options_len);
 		if (ret < 0) {
 			tcp_pkt_unref(pkt);
 			goto out;
@@ -972,9 +1292,19 @@ static int tcp_pkt_peek(struct net_pkt *to, struct net_pkt *from, size_t pos,
 	return net_pkt_copy(to, from, len);
 }
 
+/* The amount of data that may be unacknowledged */
+static uint32_t tcp_send_window(struct tcp *conn)
+{
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+	return MIN(conn->send_win, conn->cc.cwnd);
+#else
+	return conn->send_win;
+#endif
+}
+
 static bool tcp_window_full(struct tcp *conn)
 {
-	bool window_full = !(conn->unacked_len < conn->send_win);
+	bool window_full = !(conn->unacked_len < tcp_send_window(conn));
 
 	NET_DBG("conn: %p window_full=%hu", conn, window_full);
 
@@ -999,37 +1329,58 @@ static int tcp_unsent_len(struct tcp *conn)
 	return unsent_len;
 }
 
-static int tcp_send_data(struct tcp *conn)
+/* Send len bytes of send_data starting at pos as one segment */
+static int tcp_send_segment(struct tcp *conn, int pos, int len)
 {
-	int ret = 0;
-	int pos, len;
 	struct net_pkt *pkt;
-
-	pos = conn->unacked_len;
-	len = MIN3(conn->send_data_total - conn->unacked_len,
-		   conn->send_win - conn->unacked_len,
-		   conn_mss(conn));
-	if (len == 0) {
-		NET_DBG("conn: %p no data to send", conn);
-		ret = -ENODATA;
-		goto out;
-	}
+	int ret;
 
 	pkt = tcp_pkt_alloc(conn, len);
 	if (!pkt) {
 		NET_ERR("conn: %p packet allocation failed, len=%d", conn, len);
-		ret = -ENOBUFS;
-		goto out;
+		return -ENOBUFS;
 	}
 
 	ret = tcp_pkt_peek(pkt, conn->send_data, pos, len);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
-		ret = -ENOBUFS;
+		return -ENOBUFS;
+	}
+
+	if (pos < conn->unacked_len ||
+	    conn->data_mode == TCP_DATA_MODE_RESEND) {
+		/* Karn's algorithm, retransmissions are not timed */
+		conn->rtt.timing = false;
+	} else {
+		tcp_rtt_start(conn, conn->seq + pos + len);
+	}
+
+	ret = tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + pos);
+
+	/* The data we want to send, has been moved to the send queue so we
+	 * can unref the head net_pkt. If there was an error, we need to remove
+	 * the packet anyway.
+	 */
+	tcp_pkt_unref(pkt);
+
+	return ret;
+}
+
+static int tcp_send_data(struct tcp *conn)
+{
+	int ret = 0;
+	int len;
+
+	len = MIN3((int)(conn->send_data_total - conn->unacked_len),
+		   (int)tcp_send_window(conn) - conn->unacked_len,
+		   (int)tcp_send_mss(conn));
+	if (len <= 0) {
+		NET_DBG("conn: %p no data to send", conn);
+		ret = -ENODATA;
 		goto out;
 	}
 
-	ret = tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + conn->unacked_len);
+	ret = tcp_send_segment(conn, conn->unacked_len, len);
 	if (ret == 0) {
 		conn->unacked_len += len;
 
@@ -1042,12 +1393,6 @@ static int tcp_send_data(struct tcp *conn)
 		}
 	}
 
-	/* The data we want to send, has been moved to the send queue so we
-	 * can unref the head net_pkt. If there was an error, we need to remove
-	 * the packet anyway.
-	 */
-	tcp_pkt_unref(pkt);
-
 	conn_send_data_dump(conn);
 
  out:
@@ -1096,12 +1441,375 @@ static int tcp_send_queued_data(struct tcp *conn)
 	if (subscribe) {
 		conn->send_data_retries = 0;
 		k_work_reschedule_for_queue(&tcp_work_q, &conn->send_data_timer,
-					    K_MSEC(tcp_rto));
+					    K_MSEC(conn->rtt.rto));
 	}
  out:
 	return ret;
 }
 
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+/* Duplicate ACKs that trigger a fast retransmit, RFC 5681 chapter 3.2 */
+#define TCP_DUP_ACK_THRESHOLD 3
+
+static const struct tcp_cc_ops *tcp_cc_find(const char *name)
+{
+	STRUCT_SECTION_FOREACH(tcp_cc_ops, ops) {
+		if (is(ops->name, name)) {
+			return ops;
+		}
+	}
+
+	return NULL;
+}
+
+static void tcp_cc_select(struct tcp *conn)
+{
+	conn->cc.ops = tcp_cc_find(CONFIG_NET_TCP_CONGESTION_DEFAULT);
+	if (conn->cc.ops == NULL) {
+		conn->cc.ops = tcp_cc_find("newreno");
+	}
+}
+
+/* Called when the connection is established and the MSS is known */
+static void tcp_cc_init(struct tcp *conn)
+{
+	struct tcp_cc *cc = &conn->cc;
+	uint16_t mss = conn_mss(conn);
+
+	/* Initial window, RFC 5681 chapter 3.1 */
+	if (mss > 2190) {
+		cc->cwnd = 2U * mss;
+	} else if (mss > 1095) {
+		cc->cwnd = 3U * mss;
+	} else {
+		cc->cwnd = 4U * mss;
+	}
+
+	cc->ssthresh = UINT32_MAX;
+	cc->recover = conn->seq;
+	cc->bytes_acked = 0U;
+	cc->dup_acks = 0U;
+	cc->in_recovery = false;
+	memset(cc->priv, 0, sizeof(cc->priv));
+
+#if defined(CONFIG_NET_TCP_SACK)
+	conn->sacked_count = 0U;
+	conn->high_rxt = conn->seq;
+#endif
+
+	if (cc->ops->init) {
+		cc->ops->init(conn);
+	}
+
+	NET_DBG("conn: %p %s cwnd=%u", conn, cc->ops->name, cc->cwnd);
+}
+
+/* Retransmit the first unacknowledged segment */
+static void tcp_cc_retransmit(struct tcp *conn)
+{
+	int len = MIN(conn->unacked_len, (int)tcp_send_mss(conn));
+
+	if (len > 0 && tcp_send_segment(conn, 0, len) == 0) {
+		net_stats_update_tcp_resent(conn->iface, len);
+		net_stats_update_tcp_seg_rexmit(conn->iface);
+	}
+
+#if defined(CONFIG_NET_TCP_SACK)
+	conn->high_rxt = conn->seq + MAX(len, 0);
+#endif
+}
+
+#if defined(CONFIG_NET_TCP_SACK)
+/* Add a block to the scoreboard, merging it with the blocks it overlaps
+ * or touches. When the scoreboard is full the highest block is forgotten,
+ * which only means that data may be retransmitted needlessly.
+ */
+static void tcp_sack_insert(struct tcp *conn, uint32_t start, uint32_t end)
+{
+	struct tcp_sack_block *sb = conn->sacked;
+	int n = conn->sacked_count;
+	int i = 0;
+	int j;
+
+	while (i < n && net_tcp_seq_cmp(sb[i].end, start) < 0) {
+		i++;
+	}
+
+	for (j = i; j < n && net_tcp_seq_cmp(sb[j].start, end) <= 0; j++) {
+		if (net_tcp_seq_cmp(sb[j].start, start) < 0) {
+			start = sb[j].start;
+		}
+
+		if (net_tcp_seq_cmp(sb[j].end, end) > 0) {
+			end = sb[j].end;
+		}
+	}
+
+	if (i == j && n == (int)ARRAY_SIZE(conn->sacked)) {
+		if (i == n) {
+			return;
+		}
+
+		n--;
+	}
+
+	memmove(&sb[i + 1], &sb[j], (n - j) * sizeof(*sb));
+	sb[i].start = start;
+	sb[i].end = end;
+	conn->sacked_count = n - (j - i) + 1;
+}
+
+/* Update the scoreboard from the cumulative ACK and the SACK blocks of the
+ * received segment. Blocks outside of the unacknowledged data are ignored.
+ */
+static void tcp_sack_update(struct tcp *conn)
+{
+	struct tcp_options *opts = &conn->recv_options;
+	struct tcp_sack_block *sb = conn->sacked;
+	uint32_t snd_nxt = conn->seq + conn->unacked_len;
+	int i = 0;
+
+	while (i < conn->sacked_count &&
+	       net_tcp_seq_cmp(sb[i].end, conn->seq) <= 0) {
+		i++;
+	}
+
+	if (i > 0) {
+		conn->sacked_count -= i;
+		memmove(sb, &sb[i], conn->sacked_count * sizeof(*sb));
+	}
+
+	if (conn->sacked_count > 0 &&
+	    net_tcp_seq_cmp(sb[0].start, conn->seq) < 0) {
+		sb[0].start = conn->seq;
+	}
+
+	if (!conn->sack_ok) {
+		return;
+	}
+
+	for (i = 0; i < opts->sack_count; i++) {
+		uint32_t start = opts->sack[i].start;
+		uint32_t end = opts->sack[i].end;
+
+		if (net_tcp_seq_cmp(start, conn->seq) < 0 ||
+		    net_tcp_seq_cmp(end, snd_nxt) > 0 ||
+		    net_tcp_seq_cmp(start, end) >= 0) {
+			continue;
+		}
+
+		tcp_sack_insert(conn, start, end);
+	}
+}
+
+/* Retransmit the next hole below selectively acknowledged data that was
+ * not retransmitted yet in this recovery, a simplified NextSeg() of
+ * RFC 6675. Returns false if there is no such hole.
+ */
+static bool tcp_sack_retransmit(struct tcp *conn)
+{
+	uint32_t start = conn->seq;
+	int len;
+
+	if (net_tcp_seq_cmp(conn->high_rxt, start) > 0) {
+		start = conn->high_rxt;
+	}
+
+	for (int i = 0; i < conn->sacked_count; i++) {
+		struct tcp_sack_block *sb = &conn->sacked[i];
+
+		if (net_tcp_seq_cmp(sb->end, start) <= 0) {
+			continue;
+		}
+
+		if (net_tcp_seq_cmp(sb->start, start) <= 0) {
+			start = sb->end;
+			continue;
+		}
+
+		len = MIN(sb->start - start, (uint32_t)tcp_send_mss(conn));
+
+		if (tcp_send_segment(conn, start - conn->seq, len) == 0) {
+			net_stats_update_tcp_resent(conn->iface, len);
+			net_stats_update_tcp_seg_rexmit(conn->iface);
+		}
+
+		conn->high_rxt = start + len;
+
+		return true;
+	}
+
+	return false;
+}
+
+/* Retransmit after a partial acknowledgment. The data at seq may have been
+ * retransmitted already because of SACK information.
+ */
+static void tcp_cc_retransmit_partial(struct tcp *conn)
+{
+	if (!conn->sack_ok) {
+		tcp_cc_retransmit(conn);
+		return;
+	}
+
+	if (!tcp_sack_retransmit(conn) &&
+	    net_tcp_seq_cmp(conn->seq, conn->high_rxt) >= 0) {
+		tcp_cc_retransmit(conn);
+	}
+}
+#else
+#define tcp_sack_update(...)
+#define tcp_sack_retransmit(...) false
+#define tcp_cc_retransmit_partial(conn) tcp_cc_retransmit(conn)
+#endif /* CONFIG_NET_TCP_SACK */
+
+/* Whether the congestion window limited the data that was in flight, the
+ * window is not grown otherwise (RFC 7661).
+ */
+static bool tcp_cc_cwnd_limited(struct tcp *conn, uint32_t flight)
+{
+	struct tcp_cc *cc = &conn->cc;
+
+	if (cc->cwnd < cc->ssthresh) {
+		return 2U * flight > cc->cwnd;
+	}
+
+	return flight + conn_mss(conn) > cc->cwnd;
+}
+
+/* New data was acknowledged, conn->seq and conn->unacked_len are already
+ * updated and flight is the amount that was unacknowledged before.
+ */
+static void tcp_cc_ack(struct tcp *conn, uint32_t acked, uint32_t flight)
+{
+	struct tcp_cc *cc = &conn->cc;
+	uint16_t mss = conn_mss(conn);
+
+	cc->dup_acks = 0U;
+
+	tcp_sack_update(conn);
+
+	if (cc->in_recovery) {
+		if (net_tcp_seq_cmp(conn->seq, cc->recover) >= 0) {
+			/* Full acknowledgment, RFC 6582 chapter 3.2 step 3 */
+			cc->cwnd = MIN(cc->ssthresh,
+				       MAX((uint32_t)conn->unacked_len,
+					   (uint32_t)mss) + mss);
+			cc->in_recovery = false;
+			NET_DBG("conn: %p recovered, cwnd=%u", conn, cc->cwnd);
+		} else {
+			/* Partial acknowledgment, the segment after the
+			 * acknowledged data was lost as well.
+			 */
+			tcp_cc_retransmit_partial(conn);
+			cc->cwnd -= MIN(acked, cc->cwnd - mss);
+			if (acked >= mss) {
+				cc->cwnd += mss;
+			}
+		}
+
+		return;
+	}
+
+	if (!tcp_cc_cwnd_limited(conn, flight)) {
+		return;
+	}
+
+	if (cc->cwnd < cc->ssthresh) {
+		/* Slow start, RFC 5681 equation (2) */
+		cc->cwnd += MIN(acked, (uint32_t)mss);
+	} else {
+		cc->ops->cong_avoid(conn, acked);
+	}
+}
+
+static void tcp_cc_dup_ack(struct tcp *conn)
+{
+	struct tcp_cc *cc = &conn->cc;
+	uint16_t mss = conn_mss(conn);
+
+	if (conn->unacked_len == 0 ||
+	    conn->data_mode == TCP_DATA_MODE_RESEND) {
+		return;
+	}
+
+	tcp_sack_update(conn);
+
+	if (cc->in_recovery) {
+		/* Each duplicate ACK means a segment has left the network,
+		 * use it for a known hole if there is one.
+		 */
+		if (conn->sack_ok && tcp_sack_retransmit(conn)) {
+			return;
+		}
+
+		cc->cwnd += mss;
+		(void)tcp_send_queued_data(conn);
+		return;
+	}
+
+	if (++cc->dup_acks < TCP_DUP_ACK_THRESHOLD) {
+		return;
+	}
+
+	cc->dup_acks = 0U;
+
+	/* Do not react again to losses from before the last retransmission
+	 * timeout, RFC 6582 chapter 3.2 step 2.
+	 */
+	if (net_tcp_seq_cmp(conn->seq, cc->recover) < 0) {
+		return;
+	}
+
+	cc->ssthresh = cc->ops->ssthresh(conn);
+	cc->cwnd = cc->ssthresh + TCP_DUP_ACK_THRESHOLD * mss;
+	cc->recover = conn->seq + conn->unacked_len;
+	cc->bytes_acked = 0U;
+	cc->in_recovery = true;
+
+	NET_DBG("conn: %p fast retransmit, ssthresh=%u", conn, cc->ssthresh);
+
+	tcp_cc_retransmit(conn);
+}
+
+/* The retransmission timer expired */
+static void tcp_cc_timeout(struct tcp *conn)
+{
+	struct tcp_cc *cc = &conn->cc;
+
+	/* Repeated timeouts keep the threshold of the first one */
+	if (conn->data_mode == TCP_DATA_MODE_SEND) {
+		if (conn->unacked_len == 0) {
+			return;
+		}
+
+		cc->ssthresh = cc->ops->ssthresh(conn);
+		cc->recover = conn->seq + conn->unacked_len;
+	}
+
+	/* Loss window, RFC 5681 chapter 3.1 */
+	cc->cwnd = conn_mss(conn);
+	cc->bytes_acked = 0U;
+	cc->dup_acks = 0U;
+	cc->in_recovery = false;
+
+#if defined(CONFIG_NET_TCP_SACK)
+	/* Everything is sent again, the peer may also have dropped data it
+	 * selectively acknowledged (RFC 2018 chapter 8).
+	 */
+	conn->sacked_count = 0U;
+#endif
+
+	NET_DBG("conn: %p timeout, ssthresh=%u", conn, cc->ssthresh);
+}
+#else
+#define tcp_cc_select(...)
+#define tcp_cc_init(...)
+#define tcp_cc_ack(...)
+#define tcp_cc_dup_ack(...)
+#define tcp_cc_timeout(...)
+#endif /* CONFIG_NET_TCP_CONGESTION_CONTROL */
+
 static void tcp_cleanup_recv_queue(struct k_work *work)
 {
 	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
@@ -1136,6 +1844,9 @@ static void tcp_resend_data(struct k_work *work)
 		goto out;
 	}
 
+	tcp_cc_timeout(conn);
+	tcp_rtt_backoff(conn);
+
 	conn->data_mode = TCP_DATA_MODE_RESEND;
 	conn->unacked_len = 0;
 
@@ -1166,7 +1877,7 @@ static void tcp_resend_data(struct k_work *work)
 	}
 
 	k_work_reschedule_for_queue(&tcp_work_q, &conn->send_data_timer,
-				    K_MSEC(tcp_rto));
+				    K_MSEC(conn->rtt.rto));
 
  out:
 	k_mutex_unlock(&conn->lock);
@@ -1256,6 +1967,9 @@ static struct tcp *tcp_conn_alloc(struct net_context *context)
 	conn->in_connect = false;
 	conn->state = TCP_LISTEN;
 	conn->recv_win = tcp_window;
+	conn->rtt.rto = tcp_rto;
+
+	tcp_cc_select(conn);
 
 	/* Set the recv_win with the rcvbuf configured for the socket. */
 	if (IS_ENABLED(CONFIG_NET_CONTEXT_RCVBUF) &&
@@ -1352,6 +2066,21 @@ static struct tcp *tcp_conn_search(struct net_pkt *pkt)
 	return found ? conn : NULL;
 }
 
+/* The connection handler of an established connection belongs to its
+ * context, so only packets matched to a listening handler need a search.
+ */
+static struct tcp *tcp_conn_find(struct net_conn *net_conn,
+				 struct net_pkt *pkt)
+{
+	struct net_context *context = net_conn->context;
+
+	if (context && context->tcp && tcp_conn_cmp(context->tcp, pkt)) {
+		return context->tcp;
+	}
+
+	return tcp_conn_search(pkt);
+}
+
 static struct tcp *tcp_conn_new(struct net_pkt *pkt);
 
 static enum net_verdict tcp_recv(struct net_conn *net_conn,
@@ -1363,10 +2092,9 @@ static enum net_verdict tcp_recv(struct net_conn *net_conn,
 	struct tcp *conn;
 	struct tcphdr *th;
 
-	ARG_UNUSED(net_conn);
 	ARG_UNUSED(proto);
 
-	conn = tcp_conn_search(pkt);
+	conn = tcp_conn_find(net_conn, pkt);
 	if (conn) {
 		goto in;
 	}
@@ -1728,6 +2456,13 @@ static void tcp_out_of_order_data(struct tcp *conn, struct net_pkt *pkt,
 	/* We received out-of-order data. Try to queue it.
 	 */
 	tcp_queue_recv_data(conn, pkt, data_len, seq);
+
+	/* Report the queued data at once with a duplicate ACK that carries
+	 * a SACK block, RFC 2018 chapter 4.
+	 */
+	if (conn->sack_ok) {
+		tcp_out(conn, ACK);
+	}
 }
 
 /* TCP state machine, everything happens here */
@@ -1742,6 +2477,7 @@ static void tcp_in(struct tcp *conn, struct net_pkt *pkt)
 	struct net_pkt *recv_pkt;
 	void *recv_user_data;
 	struct k_fifo *recv_data_fifo;
+	uint32_t prev_send_win = 0U;
 	size_t len;
 	int ret;
 
@@ -1773,8 +2509,17 @@ static void tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		goto next_state;
 	}
 
+	if (th) {
+		/* Timestamps and SACK blocks only describe this segment */
+		conn->recv_options.ts_found = false;
+#if defined(CONFIG_NET_TCP_SACK)
+		conn->recv_options.sack_count = 0U;
+#endif
+	}
+
 	if (tcp_options_len && !tcp_options_check(&conn->recv_options, pkt,
-						  tcp_options_len)) {
+						  tcp_options_len,
+						  th_flags(th) & SYN)) {
 		NET_DBG("DROP: Invalid TCP option list");
 		tcp_out(conn, RST);
 		conn_state(conn, TCP_CLOSED);
@@ -1786,9 +2531,16 @@ static void tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		int sndbuf;
 		size_t sndbuf_len;
 
+		tcp_ts_received(conn, th);
 
+		prev_send_win = conn->send_win;
 		conn->send_win = ntohs(th_win(th));
 
+		/* The window in a SYN is never scaled */
+		if (!(th_flags(th) & SYN) && conn->wscale_ok) {
+			conn->send_win <<= conn->snd_wscale;
+		}
+
 #if defined(CONFIG_NET_TCP_MAX_SEND_WINDOW_SIZE)
 		if (CONFIG_NET_TCP_MAX_SEND_WINDOW_SIZE) {
 			max_win = CONFIG_NET_TCP_MAX_SEND_WINDOW_SIZE;
@@ -1828,9 +2580,13 @@ next_state:
 	switch (conn->state) {
 	case TCP_LISTEN:
 		if (FL(&fl, ==, SYN)) {
+			tcp_options_offer(conn);
+			tcp_options_negotiate(conn);
+
 			/* Make sure our MSS is also sent in the ACK */
 			conn->send_options.mss_found = true;
 			conn_ack(conn, th_seq(th) + 1); /* capture peer's isn */
+			tcp_rtt_start(conn, conn->seq + 1);
 			tcp_out(conn, SYN | ACK);
 			conn->send_options.mss_found = false;
 			conn_seq(conn, + 1);
@@ -1842,7 +2598,9 @@ next_state:
 						    &conn->establish_timer,
 						    ACK_TIMEOUT);
 		} else {
+			tcp_options_offer(conn);
 			conn->send_options.mss_found = true;
+			tcp_rtt_start(conn, conn->seq + 1);
 			tcp_out(conn, SYN);
 			conn->send_options.mss_found = false;
 			conn_seq(conn, + 1);
@@ -1854,6 +2612,8 @@ next_state:
 				th_seq(th) == conn->ack)) {
 			k_work_cancel_delayable(&conn->establish_timer);
 			tcp_send_timer_cancel(conn);
+			tcp_rtt_ack(conn, th_ack(th));
+			tcp_cc_init(conn);
 			next = TCP_ESTABLISHED;
 			net_context_set_state(conn->context,
 					      NET_CONTEXT_CONNECTED);
@@ -1888,6 +2648,8 @@ next_state:
 		 */
 		if (FL(&fl, &, SYN | ACK, th && th_ack(th) == conn->seq)) {
 			tcp_send_timer_cancel(conn);
+			tcp_options_negotiate(conn);
+			tcp_rtt_ack(conn, th_ack(th));
 			conn_ack(conn, th_seq(th) + 1);
 			if (len) {
 				if (tcp_data_get(conn, pkt, &len) < 0) {
@@ -1896,6 +2658,7 @@ next_state:
 				conn_ack(conn, + len);
 			}
 
+			tcp_cc_init(conn);
 			next = TCP_ESTABLISHED;
 			net_context_set_state(conn->context,
 					      NET_CONTEXT_CONNECTED);
@@ -1944,6 +2707,7 @@ next_state:
 
 		if (th && net_tcp_seq_cmp(th_ack(th), conn->seq) > 0) {
 			uint32_t len_acked = th_ack(th) - conn->seq;
+			uint32_t flight = conn->unacked_len;
 
 			NET_DBG("conn: %p len_acked=%u", conn, len_acked);
 
@@ -1968,6 +2732,9 @@ next_state:
 			conn_seq(conn, + len_acked);
 			net_stats_update_tcp_seg_recv(conn->iface);
 
+			tcp_rtt_ack(conn, th_ack(th));
+			tcp_cc_ack(conn, len_acked, flight);
+
 			conn_send_data_dump(conn);
 
 			if (!k_work_delayable_remaining_get(
@@ -1999,6 +2766,11 @@ next_state:
 				conn_state(conn, TCP_CLOSED);
 				break;
 			}
+		} else if (th && th_ack(th) == conn->seq && len == 0 &&
+			   (th_flags(th) & ACK) &&
+			   conn->send_win == prev_send_win) {
+			/* Duplicate ACK, RFC 5681 chapter 2 */
+			tcp_cc_dup_ack(conn);
 		}
 
 		if (th) {
@@ -2153,7 +2925,7 @@ int net_tcp_put(struct net_context *context)
 			 */
 			k_work_reschedule_for_queue(&tcp_work_q,
 						    &conn->send_data_timer,
-						    K_MSEC(tcp_rto));
+						    K_MSEC(conn->rtt.rto));
 		} else {
 			int ret;
 
@@ -2203,7 +2975,7 @@ int net_tcp_update_recv_wnd(struct net_context *context, int32_t delta)
 	}
 
 	new_win = ((struct tcp *)context->tcp)->recv_win + delta;
-	if (new_win < 0 || new_win > UINT16_MAX) {
+	if (new_win < 0 || new_win > TCP_MAX_RECV_WIN) {
 		return -EINVAL;
 	}
 
@@ -2212,6 +2984,42 @@ int net_tcp_update_recv_wnd(struct net_context *context, int32_t delta)
 	return 0;
 }
 
+int net_tcp_set_congestion(struct net_context *context, const char *name)
+{
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+	struct tcp *conn = context->tcp;
+	const struct tcp_cc_ops *ops;
+	int ret = 0;
+
+	if (!conn) {
+		return -ENOENT;
+	}
+
+	ops = tcp_cc_find(name);
+	if (!ops) {
+		return -ENOENT;
+	}
+
+	k_mutex_lock(&conn->lock, K_FOREVER);
+
+	if (conn->state == TCP_LISTEN || conn->state == TCP_SYN_SENT ||
+	    conn->state == TCP_SYN_RECEIVED) {
+		conn->cc.ops = ops;
+	} else {
+		ret = -EISCONN;
+	}
+
+	k_mutex_unlock(&conn->lock);
+
+	return ret;
+#else
+	ARG_UNUSED(context);
+	ARG_UNUSED(name);
+
+	return -ENOTSUP;
+#endif
+}
+
 /* net_context queues the outgoing data for the TCP connection */
 int net_tcp_queue_data(struct net_context *context, struct net_pkt *pkt)
 {
@@ -2898,6 +3706,19 @@ uint16_t net_tcp_get_recv_mss(const struct tcp *conn)
 	return 0;
 }
 
+void net_tcp_get_rtt_stats(const struct tcp *conn,
+			   struct net_tcp_rtt_stats *stats)
+{
+	const struct tcp_rtt *rtt = &conn->rtt;
+
+	stats->srtt = rtt->srtt >> TCP_RTT_SHIFT;
+	stats->rttvar = rtt->rttvar >> TCP_RTT_SHIFT;
+	stats->rto = rtt->rto;
+	stats->last = rtt->last;
+	stats->min = rtt->min;
+	stats->samples = rtt->samples;
+}
+
 const char *net_tcp_state_str(enum tcp_state state)
 {
 	return tcp_state_to_str(state, false);
@@ -97,6 +97,21 @@ int net_tcp_queue(struct net_context *context, const void *buf, size_t len,
 		  const struct msghdr *msghdr);
 /* TODO: split into 2 functions, conn -> context, queue -> send? */
 
+/**
+ * @brief Select the congestion control algorithm of a connection
+ *
+ * Must be called before the connection is established. Connections
+ * accepted from a listening context use the default algorithm.
+ *
+ * @param context	Network context
+ * @param name		Algorithm name, e.g. "newreno" or "cubic"
+ *
+ * @return 0 if ok, -ENOENT if the algorithm is not available,
+ *         -EISCONN if the connection is already established,
+ *         -ENOTSUP if congestion control is disabled
+ */
+int net_tcp_set_congestion(struct net_context *context, const char *name);
+
 /* The following functions are provided solely for the compatibility
  * with the old TCP
  */
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/** @file
+ * @brief TCP congestion control algorithms
+ *
+ * This is not to be included by the application.
+ */
+
+#ifndef __TCP_CC_H
+#define __TCP_CC_H
+
+#include <zephyr.h>
+
+#include "tcp_internal.h"
+
+/* Growth of the congestion window is delegated to an algorithm. The TCP
+ * core handles slow start, duplicate ACK counting, fast retransmit and
+ * NewReno fast recovery (RFC 5681, RFC 6582) for all of them.
+ */
+struct tcp_cc_ops {
+	/* Name used to select the algorithm */
+	const char *name;
+
+	/* Optional, called when the connection is established, after the
+	 * core has set the initial window. The private data is zeroed.
+	 */
+	void (*init)(struct tcp *conn);
+
+	/* Returns the new slow start threshold when a loss is detected
+	 * by duplicate ACKs or a retransmission timeout.
+	 */
+	uint32_t (*ssthresh)(struct tcp *conn);
+
+	/* Grows cwnd in congestion avoidance, i.e. when cwnd >= ssthresh
+	 * and no recovery is ongoing. acked is the number of bytes
+	 * newly acknowledged.
+	 */
+	void (*cong_avoid)(struct tcp *conn, uint32_t acked);
+};
+
+#define TCP_CC_GET_NAME(cc_name) (tcp_cc_##cc_name)
+
+#define TCP_CC_REGISTER(cc_name, init_func, ssthresh_func, cong_avoid_func) \
+	static const STRUCT_SECTION_ITERABLE(tcp_cc_ops,		\
+					TCP_CC_GET_NAME(cc_name)) = {	\
+		.name = #cc_name,					\
+		.init = init_func,					\
+		.ssthresh = ssthresh_func,				\
+		.cong_avoid = cong_avoid_func,				\
+	}
+
+/* Private data of the algorithm of a connection */
+#define tcp_cc_priv(_conn, _type)					\
+({									\
+	BUILD_ASSERT(sizeof(_type) <= sizeof((_conn)->cc.priv),		\
+		     "tcp_cc private data too large");			\
+	(_type *)(_conn)->cc.priv;					\
+})
+
+#endif /* __TCP_CC_H */
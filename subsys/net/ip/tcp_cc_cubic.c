@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* CUBIC congestion avoidance, RFC 8312.
+ *
+ * Windows are kept in bytes and time in milliseconds. The target is the
+ * window one smoothed RTT ahead, and the Reno-friendly estimate is grown
+ * per ACK as in RFC 8312bis.
+ */
+
+#include "tcp_cc.h"
+
+/* beta_cubic = 0.7 and alpha = 3 * (1 - beta) / (1 + beta), scaled by 1024 */
+#define CUBIC_BETA 717U
+#define CUBIC_ALPHA 542U
+#define CUBIC_SCALE 1024U
+
+/* Bound |t - K| so that its cube fits the 64-bit arithmetic below */
+#define CUBIC_MAX_DELTA_MS 100000U
+
+struct cubic {
+	uint32_t w_max;		/* cwnd before the last reduction */
+	uint32_t w_est;		/* Reno-friendly window estimate */
+	uint32_t origin;	/* plateau of the cubic function */
+	uint32_t epoch_start;	/* start of the current epoch, 0 if none */
+	uint32_t k;		/* time from the epoch start to the plateau */
+};
+
+static uint32_t cubic_root(uint64_t a)
+{
+	uint64_t b;
+	uint32_t x = 0U;
+
+	for (int s = 63; s >= 0; s -= 3) {
+		x <<= 1;
+		b = 3U * (uint64_t)x * (x + 1U) + 1U;
+		if ((a >> s) >= b) {
+			a -= b << s;
+			x++;
+		}
+	}
+
+	return x;
+}
+
+/* K = cbrt((W_max - cwnd) / C) seconds with C = 0.4, in milliseconds */
+static uint32_t cubic_k(uint32_t bytes, uint16_t mss)
+{
+	return cubic_root((uint64_t)bytes * 2500000000ULL / mss);
+}
+
+/* W_cubic(t) = C * (t - K)^3 + W_max */
+static uint32_t cubic_window(struct cubic *c, uint32_t t, uint16_t mss)
+{
+	uint32_t delta = t > c->k ? t - c->k : c->k - t;
+	uint64_t offs;
+
+	delta = MIN(delta, CUBIC_MAX_DELTA_MS);
+
+	/* C * delta^3 / 1000^3 segments, scaled by 1024 */
+	offs = (uint64_t)delta * delta * delta * 2U * CUBIC_SCALE /
+		5000000000ULL;
+	offs = offs * mss / CUBIC_SCALE;
+
+	if (t > c->k) {
+		return (uint32_t)MIN(c->origin + offs, UINT32_MAX);
+	}
+
+	return offs < c->origin ? c->origin - (uint32_t)offs : mss;
+}
+
+static void cubic_init(struct tcp *conn)
+{
+	struct cubic *c = tcp_cc_priv(conn, struct cubic);
+
+	c->w_max = conn->cc.cwnd;
+}
+
+static uint32_t cubic_ssthresh(struct tcp *conn)
+{
+	struct cubic *c = tcp_cc_priv(conn, struct cubic);
+	uint32_t cwnd = conn->cc.cwnd;
+
+	c->epoch_start = 0U;
+
+	/* Fast convergence: release bandwidth to newer flows */
+	if (cwnd < c->w_max) {
+		c->w_max = (uint32_t)((uint64_t)cwnd * (CUBIC_SCALE + CUBIC_BETA) /
+				      (2U * CUBIC_SCALE));
+	} else {
+		c->w_max = cwnd;
+	}
+
+	return MAX((uint32_t)((uint64_t)cwnd * CUBIC_BETA / CUBIC_SCALE),
+		   2U * conn_mss(conn));
+}
+
+static void cubic_cong_avoid(struct tcp *conn, uint32_t acked)
+{
+	struct cubic *c = tcp_cc_priv(conn, struct cubic);
+	uint16_t mss = conn_mss(conn);
+	uint32_t cwnd = conn->cc.cwnd;
+	uint32_t now = k_uptime_get_32() | 1U;
+	uint32_t target;
+	uint64_t inc;
+
+	if (c->epoch_start == 0U) {
+		c->epoch_start = now;
+		c->w_est = cwnd;
+		conn->cc.bytes_acked = 0U;
+
+		if (cwnd < c->w_max) {
+			c->k = cubic_k(c->w_max - cwnd, mss);
+			c->origin = c->w_max;
+		} else {
+			c->k = 0U;
+			c->origin = cwnd;
+		}
+	}
+
+	target = cubic_window(c, now - c->epoch_start +
+			     (conn->rtt.srtt >> TCP_RTT_SHIFT), mss);
+
+	c->w_est += (uint32_t)((uint64_t)acked * mss * CUBIC_ALPHA /
+			       ((uint64_t)CUBIC_SCALE * cwnd));
+	if (c->w_est > target) {
+		/* Reno-friendly region */
+		target = c->w_est;
+	}
+
+	/* At most 1.5 * cwnd per RTT */
+	target = MIN(target, cwnd + cwnd / 2U);
+	if (target <= cwnd) {
+		return;
+	}
+
+	/* cwnd grows by (target - cwnd) / cwnd segments per segment acked,
+	 * the remainder is carried over in bytes_acked.
+	 */
+	inc = (uint64_t)(target - cwnd) * acked + conn->cc.bytes_acked;
+	conn->cc.cwnd += (uint32_t)(inc / cwnd);
+	conn->cc.bytes_acked = (uint32_t)(inc % cwnd);
+}
+
+TCP_CC_REGISTER(cubic, cubic_init, cubic_ssthresh, cubic_cong_avoid);
@@ -0,0 +1,32 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* NewReno congestion avoidance, RFC 5681 and RFC 6582. Slow start and
+ * fast recovery are done by the TCP core.
+ */
+
+#include "tcp_cc.h"
+
+/* RFC 5681, equation (4) */
+static uint32_t newreno_ssthresh(struct tcp *conn)
+{
+	return MAX((uint32_t)conn->unacked_len / 2U, 2U * conn_mss(conn));
+}
+
+/* Grow cwnd by one MSS per window of acknowledged data, counting bytes
+ * rather than ACKs as recommended by RFC 3465.
+ */
+static void newreno_cong_avoid(struct tcp *conn, uint32_t acked)
+{
+	conn->cc.bytes_acked += acked;
+
+	if (conn->cc.bytes_acked >= conn->cc.cwnd) {
+		conn->cc.bytes_acked -= conn->cc.cwnd;
+		conn->cc.cwnd += conn_mss(conn);
+	}
+}
+
+TCP_CC_REGISTER(newreno, NULL, newreno_ssthresh, newreno_cong_avoid);
@@ -67,6 +67,34 @@ static inline enum tcp_state net_tcp_get_state(const struct tcp *conn)
 }
 #endif
 
+/** Round-trip time statistics of a TCP connection, in milliseconds */
+struct net_tcp_rtt_stats {
+	uint32_t srtt;		/**< Smoothed round-trip time */
+	uint32_t rttvar;	/**< Round-trip time variation */
+	uint32_t rto;		/**< Current retransmission timeout */
+	uint32_t last;		/**< Last measured round-trip time */
+	uint32_t min;		/**< Smallest measured round-trip time */
+	uint32_t samples;	/**< Number of measurements */
+};
+
+/**
+ * @brief Obtains the round-trip time statistics for a TCP context
+ *
+ * @param tcp TCP context
+ * @param stats Statistics are returned here
+ */
+#if defined(CONFIG_NET_NATIVE_TCP)
+void net_tcp_get_rtt_stats(const struct tcp *conn,
+			   struct net_tcp_rtt_stats *stats);
+#else
+static inline void net_tcp_get_rtt_stats(const struct tcp *conn,
+					 struct net_tcp_rtt_stats *stats)
+{
+	ARG_UNUSED(conn);
+	memset(stats, 0, sizeof(*stats));
+}
+#endif
+
 /**
  * @brief Go through all the TCP connections and call callback
  * for each of them.
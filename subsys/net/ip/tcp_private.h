@@ -125,7 +125,7 @@
 #define conn_send_data_dump(_conn)                                             \
 	({                                                                     \
 		NET_DBG("conn: %p total=%zd, unacked_len=%d, "                 \
-			"send_win=%hu, mss=%hu",                               \
+			"send_win=%u, mss=%hu",                                \
 			(_conn), net_pkt_get_len((_conn)->send_data),          \
 			_conn->unacked_len, _conn->send_win,                   \
 			(uint16_t)conn_mss((_conn)));                          \
@@ -172,10 +172,6 @@ enum th_flags {
 	CWR = BIT(7),
 };
 
-struct tcp_mss_option {
-	uint32_t option;
-};
-
 enum tcp_state {
 	TCP_LISTEN = 1,
 	TCP_SYN_SENT,
@@ -206,18 +202,87 @@ union tcp_endpoint {
 #define NET_TCP_NOP_OPT          1
 #define NET_TCP_MSS_OPT          2
 #define NET_TCP_WINDOW_SCALE_OPT 3
+#define NET_TCP_SACK_PERM_OPT    4
+#define NET_TCP_SACK_OPT         5
+#define NET_TCP_TIMESTAMP_OPT    8
 
 /* TCP Option sizes */
 #define NET_TCP_END_SIZE          1
 #define NET_TCP_NOP_SIZE          1
 #define NET_TCP_MSS_SIZE          4
 #define NET_TCP_WINDOW_SCALE_SIZE 3
+#define NET_TCP_SACK_PERM_SIZE    2
+#define NET_TCP_SACK_BLOCK_SIZE   8
+#define NET_TCP_TIMESTAMP_SIZE    10
+
+/* Largest window shift allowed by RFC 7323 */
+#define NET_TCP_MAX_WINDOW_SCALE  14
+
+struct tcp_sack_block {
+	uint32_t start;
+	uint32_t end;
+};
+
+/* A SACK option carries at most four blocks */
+#define TCP_SACK_MAX_BLOCKS 4
 
 struct tcp_options {
 	uint16_t mss;
-	uint16_t window;
+	uint16_t window;	/* window shift */
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	uint32_t tsval;
+	uint32_t tsecr;
+#endif
+#if defined(CONFIG_NET_TCP_SACK)
+	struct tcp_sack_block sack[TCP_SACK_MAX_BLOCKS];
+	uint8_t sack_count;
+#endif
 	bool mss_found : 1;
 	bool wnd_found : 1;
+	bool sack_perm_found : 1;
+	bool ts_found : 1;
+};
+
+#if defined(CONFIG_NET_TCP_SACK)
+/* SACKed ranges remembered by the sender */
+#define TCP_SACK_SCOREBOARD_SIZE 4
+#endif
+
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+struct tcp_cc_ops;
+
+/* Words reserved in each connection for the congestion control algorithm */
+#define TCP_CC_PRIV_WORDS 5
+
+/* Congestion control state of a connection, RFC 5681 and RFC 6582 */
+struct tcp_cc {
+	const struct tcp_cc_ops *ops;
+	uint32_t cwnd;		/* congestion window, in bytes */
+	uint32_t ssthresh;	/* slow start threshold, in bytes */
+	uint32_t recover;	/* highest seq sent when recovery started */
+	uint32_t bytes_acked;	/* acked bytes not yet added to cwnd */
+	uint32_t priv[TCP_CC_PRIV_WORDS];
+	uint8_t dup_acks;
+	bool in_recovery : 1;
+};
+#endif
+
+/* The smoothed round-trip time and its variation are kept in units of
+ * 1/8 ms, as the gains used to update them are 1/8 and 1/4.
+ */
+#define TCP_RTT_SHIFT 3
+
+/* Round-trip time estimation and retransmission timeout, RFC 6298 */
+struct tcp_rtt {
+	uint32_t srtt;		/* smoothed round-trip time */
+	uint32_t rttvar;	/* round-trip time variation */
+	uint32_t rto;		/* retransmission timeout in ms, with backoff */
+	uint32_t last;		/* last measured round-trip time in ms */
+	uint32_t min;		/* smallest measured round-trip time in ms */
+	uint32_t samples;	/* number of measurements */
+	uint32_t seq;		/* end of the segment being timed */
+	uint32_t start;		/* when the timed segment was sent */
+	bool timing : 1;	/* a segment is being timed */
 };
 
 struct tcp { /* TCP connection */
@@ -237,6 +302,21 @@ struct tcp { /* TCP connection */
 	struct k_fifo recv_data;  /* temp queue before passing data to app */
 	struct tcp_options recv_options;
 	struct tcp_options send_options;
+	struct tcp_rtt rtt;
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+	struct tcp_cc cc;
+#endif
+#if defined(CONFIG_NET_TCP_SACK)
+	/* Sender scoreboard, data above seq the peer has selectively
+	 * acknowledged, sorted and without overlaps.
+	 */
+	struct tcp_sack_block sacked[TCP_SACK_SCOREBOARD_SIZE];
+	uint32_t high_rxt;	/* end of the last retransmission in recovery */
+	uint8_t sacked_count;
+#endif
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	uint32_t ts_recent;	/* peer's timestamp to echo */
+#endif
 	struct k_work_delayable send_timer;
 	struct k_work_delayable recv_queue_timer;
 	struct k_work_delayable send_data_timer;
@@ -259,12 +339,18 @@ struct tcp { /* TCP connection */
 	enum tcp_data_mode data_mode;
 	uint32_t seq;
 	uint32_t ack;
-	uint16_t recv_win;
-	uint16_t send_win;
+	uint32_t recv_win;
+	uint32_t send_win;
 	uint8_t send_data_retries;
+	uint8_t rcv_wscale;	/* shift of the window we advertise */
+	uint8_t snd_wscale;	/* shift of the window the peer advertises */
 	bool in_retransmission : 1;
 	bool in_connect : 1;
 	bool in_close : 1;
+	/* Options offered in our SYN, or in use once negotiated */
+	bool wscale_ok : 1;
+	bool sack_ok : 1;
+	bool ts_ok : 1;
 };
 
 #define _flags(_fl, _op, _mask, _cond)					\
@@ -298,6 +298,18 @@ static ssize_t sock_dispatch_recvfrom_vmeth(void *obj, void *buf,
 	return zsock_recvfrom(fd, buf, max_len, flags, addr, addrlen);
 }
 
+static ssize_t sock_dispatch_recvmsg_vmeth(void *obj, struct msghdr *msg,
+					   int flags)
+{
+	int fd = sock_dispatch_default(obj);
+
+	if (fd < 0) {
+		return -1;
+	}
+
+	return zsock_recvmsg(fd, msg, flags);
+}
+
 static int sock_dispatch_getsockopt_vmeth(void *obj, int level, int optname,
 					  void *optval, socklen_t *optlen)
 {
@@ -420,6 +432,7 @@ static const struct socket_op_vtable sock_dispatch_fd_op_vtable = {
 	.accept = sock_dispatch_accept_vmeth,
 	.sendto = sock_dispatch_sendto_vmeth,
 	.sendmsg = sock_dispatch_sendmsg_vmeth,
+	.recvmsg = sock_dispatch_recvmsg_vmeth,
 	.recvfrom = sock_dispatch_recvfrom_vmeth,
 	.getsockopt = sock_dispatch_getsockopt_vmeth,
 	.setsockopt = sock_dispatch_setsockopt_vmeth,
@@ -54,6 +54,11 @@ LOG_MODULE_REGISTER(net_sock, CONFIG_NET_SOCKETS_LOG_LEVEL);
 		return ret;				     \
 	} while (0)
 
+/* Most iovec entries a message passed from user mode may have, as
+ * UIO_MAXIOV on Linux.
+ */
+#define ZSOCK_USER_IOV_MAX 1024
+
 const struct socket_op_vtable sock_fd_op_vtable;
 
 static inline void *get_sock_vtable(int sock,
@@ -803,92 +808,207 @@ ssize_t z_impl_zsock_sendmsg(int sock, const struct msghdr *msg, int flags)
 }
 
 #ifdef CONFIG_USERSPACE
-static inline ssize_t z_vrfy_zsock_sendmsg(int sock,
-					   const struct msghdr *msg,
-					   int flags)
+static void sendmsg_user_free(struct msghdr *msg)
 {
-	struct msghdr msg_copy;
 	size_t i;
-	int ret;
 
-	Z_OOPS(z_user_from_copy(&msg_copy, (void *)msg, sizeof(msg_copy)));
+	k_free(msg->msg_name);
+	k_free(msg->msg_control);
+
+	if (msg->msg_iov) {
+		for (i = 0; i < msg->msg_iovlen; i++) {
+			k_free(msg->msg_iov[i].iov_base);
+		}
+
+		k_free(msg->msg_iov);
+	}
+}
+
+/* Replaces the buffers of a message to be sent from user mode, whose
+ * header has already been copied, with kernel copies.  Nothing is left
+ * allocated on failure.
+ */
+static int sendmsg_user_copy(struct msghdr *msg)
+{
+	struct iovec *user_iov = msg->msg_iov;
+	void *user_name = msg->msg_name;
+	void *user_control = msg->msg_control;
+	size_t iovlen = msg->msg_iovlen;
+	size_t iov_size;
 
-	msg_copy.msg_name = NULL;
-	msg_copy.msg_control = NULL;
+	msg->msg_name = NULL;
+	msg->msg_control = NULL;
+	msg->msg_iov = NULL;
+	msg->msg_iovlen = 0;
 
-	msg_copy.msg_iov = z_user_alloc_from_copy(msg->msg_iov,
-				       msg->msg_iovlen * sizeof(struct iovec));
-	if (!msg_copy.msg_iov) {
+	if (iovlen > ZSOCK_USER_IOV_MAX ||
+	    size_mul_overflow(iovlen, sizeof(struct iovec), &iov_size)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	msg->msg_iov = z_user_alloc_from_copy(user_iov, iov_size);
+	if (!msg->msg_iov) {
 		errno = ENOMEM;
-		goto fail;
+		return -1;
 	}
 
-	for (i = 0; i < msg->msg_iovlen; i++) {
-		msg_copy.msg_iov[i].iov_base =
-			z_user_alloc_from_copy(msg->msg_iov[i].iov_base,
-					       msg->msg_iov[i].iov_len);
-		if (!msg_copy.msg_iov[i].iov_base) {
+	/* msg_iovlen counts the buffers copied so far */
+	while (msg->msg_iovlen < iovlen) {
+		struct iovec *iov = &msg->msg_iov[msg->msg_iovlen];
+
+		iov->iov_base = z_user_alloc_from_copy(iov->iov_base,
+						       iov->iov_len);
+		if (!iov->iov_base) {
 			errno = ENOMEM;
 			goto fail;
 		}
 
-		msg_copy.msg_iov[i].iov_len = msg->msg_iov[i].iov_len;
+		msg->msg_iovlen++;
 	}
 
 	if (msg->msg_namelen > 0) {
-		msg_copy.msg_name = z_user_alloc_from_copy(msg->msg_name,
-							   msg->msg_namelen);
-		if (!msg_copy.msg_name) {
+		msg->msg_name = z_user_alloc_from_copy(user_name,
+						       msg->msg_namelen);
+		if (!msg->msg_name) {
 			errno = ENOMEM;
 			goto fail;
 		}
 	}
 
 	if (msg->msg_controllen > 0) {
-		msg_copy.msg_control = z_user_alloc_from_copy(msg->msg_control,
+		msg->msg_control = z_user_alloc_from_copy(user_control,
 							  msg->msg_controllen);
-		if (!msg_copy.msg_control) {
+		if (!msg->msg_control) {
 			errno = ENOMEM;
 			goto fail;
 		}
 	}
 
+	return 0;
+
+fail:
+	sendmsg_user_free(msg);
+
+	return -1;
+}
+
+static inline ssize_t z_vrfy_zsock_sendmsg(int sock,
+					   const struct msghdr *msg,
+					   int flags)
+{
+	struct msghdr msg_copy;
+	ssize_t ret;
+
+	Z_OOPS(z_user_from_copy(&msg_copy, (void *)msg, sizeof(msg_copy)));
+
+	if (sendmsg_user_copy(&msg_copy) < 0) {
+		return -1;
+	}
+
 	ret = z_impl_zsock_sendmsg(sock, (const struct msghdr *)&msg_copy,
 				   flags);
 
-	k_free(msg_copy.msg_name);
-	k_free(msg_copy.msg_control);
+	sendmsg_user_free(&msg_copy);
+
+	return ret;
+}
+#include <syscalls/zsock_sendmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+int z_impl_zsock_sendmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen,
+			  int flags)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	unsigned int i;
+	ssize_t ret;
+	void *obj;
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
+	}
 
-	for (i = 0; i < msg_copy.msg_iovlen; i++) {
-		k_free(msg_copy.msg_iov[i].iov_base);
+	if (vtable->sendmsg == NULL) {
+		errno = EOPNOTSUPP;
+		return -1;
 	}
 
-	k_free(msg_copy.msg_iov);
+	/* Look up and lock the socket only once for the whole batch */
+	(void)k_mutex_lock(lock, K_FOREVER);
 
-	return ret;
+	for (i = 0; i < vlen; i++) {
+		ret = vtable->sendmsg(obj, &msgvec[i].msg_hdr, flags);
+		if (ret < 0) {
+			break;
+		}
 
-fail:
-	if (msg_copy.msg_name) {
-		k_free(msg_copy.msg_name);
+		msgvec[i].msg_len = ret;
 	}
 
-	if (msg_copy.msg_control) {
-		k_free(msg_copy.msg_control);
+	k_mutex_unlock(lock);
+
+	/* An error is only reported if nothing was sent */
+	if (i == 0 && vlen > 0) {
+		return -1;
 	}
 
-	if (msg_copy.msg_iov) {
-		for (i = 0; i < msg_copy.msg_iovlen; i++) {
-			if (msg_copy.msg_iov[i].iov_base) {
-				k_free(msg_copy.msg_iov[i].iov_base);
-			}
+	return (int)i;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_sendmmsg(int sock, struct mmsghdr *msgvec,
+					unsigned int vlen, int flags)
+{
+	struct mmsghdr *vec_copy;
+	unsigned int i, count;
+	bool fault = false;
+	int ret;
+
+	/* Longer batches are cut short, as on Linux */
+	vlen = MIN(vlen, ZSOCK_USER_IOV_MAX);
+	if (vlen == 0) {
+		return z_impl_zsock_sendmmsg(sock, NULL, 0, flags);
+	}
+
+	vec_copy = z_user_alloc_from_copy(msgvec,
+					  vlen * sizeof(struct mmsghdr));
+	if (!vec_copy) {
+		errno = ENOMEM;
+		return -1;
+	}
+
+	/* Copy the whole batch first, so that the socket is locked only
+	 * once.  The messages before one that can't be copied are sent.
+	 */
+	for (count = 0; count < vlen; count++) {
+		if (sendmsg_user_copy(&vec_copy[count].msg_hdr) < 0) {
+			break;
+		}
+	}
+
+	ret = (count > 0) ? z_impl_zsock_sendmmsg(sock, vec_copy, count, flags)
+			  : -1;
+
+	for (i = 0; i < count; i++) {
+		if ((int)i < ret) {
+			fault |= z_user_to_copy(&msgvec[i].msg_len,
+						&vec_copy[i].msg_len,
+						sizeof(vec_copy[i].msg_len)) != 0;
 		}
 
-		k_free(msg_copy.msg_iov);
+		sendmsg_user_free(&vec_copy[i].msg_hdr);
 	}
 
-	return -1;
+	k_free(vec_copy);
+
+	Z_OOPS(fault);
+
+	return ret;
 }
-#include <syscalls/zsock_sendmsg_mrsh.c>
+#include <syscalls/zsock_sendmmsg_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
 static int sock_get_pkt_src_addr(struct net_pkt *pkt,
@@ -1045,17 +1165,13 @@ int zsock_wait_data(struct net_context *ctx, k_timeout_t *timeout)
 	return 0;
 }
 
-static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
-				       void *buf,
-				       size_t max_len,
-				       int flags,
-				       struct sockaddr *src_addr,
-				       socklen_t *addrlen)
+/* Returns the next datagram of the queue, the packet stays queued if
+ * ZSOCK_MSG_PEEK is set. errno is set if there is none.
+ */
+static struct net_pkt *zsock_recv_dgram_pkt(struct net_context *ctx,
+					    int flags)
 {
 	k_timeout_t timeout = K_FOREVER;
-	size_t recv_len = 0;
-	size_t read_len;
-	struct net_pkt_cursor backup;
 	struct net_pkt *pkt;
 
 	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
@@ -1068,7 +1184,7 @@ static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
 		ret = zsock_wait_data(ctx, &timeout);
 		if (ret < 0) {
 			errno = -ret;
-			return -1;
+			return NULL;
 		}
 	}
 
@@ -1079,7 +1195,7 @@ static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
 		/* EAGAIN when timeout expired, EINTR when cancelled */
 		if (res && res != -EAGAIN && res != -EINTR) {
 			errno = -res;
-			return -1;
+			return NULL;
 		}
 
 		pkt = k_fifo_peek_head(&ctx->recv_q);
@@ -1089,50 +1205,93 @@ static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
 
 	if (!pkt) {
 		errno = EAGAIN;
-		return -1;
 	}
 
-	net_pkt_cursor_backup(pkt, &backup);
-
-	if (src_addr && addrlen) {
-		if (IS_ENABLED(CONFIG_NET_OFFLOAD) &&
-		    net_if_is_ip_offloaded(net_context_get_iface(ctx))) {
-			/*
-			 * Packets from offloaded IP stack do not have IP
-			 * headers, so src address cannot be figured out at this
-			 * point. The best we can do is returning remote address
-			 * if that was set using connect() call.
-			 */
-			if (ctx->flags & NET_CONTEXT_REMOTE_ADDR_SET) {
-				memcpy(src_addr, &ctx->remote,
-				       MIN(*addrlen, sizeof(ctx->remote)));
-			} else {
-				errno = ENOTSUP;
-				goto fail;
-			}
-		} else {
-			int rv;
-
-			rv = sock_get_pkt_src_addr(pkt, net_context_get_ip_proto(ctx),
-						   src_addr, *addrlen);
-			if (rv < 0) {
-				errno = -rv;
-				LOG_ERR("sock_get_pkt_src_addr %d", rv);
-				goto fail;
-			}
-		}
+	return pkt;
+}
 
-		/* addrlen is a value-result argument, set to actual
-		 * size of source address
+static int zsock_recv_dgram_src(struct net_context *ctx, struct net_pkt *pkt,
+				struct sockaddr *src_addr, socklen_t *addrlen)
+{
+	if (IS_ENABLED(CONFIG_NET_OFFLOAD) &&
+	    net_if_is_ip_offloaded(net_context_get_iface(ctx))) {
+		/*
+		 * Packets from offloaded IP stack do not have IP
+		 * headers, so src address cannot be figured out at this
+		 * point. The best we can do is returning remote address
+		 * if that was set using connect() call.
 		 */
-		if (src_addr->sa_family == AF_INET) {
-			*addrlen = sizeof(struct sockaddr_in);
-		} else if (src_addr->sa_family == AF_INET6) {
-			*addrlen = sizeof(struct sockaddr_in6);
+		if (ctx->flags & NET_CONTEXT_REMOTE_ADDR_SET) {
+			memcpy(src_addr, &ctx->remote,
+			       MIN(*addrlen, sizeof(ctx->remote)));
 		} else {
 			errno = ENOTSUP;
-			goto fail;
+			return -1;
 		}
+	} else {
+		int rv;
+
+		rv = sock_get_pkt_src_addr(pkt, net_context_get_ip_proto(ctx),
+					   src_addr, *addrlen);
+		if (rv < 0) {
+			errno = -rv;
+			LOG_ERR("sock_get_pkt_src_addr %d", rv);
+			return -1;
+		}
+	}
+
+	/* addrlen is a value-result argument, set to actual
+	 * size of source address
+	 */
+	if (src_addr->sa_family == AF_INET) {
+		*addrlen = sizeof(struct sockaddr_in);
+	} else if (src_addr->sa_family == AF_INET6) {
+		*addrlen = sizeof(struct sockaddr_in6);
+	} else {
+		errno = ENOTSUP;
+		return -1;
+	}
+
+	return 0;
+}
+
+static void zsock_recv_dgram_done(struct net_pkt *pkt, int flags,
+				  struct net_pkt_cursor *backup)
+{
+	if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS) &&
+	    !(flags & ZSOCK_MSG_PEEK)) {
+		net_socket_update_tc_rx_time(pkt, k_cycle_get_32());
+	}
+
+	if (!(flags & ZSOCK_MSG_PEEK)) {
+		net_pkt_unref(pkt);
+	} else {
+		net_pkt_cursor_restore(pkt, backup);
+	}
+}
+
+static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
+				       void *buf,
+				       size_t max_len,
+				       int flags,
+				       struct sockaddr *src_addr,
+				       socklen_t *addrlen)
+{
+	size_t recv_len = 0;
+	size_t read_len;
+	struct net_pkt_cursor backup;
+	struct net_pkt *pkt;
+
+	pkt = zsock_recv_dgram_pkt(ctx, flags);
+	if (!pkt) {
+		return -1;
+	}
+
+	net_pkt_cursor_backup(pkt, &backup);
+
+	if (src_addr && addrlen &&
+	    zsock_recv_dgram_src(ctx, pkt, src_addr, addrlen) < 0) {
+		goto fail;
 	}
 
 	recv_len = net_pkt_remaining_data(pkt);
@@ -1143,17 +1302,63 @@ static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
 		goto fail;
 	}
 
-	if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS) &&
-	    !(flags & ZSOCK_MSG_PEEK)) {
-		net_socket_update_tc_rx_time(pkt, k_cycle_get_32());
-	}
+	zsock_recv_dgram_done(pkt, flags, &backup);
+
+	return (flags & ZSOCK_MSG_TRUNC) ? recv_len : read_len;
 
+fail:
 	if (!(flags & ZSOCK_MSG_PEEK)) {
 		net_pkt_unref(pkt);
-	} else {
-		net_pkt_cursor_restore(pkt, &backup);
 	}
 
+	return -1;
+}
+
+static inline ssize_t zsock_recvmsg_dgram(struct net_context *ctx,
+					  struct msghdr *msg,
+					  int flags)
+{
+	size_t read_len = 0;
+	size_t recv_len;
+	struct net_pkt_cursor backup;
+	struct net_pkt *pkt;
+	size_t i;
+
+	pkt = zsock_recv_dgram_pkt(ctx, flags);
+	if (!pkt) {
+		return -1;
+	}
+
+	net_pkt_cursor_backup(pkt, &backup);
+
+	if (msg->msg_name && msg->msg_namelen > 0 &&
+	    zsock_recv_dgram_src(ctx, pkt, msg->msg_name,
+				 &msg->msg_namelen) < 0) {
+		goto fail;
+	}
+
+	msg->msg_controllen = 0;
+	msg->msg_flags = 0;
+
+	recv_len = net_pkt_remaining_data(pkt);
+
+	for (i = 0; i < msg->msg_iovlen && read_len < recv_len; i++) {
+		size_t len = MIN(msg->msg_iov[i].iov_len, recv_len - read_len);
+
+		if (net_pkt_read(pkt, msg->msg_iov[i].iov_base, len)) {
+			errno = ENOBUFS;
+			goto fail;
+		}
+
+		read_len += len;
+	}
+
+	if (read_len < recv_len) {
+		msg->msg_flags |= ZSOCK_MSG_TRUNC;
+	}
+
+	zsock_recv_dgram_done(pkt, flags, &backup);
+
 	return (flags & ZSOCK_MSG_TRUNC) ? recv_len : read_len;
 
 fail:
@@ -1345,6 +1550,389 @@ ssize_t z_vrfy_zsock_recvfrom(int sock, void *buf, size_t max_len, int flags,
 #include <syscalls/zsock_recvfrom_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+static inline ssize_t zsock_recvmsg_stream(struct net_context *ctx,
+					   struct msghdr *msg,
+					   int flags)
+{
+	ssize_t recv_len = 0;
+	size_t i;
+
+	msg->msg_controllen = 0;
+	msg->msg_flags = 0;
+
+	for (i = 0; i < msg->msg_iovlen; i++) {
+		size_t max_len = msg->msg_iov[i].iov_len;
+		ssize_t len;
+
+		if (max_len == 0) {
+			continue;
+		}
+
+		len = zsock_recv_stream(ctx, msg->msg_iov[i].iov_base,
+					max_len, flags);
+		if (len < 0) {
+			if (recv_len > 0) {
+				break;
+			}
+
+			return -1;
+		}
+
+		recv_len += len;
+
+		/* Peeking again would return the same data */
+		if ((size_t)len < max_len || (flags & ZSOCK_MSG_PEEK)) {
+			break;
+		}
+
+		/* Only wait for the first buffer, unless all of them are
+		 * to be filled.
+		 */
+		if (!(flags & ZSOCK_MSG_WAITALL)) {
+			flags |= ZSOCK_MSG_DONTWAIT;
+		}
+	}
+
+	return recv_len;
+}
+
+ssize_t zsock_recvmsg_ctx(struct net_context *ctx, struct msghdr *msg,
+			  int flags)
+{
+	enum net_sock_type sock_type = net_context_get_type(ctx);
+
+	if (sock_type == SOCK_DGRAM) {
+		return zsock_recvmsg_dgram(ctx, msg, flags);
+	} else if (sock_type == SOCK_STREAM) {
+		return zsock_recvmsg_stream(ctx, msg, flags);
+	} else {
+		__ASSERT(0, "Unknown socket type");
+	}
+
+	return 0;
+}
+
+ssize_t z_impl_zsock_recvmsg(int sock, struct msghdr *msg, int flags)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	ssize_t ret;
+	void *obj;
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	/* Not all socket types implement it, unlike recvfrom() */
+	if (vtable->recvmsg == NULL) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	ret = vtable->recvmsg(obj, msg, flags);
+
+	k_mutex_unlock(lock);
+
+	return ret;
+}
+
+#ifdef CONFIG_USERSPACE
+/* Replaces the iovec array of a message to be received from user mode,
+ * whose header has already been copied, with a kernel copy.  The data
+ * is written straight into the buffers of the caller, which are checked
+ * here.  Nothing is left allocated on failure.
+ */
+static int recvmsg_user_check(struct msghdr *msg)
+{
+	struct iovec *user_iov = msg->msg_iov;
+	size_t iov_size;
+	size_t i;
+
+	Z_OOPS(msg->msg_name &&
+	       Z_SYSCALL_MEMORY_WRITE(msg->msg_name, msg->msg_namelen));
+
+	if (msg->msg_iovlen > ZSOCK_USER_IOV_MAX ||
+	    size_mul_overflow(msg->msg_iovlen, sizeof(struct iovec),
+			      &iov_size)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	msg->msg_iov = z_user_alloc_from_copy(user_iov, iov_size);
+	if (msg->msg_iovlen > 0 && !msg->msg_iov) {
+		errno = ENOMEM;
+		return -1;
+	}
+
+	for (i = 0; i < msg->msg_iovlen; i++) {
+		if (Z_SYSCALL_MEMORY_WRITE(msg->msg_iov[i].iov_base,
+					   msg->msg_iov[i].iov_len)) {
+			k_free(msg->msg_iov);
+			errno = EFAULT;
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+static inline ssize_t z_vrfy_zsock_recvmsg(int sock, struct msghdr *msg,
+					   int flags)
+{
+	struct msghdr msg_copy;
+	struct iovec *user_iov;
+	void *user_control;
+	ssize_t ret;
+
+	Z_OOPS(z_user_from_copy(&msg_copy, (void *)msg, sizeof(msg_copy)));
+
+	user_iov = msg_copy.msg_iov;
+	user_control = msg_copy.msg_control;
+
+	if (recvmsg_user_check(&msg_copy) < 0) {
+		return -1;
+	}
+
+	ret = z_impl_zsock_recvmsg(sock, &msg_copy, flags);
+
+	k_free(msg_copy.msg_iov);
+
+	msg_copy.msg_iov = user_iov;
+	msg_copy.msg_control = user_control;
+
+	Z_OOPS(z_user_to_copy(msg, &msg_copy, sizeof(msg_copy)));
+
+	return ret;
+}
+#include <syscalls/zsock_recvmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+int z_impl_zsock_recvmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen,
+			  int flags)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	unsigned int i;
+	ssize_t ret;
+	void *obj;
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (vtable->recvmsg == NULL) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	for (i = 0; i < vlen; i++) {
+		ret = vtable->recvmsg(obj, &msgvec[i].msg_hdr, flags);
+		if (ret < 0) {
+			break;
+		}
+
+		msgvec[i].msg_len = ret;
+
+		/* Only wait for the first message */
+		flags |= ZSOCK_MSG_DONTWAIT;
+	}
+
+	k_mutex_unlock(lock);
+
+	if (i == 0 && vlen > 0) {
+		return -1;
+	}
+
+	return (int)i;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_recvmmsg(int sock, struct mmsghdr *msgvec,
+					unsigned int vlen, int flags)
+{
+	struct mmsghdr *vec_copy;
+	unsigned int i, count;
+	bool fault = false;
+	int ret;
+
+	/* Longer batches are cut short, as on Linux */
+	vlen = MIN(vlen, ZSOCK_USER_IOV_MAX);
+	if (vlen == 0) {
+		return z_impl_zsock_recvmmsg(sock, NULL, 0, flags);
+	}
+
+	vec_copy = z_user_alloc_from_copy(msgvec,
+					  vlen * sizeof(struct mmsghdr));
+	if (!vec_copy) {
+		errno = ENOMEM;
+		return -1;
+	}
+
+	/* Check the whole batch first, so that the socket is locked only
+	 * once.  Messages are received into the ones before a message
+	 * that fails the checks.
+	 */
+	for (count = 0; count < vlen; count++) {
+		if (recvmsg_user_check(&vec_copy[count].msg_hdr) < 0) {
+			break;
+		}
+	}
+
+	ret = (count > 0) ? z_impl_zsock_recvmmsg(sock, vec_copy, count, flags)
+			  : -1;
+
+	for (i = 0; i < count; i++) {
+		struct msghdr *hdr = &vec_copy[i].msg_hdr;
+
+		k_free(hdr->msg_iov);
+
+		if ((int)i >= ret) {
+			continue;
+		}
+
+		/* Only copy back what receiving updates, the header
+		 * still holds the kernel copy of the iovec array.
+		 */
+		fault |= z_user_to_copy(&msgvec[i].msg_hdr.msg_namelen,
+					&hdr->msg_namelen,
+					sizeof(hdr->msg_namelen)) != 0 ||
+			 z_user_to_copy(&msgvec[i].msg_hdr.msg_controllen,
+					&hdr->msg_controllen,
+					sizeof(hdr->msg_controllen)) != 0 ||
+			 z_user_to_copy(&msgvec[i].msg_hdr.msg_flags,
+					&hdr->msg_flags,
+					sizeof(hdr->msg_flags)) != 0 ||
+			 z_user_to_copy(&msgvec[i].msg_len,
+					&vec_copy[i].msg_len,
+					sizeof(vec_copy[i].msg_len)) != 0;
+	}
+
+	k_free(vec_copy);
+
+	Z_OOPS(fault);
+
+	return ret;
+}
+#include <syscalls/zsock_recvmmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+#if defined(CONFIG_NET_SOCKETS_RECV_ZERO_COPY)
+static ssize_t zsock_recvmsg_zc_ctx(struct net_context *ctx,
+				    struct msghdr *msg, int flags,
+				    struct net_pkt **ret_pkt)
+{
+	size_t read_len = 0;
+	size_t iovlen = 0;
+	size_t recv_len;
+	struct net_pkt *pkt;
+	struct net_buf *buf;
+	uint8_t *pos;
+
+	pkt = zsock_recv_dgram_pkt(ctx, flags);
+	if (!pkt) {
+		return -1;
+	}
+
+	/* A peeked packet stays queued, the caller gets a reference of its
+	 * own so that the release is the same in both cases.
+	 */
+	if (flags & ZSOCK_MSG_PEEK) {
+		net_pkt_ref(pkt);
+	}
+
+	if (msg->msg_name && msg->msg_namelen > 0 &&
+	    zsock_recv_dgram_src(ctx, pkt, msg->msg_name,
+				 &msg->msg_namelen) < 0) {
+		net_pkt_unref(pkt);
+		return -1;
+	}
+
+	msg->msg_controllen = 0;
+	msg->msg_flags = 0;
+
+	recv_len = net_pkt_remaining_data(pkt);
+	buf = pkt->cursor.buf;
+	pos = pkt->cursor.pos;
+
+	/* The cursor is left untouched, the data is only pointed at */
+	while (buf && read_len < recv_len) {
+		size_t len = MIN(buf->len - (pos - buf->data),
+				 recv_len - read_len);
+
+		if (len > 0) {
+			if (iovlen == msg->msg_iovlen) {
+				msg->msg_flags |= ZSOCK_MSG_TRUNC;
+				break;
+			}
+
+			msg->msg_iov[iovlen].iov_base = pos;
+			msg->msg_iov[iovlen].iov_len = len;
+			iovlen++;
+			read_len += len;
+		}
+
+		buf = buf->frags;
+		if (buf) {
+			pos = buf->data;
+		}
+	}
+
+	msg->msg_iovlen = iovlen;
+
+	if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS) &&
+	    !(flags & ZSOCK_MSG_PEEK)) {
+		net_socket_update_tc_rx_time(pkt, k_cycle_get_32());
+	}
+
+	*ret_pkt = pkt;
+
+	return (flags & ZSOCK_MSG_TRUNC) ? recv_len : read_len;
+}
+
+ssize_t zsock_recvmsg_zc(int sock, struct msghdr *msg, int flags,
+			 struct net_pkt **pkt)
+{
+	const struct socket_op_vtable *vtable;
+	struct net_context *ctx;
+	struct k_mutex *lock;
+	ssize_t ret;
+
+	ctx = get_sock_vtable(sock, &vtable, &lock);
+	if (ctx == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	/* Only native sockets queue net_pkt that can be handed out */
+	if (vtable != &sock_fd_op_vtable ||
+	    net_context_get_type(ctx) != SOCK_DGRAM) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	ret = zsock_recvmsg_zc_ctx(ctx, msg, flags, pkt);
+
+	k_mutex_unlock(lock);
+
+	return ret;
+}
+
+void zsock_recvmsg_zc_release(struct net_pkt *pkt)
+{
+	net_pkt_unref(pkt);
+}
+#endif /* CONFIG_NET_SOCKETS_RECV_ZERO_COPY */
+
 /* As this is limited function, we don't follow POSIX signature, with
  * "..." instead of last arg.
  */
@@ -2361,6 +2949,11 @@ static ssize_t sock_recvfrom_vmeth(void *obj, void *buf, size_t max_len,
 				  src_addr, addrlen);
 }
 
+static ssize_t sock_recvmsg_vmeth(void *obj, struct msghdr *msg, int flags)
+{
+	return zsock_recvmsg_ctx(obj, msg, flags);
+}
+
 static int sock_getsockopt_vmeth(void *obj, int level, int optname,
 				 void *optval, socklen_t *optlen)
 {
@@ -2404,6 +2997,7 @@ const struct socket_op_vtable sock_fd_op_vtable = {
 	.sendto = sock_sendto_vmeth,
 	.sendmsg = sock_sendmsg_vmeth,
 	.recvfrom = sock_recvfrom_vmeth,
+	.recvmsg = sock_recvmsg_vmeth,
 	.getsockopt = sock_getsockopt_vmeth,
 	.setsockopt = sock_setsockopt_vmeth,
 	.getpeername = sock_getpeername_vmeth,
@@ -218,6 +218,69 @@ static int cmd_kernel_stacks(const struct shell *shell,
 }
 #endif
 
+#if defined(CONFIG_SCHED_LATENCY_STATS)
+static void shell_hist_print(const struct shell *shell, const char *name,
+			     const uint32_t *hist)
+{
+	shell_fprintf(shell, SHELL_NORMAL, "\t%s:", name);
+
+	for (int i = 0; i < CONFIG_SCHED_LATENCY_STATS_BUCKETS; i++) {
+		if (hist[i] != 0U) {
+			shell_fprintf(shell, SHELL_NORMAL, " 2^%d:%u", i, hist[i]);
+		}
+	}
+
+	shell_fprintf(shell, SHELL_NORMAL, "\n");
+}
+
+static void shell_latency_print(const struct shell *shell,
+				const struct k_sched_latency_stats *stats)
+{
+	shell_print(shell, "\tpreempted: %u", stats->preempted);
+	shell_hist_print(shell, "wakeup", stats->wakeup);
+	shell_hist_print(shell, "slice", stats->slice);
+}
+
+static void shell_latency_dump(const struct k_thread *cthread, void *user_data)
+{
+	struct k_thread *thread = (struct k_thread *)cthread;
+	const struct shell *shell = (const struct shell *)user_data;
+	struct k_sched_latency_stats stats;
+	const char *tname;
+
+	if (k_thread_latency_stats_get(thread, &stats) != 0) {
+		return;
+	}
+
+	tname = k_thread_name_get(thread);
+
+	shell_print(shell, "%p %-10s", thread, tname ? tname : "NA");
+	shell_latency_print(shell, &stats);
+}
+
+static int cmd_kernel_latency(const struct shell *shell,
+			      size_t argc, char **argv)
+{
+	struct k_sched_latency_stats stats;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	shell_print(shell, "Counts per 2^N cycles:");
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		if (k_cpu_latency_stats_get(i, &stats) == 0) {
+			shell_print(shell, "CPU %d", i);
+			shell_latency_print(shell, &stats);
+		}
+	}
+
+	k_thread_foreach(shell_latency_dump, (void *)shell);
+
+	return 0;
+}
+#endif
+
 #if defined(CONFIG_REBOOT)
 static int cmd_kernel_reboot_warm(const struct shell *shell,
 				  size_t argc, char **argv)
@@ -252,6 +315,10 @@ SHELL_STATIC_SUBCMD_SET_CREATE(sub_kernel_reboot,
 
 SHELL_STATIC_SUBCMD_SET_CREATE(sub_kernel,
 	SHELL_CMD(cycles, NULL, "Kernel cycles.", cmd_kernel_cycles),
+#if defined(CONFIG_SCHED_LATENCY_STATS)
+	SHELL_CMD(latency, NULL, "Scheduling latency histograms.",
+		  cmd_kernel_latency),
+#endif
 #if defined(CONFIG_REBOOT)
 	SHELL_CMD(reboot, &sub_kernel_reboot, "Reboot.", NULL),
 #endif
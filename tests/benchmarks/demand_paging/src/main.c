@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/zephyr.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/mem_manage.h>
+
+/* A read-only blob larger than physical memory is linked with the rest
+ * of the paged image, so it is paged in from the backing store as it is
+ * read.  Two access patterns are run over it and the page faults,
+ * evictions and pages read ahead are taken from the paging statistics:
+ *
+ * - sequential: every page of the blob is read in turn, several times.
+ *   Every page faults with any eviction algorithm, read-ahead turns
+ *   that into one fault per cluster.
+ *
+ * - hot set: a few pages are read over and over, with a page from the
+ *   rest of the blob read in between.  An algorithm that tracks recent
+ *   use keeps the hot pages, and the benchmark's own code, resident.
+ */
+#define PAGE		CONFIG_MMU_PAGE_SIZE
+#define BLOB_PAGES	128
+#define HOT_PAGES	16
+#define SEQ_PASSES	4
+#define HOT_ROUNDS	256
+
+static const uint8_t __aligned(PAGE) blob[BLOB_PAGES * PAGE] = { 1 };
+
+static uint32_t sink;
+
+static inline void touch(size_t page)
+{
+	const volatile uint8_t *p = &blob[page * PAGE];
+
+	sink += *p;
+}
+
+static void sequential(void)
+{
+	for (int pass = 0; pass < SEQ_PASSES; pass++) {
+		for (size_t page = 0; page < BLOB_PAGES; page++) {
+			touch(page);
+		}
+	}
+}
+
+static void hot_set(void)
+{
+	size_t cold = HOT_PAGES;
+
+	for (int round = 0; round < HOT_ROUNDS; round++) {
+		for (size_t page = 0; page < HOT_PAGES; page++) {
+			touch(page);
+		}
+
+		touch(cold);
+		cold = (cold + 1 < BLOB_PAGES) ? cold + 1 : HOT_PAGES;
+	}
+}
+
+static void run(const char *name, void (*fn)(void))
+{
+	struct k_mem_paging_stats_t before, after;
+	int64_t start, elapsed;
+
+	/* Start each pattern with none of the blob resident */
+	k_mem_page_out((void *)blob, sizeof(blob));
+
+	k_mem_paging_stats_get(&before);
+	start = k_uptime_get();
+	fn();
+	elapsed = k_uptime_get() - start;
+	k_mem_paging_stats_get(&after);
+
+	printk("%-10s: %5lu faults, %5lu evictions, %5lu read ahead, %4u ms\n",
+	       name, after.pagefaults.cnt - before.pagefaults.cnt,
+	       (after.eviction.clean + after.eviction.dirty) -
+	       (before.eviction.clean + before.eviction.dirty),
+	       after.pagefaults.read_ahead - before.pagefaults.read_ahead,
+	       (uint32_t)elapsed);
+}
+
+void main(void)
+{
+	printk("eviction %s, read-ahead %d\n",
+	       IS_ENABLED(CONFIG_EVICTION_CLOCK) ? "CLOCK" : "NRU",
+	       CONFIG_DEMAND_PAGING_READ_AHEAD);
+
+	run("sequential", sequential);
+	run("hot set", hot_set);
+
+	printk("fin\n");
+}
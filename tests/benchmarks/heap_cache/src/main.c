@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/zephyr.h>
+#include <zephyr/sys/printk.h>
+#include <string.h>
+
+/* One worker per CPU runs a long random mix of small (16-256 byte)
+ * and occasional larger allocations against a shared k_heap, keeping
+ * a set of live blocks, first on a plain heap and then on one with
+ * per-CPU caches enabled.  Average and worst case cost of alloc and
+ * free are reported.  Afterwards the largest block the heap can
+ * still hand out is compared with its total free memory, to show
+ * the fragmentation left behind by the run.
+ */
+#define NUM_THREADS	CONFIG_MP_NUM_CPUS
+#define ITERATIONS	20000
+#define LIVE_BLOCKS	64
+#define HEAP_SIZE	(16384 * NUM_THREADS)
+#define STACK_SIZE	(1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+K_HEAP_DEFINE(plain_heap, HEAP_SIZE);
+K_HEAP_DEFINE(cached_heap, HEAP_SIZE);
+static struct k_heap_cache caches[CONFIG_MP_NUM_CPUS];
+
+struct result {
+	uint64_t alloc_cycles;
+	uint64_t free_cycles;
+	uint32_t alloc_max;
+	uint32_t free_max;
+	uint32_t allocs;
+	uint32_t frees;
+	uint32_t failures;
+};
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, NUM_THREADS, STACK_SIZE);
+static struct k_thread threads[NUM_THREADS];
+static struct result results[NUM_THREADS];
+static void *live[NUM_THREADS][LIVE_BLOCKS];
+static K_SEM_DEFINE(start_sem, 0, NUM_THREADS);
+
+static uint32_t next_rand(uint32_t *state)
+{
+	/* xorshift32, good enough to pick sizes and slots */
+	*state ^= *state << 13;
+	*state ^= *state >> 17;
+	*state ^= *state << 5;
+	return *state;
+}
+
+static size_t pick_size(uint32_t *state)
+{
+	uint32_t r = next_rand(state);
+
+	if ((r & 0xfU) == 0U) {
+		return 512U + (r >> 8) % 1536U;
+	}
+	return 16U + (r >> 8) % 241U;
+}
+
+static void do_free(struct k_heap *heap, struct result *res, void *mem)
+{
+	uint32_t t = k_cycle_get_32();
+
+	k_heap_free(heap, mem);
+	t = k_cycle_get_32() - t;
+	res->free_cycles += t;
+	res->free_max = MAX(res->free_max, t);
+	res->frees++;
+}
+
+static void worker(void *p1, void *p2, void *p3)
+{
+	struct k_heap *heap = p1;
+	int id = POINTER_TO_INT(p2);
+	struct result *res = &results[id];
+	void **slots = live[id];
+	uint32_t state = 0x9e3779b9U * (id + 1);
+
+	ARG_UNUSED(p3);
+
+	*res = (struct result) {};
+	k_sem_take(&start_sem, K_FOREVER);
+
+	for (int i = 0; i < ITERATIONS; i++) {
+		int slot = next_rand(&state) % LIVE_BLOCKS;
+
+		if (slots[slot] != NULL) {
+			do_free(heap, res, slots[slot]);
+			slots[slot] = NULL;
+			continue;
+		}
+
+		size_t bytes = pick_size(&state);
+		uint32_t t = k_cycle_get_32();
+
+		slots[slot] = k_heap_alloc(heap, bytes, K_NO_WAIT);
+		t = k_cycle_get_32() - t;
+
+		if (slots[slot] == NULL) {
+			res->failures++;
+			continue;
+		}
+		res->alloc_cycles += t;
+		res->alloc_max = MAX(res->alloc_max, t);
+		res->allocs++;
+	}
+}
+
+/* Largest single allocation that currently succeeds */
+static size_t largest_block(struct k_heap *heap)
+{
+	size_t lo = 0U, hi = HEAP_SIZE;
+
+	while (lo < hi) {
+		size_t mid = (lo + hi + 1U) / 2U;
+		void *mem = k_heap_alloc(heap, mid, K_NO_WAIT);
+
+		if (mem != NULL) {
+			k_heap_free(heap, mem);
+			lo = mid;
+		} else {
+			hi = mid - 1U;
+		}
+	}
+
+	return lo;
+}
+
+static uint32_t ns(uint64_t cycles, uint32_t count)
+{
+	return count != 0U ? (uint32_t)k_cyc_to_ns_floor64(cycles / count) : 0U;
+}
+
+static void run(const char *name, struct k_heap *heap)
+{
+	struct result total = {};
+	struct sys_heap_runtime_stats stats;
+
+	for (int i = 0; i < NUM_THREADS; i++) {
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE, worker,
+				heap, INT_TO_POINTER(i), NULL,
+				K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	}
+
+	/* Release all workers at once so they contend on the heap */
+	for (int i = 0; i < NUM_THREADS; i++) {
+		k_sem_give(&start_sem);
+	}
+
+	for (int i = 0; i < NUM_THREADS; i++) {
+		struct result *res = &results[i];
+
+		k_thread_join(&threads[i], K_FOREVER);
+		total.alloc_cycles += res->alloc_cycles;
+		total.free_cycles += res->free_cycles;
+		total.alloc_max = MAX(total.alloc_max, res->alloc_max);
+		total.free_max = MAX(total.free_max, res->free_max);
+		total.allocs += res->allocs;
+		total.frees += res->frees;
+		total.failures += res->failures;
+	}
+
+	printk("%s heap: %d threads, alloc avg %5u ns max %6u ns, "
+	       "free avg %5u ns max %6u ns, %u failed\n",
+	       name, NUM_THREADS,
+	       ns(total.alloc_cycles, total.allocs),
+	       ns(total.alloc_max, 1U),
+	       ns(total.free_cycles, total.frees),
+	       ns(total.free_max, 1U), total.failures);
+
+	/* The probe fails at least once, which also returns all cached
+	 * blocks to the heap before the free memory is read.
+	 */
+	size_t largest = largest_block(heap);
+
+	sys_heap_runtime_stats_get(&heap->heap, &stats);
+	printk("%s heap: largest block %6zu of %6zu free bytes (%u%%)\n",
+	       name, largest, stats.free_bytes,
+	       stats.free_bytes != 0U ?
+	       (uint32_t)((100U * largest) / stats.free_bytes) : 0U);
+}
+
+void main(void)
+{
+	run("plain ", &plain_heap);
+
+	memset(live, 0, sizeof(live));
+	k_heap_cache_enable(&cached_heap, caches);
+	run("cached", &cached_heap);
+
+	printk("fin\n");
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/zephyr.h>
+#include <zephyr/sys/printk.h>
+
+/* A user thread makes k_sem_count_get() system calls, whose cost is
+ * mostly the system call itself and the validation of the semaphore,
+ * on a semaphore known at build time (found through the gperf table)
+ * and then on dynamically allocated semaphores, with more and more
+ * dynamic objects allocated.  Thread creation is included in the
+ * timings but amortized over the calls.
+ */
+#define MAX_OBJECTS	256
+#define CALLS		10000
+#define STACK_SIZE	(1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+K_SEM_DEFINE(static_sem, 0, 1);
+
+static K_THREAD_STACK_DEFINE(user_stack, STACK_SIZE);
+static struct k_thread user_thread;
+static struct k_sem *dyn_sems[MAX_OBJECTS];
+
+static void user_fn(void *p1, void *p2, void *p3)
+{
+	struct k_sem *sem = p1;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < CALLS; i++) {
+		(void)k_sem_count_get(sem);
+	}
+}
+
+static uint32_t run(struct k_sem *sem)
+{
+	uint32_t start, cycles;
+
+	k_thread_create(&user_thread, user_stack, STACK_SIZE, user_fn,
+			sem, NULL, NULL, K_PRIO_PREEMPT(1), K_USER, K_FOREVER);
+	k_object_access_grant(sem, &user_thread);
+
+	start = k_cycle_get_32();
+	k_thread_start(&user_thread);
+	k_thread_join(&user_thread, K_FOREVER);
+	cycles = k_cycle_get_32() - start;
+
+	return (uint32_t)(k_cyc_to_ns_floor64(cycles) / CALLS);
+}
+
+void main(void)
+{
+	int n = 0;
+
+	k_thread_system_pool_assign(k_current_get());
+
+	printk("static object: %5u ns per syscall\n", run(&static_sem));
+
+	for (int objects = 1; objects <= MAX_OBJECTS; objects *= 4) {
+		for (; n < objects; n++) {
+			dyn_sems[n] = k_object_alloc(K_OBJ_SEM);
+			if (dyn_sems[n] == NULL) {
+				printk("allocation failed\n");
+				return;
+			}
+			k_sem_init(dyn_sems[n], 0, 1);
+		}
+
+		/* Look up the most recently allocated one */
+		printk("%3d dynamic objects: %5u ns per syscall\n", objects,
+		       run(dyn_sems[n - 1]));
+	}
+
+	printk("fin\n");
+}
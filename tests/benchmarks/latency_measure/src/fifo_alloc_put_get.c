@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/zephyr.h>
+#include <zephyr/timing/timing.h>
+#include "utils.h"
+
+/* the number of messages put and got, a batch at a time */
+#define N_TEST_FIFO_MSGS 1000
+#define BATCH 16
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+K_FIFO_DEFINE(alloc_fifo);
+K_SEM_DEFINE(alloc_fifo_done, 0, 1);
+K_HEAP_DEFINE(alloc_fifo_heap, BATCH * 32 + 256);
+
+#ifdef CONFIG_QUEUE_NODE_POOL
+static struct k_queue_node alloc_fifo_nodes[BATCH];
+#endif
+static uint32_t alloc_fifo_msgs[BATCH];
+
+static K_THREAD_STACK_DEFINE(alloc_fifo_stack, STACK_SIZE);
+static struct k_thread alloc_fifo_thread;
+
+static void alloc_fifo_put_get(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < N_TEST_FIFO_MSGS; i += BATCH) {
+		for (int j = 0; j < BATCH; j++) {
+			if (k_fifo_alloc_put(&alloc_fifo,
+					     &alloc_fifo_msgs[j]) != 0) {
+				printk(" Error: FIFO alloc put failed\n");
+				return;
+			}
+		}
+		for (int j = 0; j < BATCH; j++) {
+			if (k_fifo_get(&alloc_fifo, K_NO_WAIT) !=
+			    &alloc_fifo_msgs[j]) {
+				printk(" Error: FIFO get failed\n");
+				return;
+			}
+		}
+	}
+
+	k_sem_give(&alloc_fifo_done);
+}
+
+static uint32_t alloc_fifo_run(bool node_pool)
+{
+	timing_t start, end;
+
+	k_fifo_init(&alloc_fifo);
+#ifdef CONFIG_QUEUE_NODE_POOL
+	if (node_pool) {
+		k_fifo_node_pool_init(&alloc_fifo, alloc_fifo_nodes, BATCH);
+	}
+#else
+	ARG_UNUSED(node_pool);
+#endif
+
+	/* Runs in user mode when available, which is where the node
+	 * pool saves a resource pool allocation per message
+	 */
+	k_thread_create(&alloc_fifo_thread, alloc_fifo_stack, STACK_SIZE,
+			alloc_fifo_put_get, NULL, NULL, NULL,
+			K_PRIO_PREEMPT(1),
+			IS_ENABLED(CONFIG_USERSPACE) ? K_USER : 0, K_FOREVER);
+	k_thread_heap_assign(&alloc_fifo_thread, &alloc_fifo_heap);
+	k_thread_access_grant(&alloc_fifo_thread, &alloc_fifo,
+			      &alloc_fifo_done);
+
+	start = timing_counter_get();
+	k_thread_start(&alloc_fifo_thread);
+	k_thread_join(&alloc_fifo_thread, K_FOREVER);
+	end = timing_counter_get();
+
+	if (k_sem_take(&alloc_fifo_done, K_NO_WAIT) != 0) {
+		error_count++;
+	}
+
+	return (uint32_t)timing_cycles_get(&start, &end);
+}
+
+/**
+ *
+ * @brief Test for the FIFO put/get time with allocated nodes
+ *
+ * The routine puts batches of messages with k_fifo_alloc_put() and
+ * gets them back, with the bookkeeping nodes coming from the thread's
+ * resource pool and, with CONFIG_QUEUE_NODE_POOL, from nodes given to
+ * the FIFO beforehand.
+ *
+ * @return 0 on success
+ */
+int fifo_alloc_put_get(void)
+{
+	uint32_t cycles;
+
+	timing_start();
+
+	cycles = alloc_fifo_run(false);
+	PRINT_STATS_AVG("Average time to alloc put and get a FIFO message",
+			cycles, N_TEST_FIFO_MSGS);
+
+#ifdef CONFIG_QUEUE_NODE_POOL
+	cycles = alloc_fifo_run(true);
+	PRINT_STATS_AVG("Average time to alloc put and get (node pool)",
+			cycles, N_TEST_FIFO_MSGS);
+#endif
+
+	timing_stop();
+
+	return 0;
+}
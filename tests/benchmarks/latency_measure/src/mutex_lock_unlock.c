@@ -20,7 +20,8 @@ K_MUTEX_DEFINE(test_mutex);
  * @brief Test for the multiple mutex lock/unlock time
  *
  * The routine performs multiple mutex locks and then multiple mutex
- * unlocks to measure the necessary time.
+ * unlocks to measure the necessary time, then measures pairs of lock
+ * and unlock of the mutex while it is free.
  *
  * @return 0 on success
  */
@@ -54,6 +55,20 @@ int mutex_lock_unlock(void)
 	diff = timing_cycles_get(&timestamp_start, &timestamp_end);
 
 	PRINT_STATS_AVG("Average time to unlock a mutex", diff, N_TEST_MUTEX);
+
+	/* Same without recursion, every lock takes a free mutex */
+	timestamp_start = timing_counter_get();
+
+	for (i = 0; i < N_TEST_MUTEX; i++) {
+		k_mutex_lock(&test_mutex, K_FOREVER);
+		k_mutex_unlock(&test_mutex);
+	}
+
+	timestamp_end = timing_counter_get();
+	diff = timing_cycles_get(&timestamp_start, &timestamp_end);
+
+	PRINT_STATS_AVG("Average time to lock and unlock a free mutex", diff,
+			N_TEST_MUTEX);
 	timing_stop();
 	return 0;
 }
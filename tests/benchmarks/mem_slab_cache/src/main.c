@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/zephyr.h>
+#include <zephyr/sys/printk.h>
+
+/* One worker per CPU repeatedly allocates a small burst of blocks
+ * from a shared slab and frees them again, first on a plain slab and
+ * then on one with per-CPU caches enabled.  The average time per
+ * alloc/free pair is reported, along with the cache hit rates.
+ */
+#define NUM_THREADS	CONFIG_MP_NUM_CPUS
+#define ITERATIONS	10000
+#define BURST		4
+#define BLOCK_SIZE	64
+#define NUM_BLOCKS	(NUM_THREADS * BURST * 4)
+#define STACK_SIZE	(1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+K_MEM_SLAB_DEFINE_STATIC(plain_slab, BLOCK_SIZE, NUM_BLOCKS, 8);
+K_MEM_SLAB_DEFINE_STATIC(cached_slab, BLOCK_SIZE, NUM_BLOCKS, 8);
+static struct k_mem_slab_cache caches[CONFIG_MP_NUM_CPUS];
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, NUM_THREADS, STACK_SIZE);
+static struct k_thread threads[NUM_THREADS];
+static uint32_t cycles[NUM_THREADS];
+static K_SEM_DEFINE(start_sem, 0, NUM_THREADS);
+
+static void worker(void *p1, void *p2, void *p3)
+{
+	struct k_mem_slab *slab = p1;
+	uint32_t *result = p2;
+	void *blocks[BURST];
+
+	ARG_UNUSED(p3);
+
+	k_sem_take(&start_sem, K_FOREVER);
+
+	uint32_t start = k_cycle_get_32();
+
+	for (int i = 0; i < ITERATIONS; i++) {
+		for (int j = 0; j < BURST; j++) {
+			if (k_mem_slab_alloc(slab, &blocks[j], K_FOREVER) != 0) {
+				printk("allocation failed\n");
+				return;
+			}
+		}
+		for (int j = 0; j < BURST; j++) {
+			k_mem_slab_free(slab, &blocks[j]);
+		}
+	}
+
+	*result = k_cycle_get_32() - start;
+}
+
+static uint32_t run(struct k_mem_slab *slab)
+{
+	uint64_t total = 0U;
+
+	for (int i = 0; i < NUM_THREADS; i++) {
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE, worker,
+				slab, &cycles[i], NULL,
+				K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	}
+
+	/* Release all workers at once so they contend on the slab */
+	for (int i = 0; i < NUM_THREADS; i++) {
+		k_sem_give(&start_sem);
+	}
+
+	for (int i = 0; i < NUM_THREADS; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+		total += cycles[i];
+	}
+
+	return (uint32_t)k_cyc_to_ns_floor64(total /
+					     (NUM_THREADS * ITERATIONS * BURST));
+}
+
+static uint32_t percent(uint32_t hits, uint32_t misses)
+{
+	return (hits + misses) != 0U ? (100U * hits) / (hits + misses) : 0U;
+}
+
+void main(void)
+{
+	struct k_mem_slab_cache_stats stats;
+	uint32_t ns;
+
+	ns = run(&plain_slab);
+	printk("plain  slab: %d threads, %5u ns per alloc/free\n",
+	       NUM_THREADS, ns);
+
+	k_mem_slab_cache_enable(&cached_slab, caches);
+	ns = run(&cached_slab);
+	k_mem_slab_cache_stats_get(&cached_slab, &stats);
+	printk("cached slab: %d threads, %5u ns per alloc/free, "
+	       "%u%% alloc hits, %u%% free hits\n",
+	       NUM_THREADS, ns,
+	       percent(stats.alloc_hits, stats.alloc_misses),
+	       percent(stats.free_hits, stats.free_misses));
+
+	printk("fin\n");
+}
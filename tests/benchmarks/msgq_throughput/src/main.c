@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/zephyr.h>
+#include <zephyr/sys/printk.h>
+
+/* 1 to CONFIG_MP_NUM_CPUS producer/consumer pairs stream messages
+ * through a single shared message queue.  The elapsed time divided by
+ * the total number of messages is reported for each number of pairs,
+ * so the scaling of k_msgq_put()/k_msgq_get() across cores can be
+ * compared with and without CONFIG_MSGQ_LOCKFREE.
+ */
+#define MAX_PAIRS	CONFIG_MP_NUM_CPUS
+#define MESSAGES	10000
+#define MSG_WORDS	4
+#define QUEUE_LEN	16
+#define STACK_SIZE	(1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+K_MSGQ_DEFINE(msgq, MSG_WORDS * sizeof(uint32_t), QUEUE_LEN, 4);
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, 2 * MAX_PAIRS, STACK_SIZE);
+static struct k_thread threads[2 * MAX_PAIRS];
+static K_SEM_DEFINE(start_sem, 0, 2 * MAX_PAIRS);
+
+static void producer(void *p1, void *p2, void *p3)
+{
+	uint32_t msg[MSG_WORDS] = { 0 };
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	k_sem_take(&start_sem, K_FOREVER);
+
+	for (uint32_t i = 0; i < MESSAGES; i++) {
+		msg[0] = i;
+		if (k_msgq_put(&msgq, msg, K_FOREVER) != 0) {
+			printk("put failed\n");
+			return;
+		}
+	}
+}
+
+static void consumer(void *p1, void *p2, void *p3)
+{
+	uint32_t msg[MSG_WORDS];
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	k_sem_take(&start_sem, K_FOREVER);
+
+	for (uint32_t i = 0; i < MESSAGES; i++) {
+		if (k_msgq_get(&msgq, msg, K_FOREVER) != 0) {
+			printk("get failed\n");
+			return;
+		}
+	}
+}
+
+static uint32_t run(int pairs)
+{
+	uint32_t start, cycles;
+
+	for (int i = 0; i < pairs; i++) {
+		k_thread_create(&threads[2 * i], stacks[2 * i], STACK_SIZE,
+				producer, NULL, NULL, NULL,
+				K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+		k_thread_create(&threads[2 * i + 1], stacks[2 * i + 1],
+				STACK_SIZE, consumer, NULL, NULL, NULL,
+				K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	}
+
+	start = k_cycle_get_32();
+
+	/* Release all threads at once so they contend on the queue */
+	for (int i = 0; i < 2 * pairs; i++) {
+		k_sem_give(&start_sem);
+	}
+
+	for (int i = 0; i < 2 * pairs; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	return (uint32_t)(k_cyc_to_ns_floor64(cycles) / (pairs * MESSAGES));
+}
+
+void main(void)
+{
+	printk("msgq %s: %u message bytes, %d deep\n",
+	       IS_ENABLED(CONFIG_MSGQ_LOCKFREE) ? "lock-free" : "locked",
+	       (unsigned int)(MSG_WORDS * sizeof(uint32_t)), QUEUE_LEN);
+
+	for (int pairs = 1; pairs <= MAX_PAIRS; pairs++) {
+		printk("%2d pair%s: %5u ns per message\n", pairs,
+		       (pairs == 1) ? " " : "s", run(pairs));
+	}
+
+	printk("fin\n");
+}
@@ -0,0 +1,378 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/zephyr.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/net_pkt.h>
+
+#include "connection.h"
+
+/* UDP echo over the loopback interface. The client sends a burst of
+ * BATCH datagrams to the server, which echoes them back, and waits for
+ * all the echoes before sending the next burst. Both sides use the calls
+ * under test, so the rate reflects their cost on top of the stack.
+ *
+ * The baseline receives and sends one datagram per call. The batched
+ * calls look up and lock the socket once per burst, and the zero-copy
+ * receive additionally echoes the data straight from the received
+ * network buffers.
+ *
+ * The baseline is then repeated with more and more connection handlers
+ * of other, connected, sockets registered, to show how the cost of
+ * finding the handler of each received datagram grows with them.
+ */
+#define PAYLOAD		64
+#define BATCH		8
+#define FRAGS		4
+#define PACKETS		20000
+#define SERVER_PORT	4242
+#define STACK_SIZE	2048
+
+/* Handlers of the server and client sockets */
+#define SOCKET_CONNS	2
+#define MAX_EXTRA_CONNS	(CONFIG_NET_MAX_CONN - SOCKET_CONNS)
+#define EXTRA_PORT	10000
+
+struct batch {
+	struct mmsghdr msgs[BATCH];
+	struct iovec iov[BATCH][FRAGS];
+	struct sockaddr_in addr[BATCH];
+	struct net_pkt *pkt[BATCH];
+	uint8_t buf[BATCH][PAYLOAD];
+};
+
+struct mode {
+	const char *name;
+
+	/* Receives 1 to max datagrams, after which the messages of the
+	 * batch describe the echoes to send back.
+	 */
+	int (*recv)(int sock, struct batch *b, unsigned int max);
+	int (*send)(int sock, struct batch *b, unsigned int count);
+
+	/* Optional, gives back what recv() handed out */
+	void (*release)(struct batch *b, unsigned int count);
+};
+
+static struct batch server_batch, client_batch;
+static uint8_t payload[PAYLOAD];
+
+static struct sockaddr_in server_addr = {
+	.sin_family = AF_INET,
+	.sin_port = htons(SERVER_PORT),
+	.sin_addr = INADDR_LOOPBACK_INIT,
+};
+
+#if MAX_EXTRA_CONNS > 0
+static struct sockaddr_in extra_addr = {
+	.sin_family = AF_INET,
+	.sin_addr = { { { 198, 51, 100, 1 } } },
+};
+
+static struct net_conn_handle *extra_conns[MAX_EXTRA_CONNS];
+#endif
+
+K_THREAD_STACK_DEFINE(server_stack, STACK_SIZE);
+static struct k_thread server_thread;
+static uint32_t echoed;
+
+static void batch_rx_init(struct batch *b, unsigned int i)
+{
+	struct msghdr *msg = &b->msgs[i].msg_hdr;
+
+	msg->msg_name = &b->addr[i];
+	msg->msg_namelen = sizeof(b->addr[i]);
+	msg->msg_iov = b->iov[i];
+	msg->msg_iovlen = 1;
+
+	b->iov[i][0].iov_base = b->buf[i];
+	b->iov[i][0].iov_len = sizeof(b->buf[i]);
+}
+
+static int recv_single(int sock, struct batch *b, unsigned int max)
+{
+	struct msghdr *msg = &b->msgs[0].msg_hdr;
+	ssize_t len;
+
+	ARG_UNUSED(max);
+
+	batch_rx_init(b, 0);
+
+	len = zsock_recvfrom(sock, b->buf[0], sizeof(b->buf[0]), 0,
+			     msg->msg_name, &msg->msg_namelen);
+	if (len < 0) {
+		return -1;
+	}
+
+	b->iov[0][0].iov_len = len;
+
+	return 1;
+}
+
+static int send_single(int sock, struct batch *b, unsigned int count)
+{
+	for (unsigned int i = 0; i < count; i++) {
+		struct msghdr *msg = &b->msgs[i].msg_hdr;
+
+		if (zsock_sendto(sock, msg->msg_iov[0].iov_base,
+				 msg->msg_iov[0].iov_len, 0, msg->msg_name,
+				 msg->msg_namelen) < 0) {
+			return -1;
+		}
+	}
+
+	return count;
+}
+
+static int recv_mmsg(int sock, struct batch *b, unsigned int max)
+{
+	int n;
+
+	for (unsigned int i = 0; i < max; i++) {
+		batch_rx_init(b, i);
+	}
+
+	n = zsock_recvmmsg(sock, b->msgs, max, 0);
+
+	for (int i = 0; i < n; i++) {
+		b->iov[i][0].iov_len = b->msgs[i].msg_len;
+	}
+
+	return n;
+}
+
+static int send_mmsg(int sock, struct batch *b, unsigned int count)
+{
+	return zsock_sendmmsg(sock, b->msgs, count, 0);
+}
+
+#if defined(CONFIG_NET_SOCKETS_RECV_ZERO_COPY)
+static int recv_zc(int sock, struct batch *b, unsigned int max)
+{
+	unsigned int i;
+
+	for (i = 0; i < max; i++) {
+		struct msghdr *msg = &b->msgs[i].msg_hdr;
+
+		batch_rx_init(b, i);
+		msg->msg_iovlen = FRAGS;
+
+		/* Only wait for the first datagram */
+		if (zsock_recvmsg_zc(sock, msg, i ? ZSOCK_MSG_DONTWAIT : 0,
+				     &b->pkt[i]) < 0) {
+			break;
+		}
+	}
+
+	return i ? i : -1;
+}
+
+static void release_zc(struct batch *b, unsigned int count)
+{
+	for (unsigned int i = 0; i < count; i++) {
+		zsock_recvmsg_zc_release(b->pkt[i]);
+	}
+}
+#endif
+
+static const struct mode modes[] = {
+	{ "recvfrom/sendto", recv_single, send_single, NULL },
+	{ "recvmmsg/sendmmsg", recv_mmsg, send_mmsg, NULL },
+#if defined(CONFIG_NET_SOCKETS_RECV_ZERO_COPY)
+	{ "recvmsg_zc/sendmmsg", recv_zc, send_mmsg, release_zc },
+#endif
+};
+
+static int socket_open(const struct sockaddr_in *addr)
+{
+	struct zsock_timeval tv = { .tv_sec = 1 };
+	int sock;
+
+	sock = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	if (sock < 0) {
+		return -1;
+	}
+
+	/* Lost datagrams must not block the benchmark */
+	if (zsock_setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &tv,
+			     sizeof(tv)) < 0 ||
+	    (addr != NULL &&
+	     zsock_bind(sock, (const struct sockaddr *)addr,
+			sizeof(*addr)) < 0)) {
+		zsock_close(sock);
+		return -1;
+	}
+
+	return sock;
+}
+
+static void server(void *p1, void *p2, void *p3)
+{
+	const struct mode *mode = p1;
+	int sock = POINTER_TO_INT(p2);
+	int n;
+
+	ARG_UNUSED(p3);
+
+	while (echoed < PACKETS) {
+		n = mode->recv(sock, &server_batch, BATCH);
+		if (n < 0) {
+			break;
+		}
+
+		(void)mode->send(sock, &server_batch, n);
+
+		if (mode->release) {
+			mode->release(&server_batch, n);
+		}
+
+		echoed += n;
+	}
+}
+
+static int client(const struct mode *mode, int sock)
+{
+	struct batch *b = &client_batch;
+	int received = 0;
+	int n;
+
+	for (int sent = 0; sent < PACKETS; sent += BATCH) {
+		for (int i = 0; i < BATCH; i++) {
+			struct msghdr *msg = &b->msgs[i].msg_hdr;
+
+			msg->msg_name = &server_addr;
+			msg->msg_namelen = sizeof(server_addr);
+			msg->msg_iov = b->iov[i];
+			msg->msg_iovlen = 1;
+
+			b->iov[i][0].iov_base = payload;
+			b->iov[i][0].iov_len = sizeof(payload);
+		}
+
+		if (mode->send(sock, b, BATCH) != BATCH) {
+			return -1;
+		}
+
+		for (int got = 0; got < BATCH; got += n) {
+			n = mode->recv(sock, b, BATCH - got);
+			if (n < 0) {
+				return -1;
+			}
+
+			if (mode->release) {
+				mode->release(b, n);
+			}
+
+			received += n;
+		}
+	}
+
+	return received;
+}
+
+static void run(const struct mode *mode, int conns)
+{
+	int server_sock, client_sock;
+	int64_t start, ms;
+	int received;
+
+	server_sock = socket_open(&server_addr);
+	client_sock = socket_open(NULL);
+	if (server_sock < 0 || client_sock < 0) {
+		printk("%s: socket setup failed (%d)\n", mode->name, errno);
+		return;
+	}
+
+	echoed = 0U;
+
+	k_thread_create(&server_thread, server_stack, STACK_SIZE, server,
+			(void *)mode, INT_TO_POINTER(server_sock), NULL,
+			K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+
+	start = k_uptime_get();
+	received = client(mode, client_sock);
+	ms = k_uptime_get() - start;
+
+	k_thread_join(&server_thread, K_FOREVER);
+
+	zsock_close(client_sock);
+	zsock_close(server_sock);
+
+	if (received < 0) {
+		printk("%s: echo failed (%d)\n", mode->name, errno);
+		return;
+	}
+
+	/* Echoes completed per second */
+	printk("%s", mode->name);
+	if (conns > 0) {
+		printk(", %4d connections", conns);
+	}
+	printk(": %7u packets/s\n",
+	       (uint32_t)((uint64_t)received * MSEC_PER_SEC / MAX(ms, 1)));
+}
+
+#if MAX_EXTRA_CONNS > 0
+static enum net_verdict extra_conn_cb(struct net_conn *conn,
+				      struct net_pkt *pkt,
+				      union net_ip_header *ip_hdr,
+				      union net_proto_header *proto_hdr,
+				      void *user_data)
+{
+	ARG_UNUSED(conn);
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(ip_hdr);
+	ARG_UNUSED(proto_hdr);
+	ARG_UNUSED(user_data);
+
+	/* Never matches the echoed datagrams */
+	return NET_DROP;
+}
+
+static void run_extra_conns(void)
+{
+	int n = 0;
+	int ret;
+
+	for (int conns = 16; conns <= MAX_EXTRA_CONNS; conns *= 4) {
+		for (; n < conns; n++) {
+			ret = net_conn_register(IPPROTO_UDP, AF_INET,
+						(struct sockaddr *)&extra_addr,
+						(struct sockaddr *)&server_addr,
+						EXTRA_PORT + n, SERVER_PORT,
+						NULL, extra_conn_cb, NULL,
+						&extra_conns[n]);
+			if (ret < 0) {
+				printk("registration failed (%d)\n", ret);
+				goto out;
+			}
+		}
+
+		run(&modes[0], conns);
+	}
+
+out:
+	for (int i = 0; i < n; i++) {
+		net_conn_unregister(extra_conns[i]);
+	}
+}
+#else
+static inline void run_extra_conns(void)
+{
+}
+#endif
+
+void main(void)
+{
+	for (int i = 0; i < ARRAY_SIZE(modes); i++) {
+		run(&modes[i], 0);
+	}
+
+	run_extra_conns();
+
+	printk("fin\n");
+}
@@ -86,6 +86,97 @@ static void partner_fn(void *arg1, void *arg2, void *arg3)
 	}
 }
 
+#ifdef CONFIG_SMP
+/* SMP phase: measures wakeup latency (from k_sem_give() in main
+ * until the woken partner runs, possibly on another CPU) and the
+ * full round trip back to main.  It is repeated while 0 up to
+ * CONFIG_MP_NUM_CPUS - 1 additional CPUs are kept busy by yielding
+ * load threads, so the numbers can be compared per number of
+ * contending CPUs and per run queue backend (the global queue or
+ * CONFIG_SCHED_CPU_RUNQ).
+ */
+#define N_LOAD_THREADS (CONFIG_MP_NUM_CPUS - 1)
+
+static K_THREAD_STACK_DEFINE(waker_stack, 1024);
+static struct k_thread waker_thread;
+static K_THREAD_STACK_ARRAY_DEFINE(load_stacks, N_LOAD_THREADS, 1024);
+static struct k_thread load_threads[N_LOAD_THREADS];
+
+static K_SEM_DEFINE(ping_sem, 0, 1);
+static K_SEM_DEFINE(pong_sem, 0, 1);
+
+static volatile uint32_t wake_stamp;
+static volatile bool load_stop;
+
+static void waker_fn(void *arg1, void *arg2, void *arg3)
+{
+	ARG_UNUSED(arg1);
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	while (true) {
+		k_sem_take(&ping_sem, K_FOREVER);
+		wake_stamp = k_cycle_get_32();
+		k_sem_give(&pong_sem);
+	}
+}
+
+static void load_fn(void *arg1, void *arg2, void *arg3)
+{
+	ARG_UNUSED(arg1);
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	while (!load_stop) {
+		k_yield();
+	}
+}
+
+static void smp_bench(int main_prio)
+{
+	k_thread_create(&waker_thread, waker_stack,
+			K_THREAD_STACK_SIZEOF(waker_stack),
+			waker_fn, NULL, NULL, NULL,
+			main_prio - 1, 0, K_NO_WAIT);
+
+	for (int nload = 0; nload <= N_LOAD_THREADS; nload++) {
+		uint64_t wake_tot = 0U, rt_tot = 0U;
+
+		load_stop = false;
+		for (int i = 0; i < nload; i++) {
+			k_thread_create(&load_threads[i], load_stacks[i],
+					K_THREAD_STACK_SIZEOF(load_stacks[i]),
+					load_fn, NULL, NULL, NULL,
+					main_prio, 0, K_NO_WAIT);
+		}
+
+		for (int i = 0; i < N_RUNS + N_SETTLE; i++) {
+			uint32_t t0 = k_cycle_get_32();
+
+			k_sem_give(&ping_sem);
+			k_sem_take(&pong_sem, K_FOREVER);
+
+			uint32_t t1 = k_cycle_get_32();
+
+			if (i >= N_SETTLE) {
+				wake_tot += wake_stamp - t0;
+				rt_tot += t1 - t0;
+			}
+		}
+
+		load_stop = true;
+		for (int i = 0; i < nload; i++) {
+			k_thread_join(&load_threads[i], K_FOREVER);
+		}
+
+		printk("cpus %d busy %d: wakeup avg %4u roundtrip avg %4u\n",
+		       CONFIG_MP_NUM_CPUS, nload,
+		       (uint32_t)(wake_tot / N_RUNS),
+		       (uint32_t)(rt_tot / N_RUNS));
+	}
+}
+#endif
+
 void main(void)
 {
 	z_waitq_init(&waitq);
@@ -148,5 +239,9 @@ void main(void)
 		       stamps[4] - stamps[3],
 		       whole, avg);
 	}
+
+#ifdef CONFIG_SMP
+	smp_bench(main_prio);
+#endif
 	printk("fin\n");
 }
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/zephyr.h>
+#include <zephyr/timeout_q.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/sys/printk.h>
+
+#define MAX_TIMEOUTS CONFIG_BENCHMARK_MAX_TIMEOUTS
+
+/* Pending timeouts added in the add/abort phase expire this far in
+ * the future (plus a random spread of the same size), so none of them
+ * fires while being measured.
+ */
+#define FAR_MS (60 * MSEC_PER_SEC)
+
+/* Coprime to all powers of ten, used to abort in a scattered order */
+#define ABORT_STRIDE 7919U
+
+static struct _timeout timeouts[MAX_TIMEOUTS];
+
+static volatile uint32_t fired;
+static timing_t first_fire, last_fire;
+
+static uint32_t rand_state = 1U;
+
+static uint32_t bench_rand(void)
+{
+	rand_state = rand_state * 1103515245U + 12345U;
+	return rand_state >> 8;
+}
+
+static void noop_fn(struct _timeout *t)
+{
+	ARG_UNUSED(t);
+}
+
+static void expire_fn(struct _timeout *t)
+{
+	ARG_UNUSED(t);
+
+	last_fire = timing_counter_get();
+	if (fired++ == 0U) {
+		first_fire = last_fire;
+	}
+}
+
+static uint32_t ns_per_op(uint64_t cycles, uint32_t n)
+{
+	return (uint32_t)timing_cycles_to_ns_avg(cycles, n);
+}
+
+static void bench(uint32_t n)
+{
+	k_ticks_t far = k_ms_to_ticks_ceil64(FAR_MS);
+	timing_t start, end;
+	uint64_t add_cycles, abort_cycles, expire_cycles;
+
+	start = timing_counter_get();
+	for (uint32_t i = 0; i < n; i++) {
+		k_ticks_t dt = far + (bench_rand() % far);
+
+		z_add_timeout(&timeouts[i], noop_fn, Z_TIMEOUT_TICKS(dt));
+	}
+	end = timing_counter_get();
+	add_cycles = timing_cycles_get(&start, &end);
+
+	start = timing_counter_get();
+	for (uint32_t i = 0; i < n; i++) {
+		z_abort_timeout(&timeouts[(i * ABORT_STRIDE) % n]);
+	}
+	end = timing_counter_get();
+	abort_cycles = timing_cycles_get(&start, &end);
+
+	/* Everything expires on one tick, so the whole batch is
+	 * handled by a single sys_clock_announce().  Leave twice the
+	 * time the add phase took for queueing them.
+	 */
+	k_ticks_t when = k_uptime_ticks() + 2 +
+		2 * k_ns_to_ticks_ceil64(timing_cycles_to_ns(add_cycles));
+
+	fired = 0U;
+	for (uint32_t i = 0; i < n; i++) {
+		z_add_timeout(&timeouts[i], expire_fn,
+			      K_TIMEOUT_ABS_TICKS(when));
+	}
+	while (fired < n) {
+		k_sleep(K_TICKS(1));
+	}
+	expire_cycles = timing_cycles_get(&first_fire, &last_fire);
+
+	printk("%6u timeouts: add %5u ns, abort %5u ns, expire %5u ns\n",
+	       n, ns_per_op(add_cycles, n), ns_per_op(abort_cycles, n),
+	       n > 1U ? ns_per_op(expire_cycles, n - 1U) : 0U);
+}
+
+void main(void)
+{
+	timing_init();
+	timing_start();
+
+	for (uint32_t n = 10U; n <= MAX_TIMEOUTS; n *= 10U) {
+		bench(n);
+	}
+
+	timing_stop();
+	printk("fin\n");
+}
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/zephyr.h>
+#include <zephyr/sys/printk.h>
+
+/* Up to MAX_WAITERS threads of equal priority, all higher than main,
+ * loop taking one semaphore.  Each k_sem_give() from main unpends the
+ * longest waiter, which preempts main and pends again behind all the
+ * others, so an iteration costs one unpend from the head and one pend
+ * at the tail of a wait queue of the given length, plus two context
+ * switches.  That is the worst case for CONFIG_WAITQ_DUMB.
+ */
+#define MAX_WAITERS	512
+#define ITERATIONS	1000
+#define STACK_SIZE	(512 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, MAX_WAITERS, STACK_SIZE);
+static struct k_thread threads[MAX_WAITERS];
+static K_SEM_DEFINE(sem, 0, 1);
+
+static void waiter(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		k_sem_take(&sem, K_FOREVER);
+	}
+}
+
+static uint32_t run(void)
+{
+	uint32_t start, cycles;
+
+	/* Warm up, and rotate through every waiter once */
+	for (int i = 0; i < MAX_WAITERS; i++) {
+		k_sem_give(&sem);
+	}
+
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < ITERATIONS; i++) {
+		k_sem_give(&sem);
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	return (uint32_t)(k_cyc_to_ns_floor64(cycles) / ITERATIONS);
+}
+
+void main(void)
+{
+	int waiters = 0;
+
+	printk("wait_q %s\n",
+	       IS_ENABLED(CONFIG_WAITQ_MULTIQ) ? "multiq" :
+	       IS_ENABLED(CONFIG_WAITQ_SCALABLE) ? "scalable" : "dumb");
+
+	for (int n = 1; n <= MAX_WAITERS; n *= 2) {
+		/* Created at higher priority, so they pend right away */
+		for (; waiters < n; waiters++) {
+			k_thread_create(&threads[waiters], stacks[waiters],
+					STACK_SIZE, waiter, NULL, NULL, NULL,
+					K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+		}
+
+		printk("%3d waiter%s: %5u ns per give/take\n", n,
+		       (n == 1) ? " " : "s", run());
+	}
+
+	printk("fin\n");
+}
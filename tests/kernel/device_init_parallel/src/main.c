@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/zephyr.h>
+#include <zephyr/device.h>
+#include <zephyr/init.h>
+#include <ztest.h>
+
+/* Four devices whose initialization sleeps, then a SYS_INIT() entry,
+ * then one more sleeping device, all at POST_KERNEL.  The first four
+ * fit in the pool and must overlap, the SYS_INIT() entry must run
+ * alone between them and the last device.
+ *
+ * After the last device come two devicetree devices, a consumer and
+ * the supplier it requires, in this link order.  The consumer must
+ * wait for the supplier.
+ */
+#define NUM_SLOW	4
+#define SLOW_MS		100
+
+#define CONSUMER	(NUM_SLOW + 1)
+#define SUPPLIER	(NUM_SLOW + 2)
+
+static int64_t init_start[NUM_SLOW + 3];
+static int64_t init_end[NUM_SLOW + 3];
+static int64_t barrier_time;
+
+static int slow_init(const struct device *dev)
+{
+	int i = (int)(uintptr_t)dev->config;
+
+	init_start[i] = k_uptime_get();
+	k_msleep(SLOW_MS);
+	init_end[i] = k_uptime_get();
+
+	return 0;
+}
+
+static int barrier_init(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	barrier_time = k_uptime_get();
+
+	return 0;
+}
+
+#define SLOW_DEVICE(i, prio)						\
+	DEVICE_DEFINE(slow_##i, "slow_" #i, slow_init, NULL, NULL,	\
+		      (const void *)(uintptr_t)(i), POST_KERNEL, prio,	\
+		      NULL)
+
+SLOW_DEVICE(0, 60);
+SLOW_DEVICE(1, 61);
+SLOW_DEVICE(2, 62);
+SLOW_DEVICE(3, 63);
+SYS_INIT(barrier_init, POST_KERNEL, 64);
+SLOW_DEVICE(4, 65);
+
+/* NB: Intentional init of the consumer before its supplier */
+DEVICE_DT_DEFINE(DT_NODELABEL(init_consumer), slow_init, NULL, NULL,
+		 (const void *)(uintptr_t)CONSUMER, POST_KERNEL, 66, NULL);
+DEVICE_DT_DEFINE(DT_NODELABEL(init_supplier), slow_init, NULL, NULL,
+		 (const void *)(uintptr_t)SUPPLIER, POST_KERNEL, 67, NULL);
+
+static void test_overlap(void)
+{
+	int64_t last_start = 0, first_end = INT64_MAX;
+
+	for (int i = 0; i < NUM_SLOW; i++) {
+		last_start = MAX(last_start, init_start[i]);
+		first_end = MIN(first_end, init_end[i]);
+	}
+
+	zassert_true(last_start < first_end,
+		     "device initializations didn't overlap");
+}
+
+static void test_barrier(void)
+{
+	for (int i = 0; i < NUM_SLOW; i++) {
+		zassert_true(init_end[i] <= barrier_time,
+			     "SYS_INIT entry ran before device %d was done", i);
+	}
+
+	zassert_true(barrier_time <= init_start[NUM_SLOW],
+		     "device started before SYS_INIT entry");
+}
+
+static void test_dependency(void)
+{
+	zassert_true(init_end[SUPPLIER] != 0, "supplier not initialized");
+	zassert_true(init_start[CONSUMER] >= init_end[SUPPLIER],
+		     "consumer started before its supplier was done");
+}
+
+static void test_ready(void)
+{
+	zassert_true(device_is_ready(DEVICE_GET(slow_0)), NULL);
+	zassert_true(device_is_ready(DEVICE_GET(slow_4)), NULL);
+	zassert_true(device_is_ready(DEVICE_DT_GET(DT_NODELABEL(init_consumer))),
+		     NULL);
+	zassert_true(device_is_ready(DEVICE_DT_GET(DT_NODELABEL(init_supplier))),
+		     NULL);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(device_init_parallel,
+			 ztest_unit_test(test_overlap),
+			 ztest_unit_test(test_barrier),
+			 ztest_unit_test(test_dependency),
+			 ztest_unit_test(test_ready));
+
+	ztest_run_test_suite(device_init_parallel);
+}
@@ -103,6 +103,7 @@ void print_paging_stats(struct k_mem_paging_stats_t *stats, const char *scope)
 #ifndef CONFIG_DEMAND_PAGING_ALLOW_IRQ
 	printk("    - in ISR: %lu\n", stats->pagefaults.in_isr);
 #endif
+	printk("    - Pages read ahead: %lu\n", stats->pagefaults.read_ahead);
 
 	printk("* Eviction (%s):\n", scope);
 	printk("    - Total pages evicted: %lu\n",
@@ -35,6 +35,9 @@ static struct k_thread tdata[THREAD_NUM];
 static char __aligned(BLK_ALIGN) tslab[BLK_SIZE2 * SLAB_BLOCKS];
 static atomic_t slab_id;
 static volatile bool success[THREAD_NUM];
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+static struct k_mem_slab_cache caches[SLAB_NUM][CONFIG_MP_NUM_CPUS];
+#endif
 
 /* thread entry simply invoke the APIs*/
 static void tmslab_api(void *p1, void *p2, void *p3)
@@ -77,6 +80,15 @@ void test_mslab_threadsafe(void)
 
 	k_mem_slab_init(&mslab2, tslab, BLK_SIZE2, SLAB_BLOCKS);
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	/* Per-CPU caches must not strand blocks when the slabs run
+	 * out and threads have to wait
+	 */
+	for (int i = 0; i < SLAB_NUM; i++) {
+		zassert_ok(k_mem_slab_cache_enable(slabs[i], caches[i]), NULL);
+	}
+#endif
+
 	/* create multiple threads to invoke same memory slab APIs*/
 	for (int i = 0; i < THREAD_NUM; i++) {
 		tid[i] = k_thread_create(&tdata[i], tstack[i], STACK_SIZE,
@@ -91,4 +103,9 @@ void test_mslab_threadsafe(void)
 		zassert_false(ret, "k_thread_join() failed");
 		zassert_true(success[i], "thread %d failed", i);
 	}
+
+	for (int i = 0; i < SLAB_NUM; i++) {
+		zassert_equal(k_mem_slab_num_used_get(slabs[i]), 0,
+			      "blocks leaked");
+	}
 }
@@ -283,8 +283,13 @@ void test_msgq_thread_overflow(void)
 	msgq_thread_overflow(&kmsgq);
 
 	/*verify the write pointer not reset to the buffer start*/
+#ifdef CONFIG_MSGQ_LOCKFREE
+	zassert_false(atomic_get(&msgq.prod_head) % msgq.max_msgs == 0,
+		"Invalid add operation of message queue");
+#else
 	zassert_false(msgq.write_ptr == msgq.buffer_start,
 		"Invalid add operation of message queue");
+#endif
 }
 
 #ifdef CONFIG_USERSPACE
@@ -451,6 +456,65 @@ void test_msgq_full(void)
 	k_thread_abort(tid);
 }
 
+#ifdef CONFIG_MSGQ_LOCKFREE
+static void forever_entry(void *p1, void *p2, void *p3)
+{
+	uint32_t rx_data;
+
+	/* runs once the test thread is blocked on the queue */
+	if (POINTER_TO_INT(p2)) {
+		zassert_equal(k_msgq_get(p1, &rx_data, K_NO_WAIT), 0, NULL);
+	} else {
+		zassert_equal(k_msgq_put(p1, &data[1], K_NO_WAIT), 0, NULL);
+	}
+}
+
+/**
+ * @brief Block forever on an empty and on a full lock-free queue
+ *
+ * @details A get from an empty queue and a put to a full queue with
+ * K_FOREVER must pend until a lower priority thread unblocks them, and
+ * not time out.
+ *
+ * @see k_msgq_get(), k_msgq_put()
+ */
+void test_msgq_forever(void)
+{
+	int pri = k_thread_priority_get(k_current_get()) + 1;
+	uint32_t rx_data;
+	k_tid_t tid;
+	int ret;
+
+	k_msgq_init(&msgq1, tbuffer1, MSG_SIZE, 1);
+
+	tid = k_thread_create(&tdata2, tstack2, STACK_SIZE, forever_entry,
+			      &msgq1, INT_TO_POINTER(0), NULL, pri, 0,
+			      K_NO_WAIT);
+	ret = k_msgq_get(&msgq1, &rx_data, K_FOREVER);
+	zassert_equal(ret, 0, "get with K_FOREVER did not block");
+	zassert_equal(rx_data, data[1], NULL);
+	k_thread_join(tid, K_FOREVER);
+
+	ret = k_msgq_put(&msgq1, &data[0], K_NO_WAIT);
+	zassert_equal(ret, 0, NULL);
+
+	tid = k_thread_create(&tdata2, tstack2, STACK_SIZE, forever_entry,
+			      &msgq1, INT_TO_POINTER(1), NULL, pri, 0,
+			      K_NO_WAIT);
+	ret = k_msgq_put(&msgq1, &data[1], K_FOREVER);
+	zassert_equal(ret, 0, "put with K_FOREVER did not block");
+	k_thread_join(tid, K_FOREVER);
+
+	zassert_equal(k_msgq_get(&msgq1, &rx_data, K_NO_WAIT), 0, NULL);
+	zassert_equal(rx_data, data[1], NULL);
+}
+#else
+void test_msgq_forever(void)
+{
+	ztest_test_skip();
+}
+#endif /* CONFIG_MSGQ_LOCKFREE */
+
 /**
  * @}
  */
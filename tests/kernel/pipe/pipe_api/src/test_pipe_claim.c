@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief Tests for the pipe claim / finish API
+ * @ingroup kernel_pipe_tests
+ * @{
+ */
+
+#include <ztest.h>
+#include <string.h>
+
+#define STACK_SIZE	(1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define CLAIM_LEN	8
+
+K_PIPE_DEFINE(claim_pipe, CLAIM_LEN, 4);
+
+static K_THREAD_STACK_DEFINE(claim_stack, STACK_SIZE);
+static struct k_thread claim_thread;
+
+static unsigned char claim_rx[CLAIM_LEN];
+static size_t claim_bytes;
+static int claim_ret;
+
+static void claim_fill(const char *src)
+{
+	unsigned char *dst;
+	size_t len = strlen(src);
+
+	zassert_equal(k_pipe_put_claim(&claim_pipe, &dst, len), len,
+		      "short put claim");
+	memcpy(dst, src, len);
+	zassert_equal(k_pipe_put_finish(&claim_pipe, len), 0,
+		      "put finish failed");
+}
+
+/**
+ * @brief Test claims across the end of the pipe's buffer
+ *
+ * Claims return contiguous space only, so a request that crosses the end
+ * of the buffer is split in two.
+ */
+void test_pipe_claim_wrap(void)
+{
+	unsigned char *p;
+
+	k_pipe_buffer_flush(&claim_pipe);
+
+	claim_fill("abcde");
+
+	zassert_equal(k_pipe_get_claim(&claim_pipe, &p, 3), 3, NULL);
+	zassert_mem_equal(p, "abc", 3, NULL);
+	zassert_equal(k_pipe_get_finish(&claim_pipe, 4), -EINVAL,
+		      "finished more than claimed");
+	zassert_equal(k_pipe_get_finish(&claim_pipe, 3), 0, NULL);
+
+	/* Three bytes left before the end, then three at the start */
+	zassert_equal(k_pipe_put_claim(&claim_pipe, &p, CLAIM_LEN), 3, NULL);
+	memcpy(p, "fgh", 3);
+	zassert_equal(k_pipe_put_claim(&claim_pipe, &p, CLAIM_LEN), 3, NULL);
+	zassert_equal(p, claim_pipe.buffer, "claim didn't wrap");
+	memcpy(p, "ijk", 3);
+	zassert_equal(k_pipe_put_claim(&claim_pipe, &p, CLAIM_LEN), 0,
+		      "claimed from a full pipe");
+	zassert_equal(k_pipe_put_finish(&claim_pipe, 6), 0, NULL);
+	zassert_equal(k_pipe_read_avail(&claim_pipe), CLAIM_LEN, NULL);
+
+	/* An unfinished part of a get claim is returned again */
+	zassert_equal(k_pipe_get_claim(&claim_pipe, &p, CLAIM_LEN), 5, NULL);
+	zassert_mem_equal(p, "defgh", 5, NULL);
+	zassert_equal(k_pipe_get_finish(&claim_pipe, 1), 0, NULL);
+	zassert_equal(k_pipe_get_claim(&claim_pipe, &p, CLAIM_LEN), 4, NULL);
+	zassert_mem_equal(p, "efgh", 4, NULL);
+	zassert_equal(k_pipe_get_finish(&claim_pipe, 4), 0, NULL);
+	zassert_equal(k_pipe_get_claim(&claim_pipe, &p, CLAIM_LEN), 3, NULL);
+	zassert_mem_equal(p, "ijk", 3, NULL);
+	zassert_equal(k_pipe_get_finish(&claim_pipe, 3), 0, NULL);
+
+	zassert_equal(k_pipe_get_claim(&claim_pipe, &p, CLAIM_LEN), 0,
+		      "claimed from an empty pipe");
+	zassert_equal(k_pipe_get_finish(&claim_pipe, 0), 0, NULL);
+}
+
+static void claim_reader(void *p1, void *p2, void *p3)
+{
+	claim_ret = k_pipe_get(&claim_pipe, claim_rx, 4, &claim_bytes, 4,
+			       K_FOREVER);
+}
+
+static void claim_writer(void *p1, void *p2, void *p3)
+{
+	claim_ret = k_pipe_put(&claim_pipe, "wxyz", 4, &claim_bytes, 4,
+			       K_FOREVER);
+}
+
+/**
+ * @brief Test that committing data wakes a blocked reader
+ */
+void test_pipe_claim_wakes_reader(void)
+{
+	k_pipe_buffer_flush(&claim_pipe);
+
+	k_tid_t tid = k_thread_create(&claim_thread, claim_stack, STACK_SIZE,
+				      claim_reader, NULL, NULL, NULL,
+				      K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+
+	/* Let the reader block on the empty pipe */
+	k_sleep(K_MSEC(10));
+
+	claim_fill("ab");
+	k_sleep(K_MSEC(10));
+	zassert_equal(k_thread_join(tid, K_NO_WAIT), -EBUSY,
+		      "reader woke early");
+
+	claim_fill("cdef");
+	zassert_equal(k_thread_join(tid, K_MSEC(100)), 0, "reader still blocked");
+	zassert_equal(claim_ret, 0, NULL);
+	zassert_equal(claim_bytes, 4, NULL);
+	zassert_mem_equal(claim_rx, "abcd", 4, NULL);
+
+	/* The rest stays buffered */
+	zassert_equal(k_pipe_read_avail(&claim_pipe), 2, NULL);
+}
+
+/**
+ * @brief Test that releasing data wakes a blocked writer
+ */
+void test_pipe_claim_wakes_writer(void)
+{
+	unsigned char *p;
+
+	k_pipe_buffer_flush(&claim_pipe);
+	claim_fill("abcdefgh");
+
+	k_tid_t tid = k_thread_create(&claim_thread, claim_stack, STACK_SIZE,
+				      claim_writer, NULL, NULL, NULL,
+				      K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+
+	/* Let the writer block on the full pipe */
+	k_sleep(K_MSEC(10));
+	zassert_equal(k_pipe_put_claim(&claim_pipe, &p, 1), 0,
+		      "claimed ahead of a blocked writer");
+
+	zassert_equal(k_pipe_get_claim(&claim_pipe, &p, 4), 4, NULL);
+	zassert_mem_equal(p, "abcd", 4, NULL);
+	zassert_equal(k_pipe_get_finish(&claim_pipe, 4), 0, NULL);
+
+	zassert_equal(k_thread_join(tid, K_MSEC(100)), 0, "writer still blocked");
+	zassert_equal(claim_ret, 0, NULL);
+	zassert_equal(claim_bytes, 4, NULL);
+
+	zassert_equal(k_pipe_get_claim(&claim_pipe, &p, CLAIM_LEN), 4, NULL);
+	zassert_mem_equal(p, "efgh", 4, NULL);
+	zassert_equal(k_pipe_get_finish(&claim_pipe, 4), 0, NULL);
+	zassert_equal(k_pipe_get_claim(&claim_pipe, &p, CLAIM_LEN), 4, NULL);
+	zassert_mem_equal(p, "wxyz", 4, NULL);
+	zassert_equal(k_pipe_get_finish(&claim_pipe, 4), 0, NULL);
+}
+
+/**
+ * @}
+ */
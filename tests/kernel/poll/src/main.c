@@ -15,6 +15,10 @@ extern void test_poll_threadstate(void);
 extern void test_poll_grant_access(void);
 extern void test_poll_fail_grant_access(void);
 extern void test_detect_is_polling(void);
+extern void test_poll_msgq_space(void);
+extern void test_poll_pipe_data(void);
+extern void test_poll_event_posted(void);
+extern void test_poll_mutex_available(void);
 #ifdef CONFIG_USERSPACE
 extern void test_k_poll_user_num_err(void);
 extern void test_k_poll_user_mem_err(void);
@@ -74,6 +78,10 @@ void test_main(void)
 			 ztest_unit_test(test_poll_multi),
 			 ztest_1cpu_unit_test(test_poll_threadstate),
 			 ztest_1cpu_unit_test(test_detect_is_polling),
+			 ztest_1cpu_unit_test(test_poll_msgq_space),
+			 ztest_1cpu_unit_test(test_poll_pipe_data),
+			 ztest_1cpu_unit_test(test_poll_event_posted),
+			 ztest_1cpu_unit_test(test_poll_mutex_available),
 			 ztest_user_unit_test(test_k_poll_user_num_err),
 			 ztest_user_unit_test(test_k_poll_user_mem_err),
 			 ztest_user_unit_test(test_k_poll_user_type_sem_err),
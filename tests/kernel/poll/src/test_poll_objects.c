@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <zephyr/kernel.h>
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define OBJ_MSG_SIZE 4
+#define OBJ_MAX_MSGS 2
+#define OBJ_PIPE_SIZE 8
+#define OBJ_EVENT BIT(2)
+#define OBJ_DELAY_MS 50
+
+K_MSGQ_DEFINE(obj_msgq, OBJ_MSG_SIZE, OBJ_MAX_MSGS, 4);
+K_PIPE_DEFINE(obj_pipe, OBJ_PIPE_SIZE, 4);
+#ifdef CONFIG_EVENTS
+K_EVENT_DEFINE(obj_event);
+#endif
+K_MUTEX_DEFINE(obj_mutex);
+static K_SEM_DEFINE(obj_ready, 0, 1);
+
+static struct k_thread obj_thread;
+static K_THREAD_STACK_DEFINE(obj_stack, STACK_SIZE);
+
+static void obj_msgq_get(void *p1, void *p2, void *p3)
+{
+	char buf[OBJ_MSG_SIZE];
+
+	k_msleep(OBJ_DELAY_MS);
+	zassert_equal(k_msgq_get(&obj_msgq, buf, K_NO_WAIT), 0, NULL);
+}
+
+static void obj_pipe_put(void *p1, void *p2, void *p3)
+{
+	size_t written;
+
+	k_msleep(OBJ_DELAY_MS);
+	zassert_equal(k_pipe_put(&obj_pipe, "abc", 3, &written, 3, K_NO_WAIT),
+		      0, NULL);
+}
+
+#ifdef CONFIG_EVENTS
+static void obj_event_post(void *p1, void *p2, void *p3)
+{
+	k_msleep(OBJ_DELAY_MS);
+	k_event_post(&obj_event, OBJ_EVENT);
+}
+#endif
+
+static void obj_mutex_hold(void *p1, void *p2, void *p3)
+{
+	zassert_equal(k_mutex_lock(&obj_mutex, K_NO_WAIT), 0, NULL);
+	k_sem_give(&obj_ready);
+	k_msleep(OBJ_DELAY_MS);
+	zassert_equal(k_mutex_unlock(&obj_mutex), 0, NULL);
+}
+
+static void obj_spawn(k_thread_entry_t entry)
+{
+	k_thread_create(&obj_thread, obj_stack, STACK_SIZE, entry,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+}
+
+/* Polls event, first without waiting, then until the thread started
+ * by the test makes its condition true.
+ */
+static void obj_poll(struct k_poll_event *event, uint32_t state)
+{
+	zassert_equal(k_poll(event, 1, K_NO_WAIT), -EAGAIN,
+		      "condition met too soon");
+	zassert_equal(event->state, K_POLL_STATE_NOT_READY, NULL);
+
+	zassert_equal(k_poll(event, 1, K_MSEC(OBJ_DELAY_MS * 10)), 0,
+		      "poll timed out");
+	zassert_equal(event->state, state, "wrong state 0x%x", event->state);
+
+	k_thread_join(&obj_thread, K_FOREVER);
+}
+
+/**
+ * @brief Test polling for free space in a message queue
+ *
+ * @ingroup kernel_poll_tests
+ */
+void test_poll_msgq_space(void)
+{
+	char msg[OBJ_MSG_SIZE] = { 0 };
+	struct k_poll_event event = K_POLL_EVENT_INITIALIZER(
+		K_POLL_TYPE_MSGQ_SPACE_AVAILABLE, K_POLL_MODE_NOTIFY_ONLY,
+		&obj_msgq);
+
+	k_msgq_purge(&obj_msgq);
+	for (int i = 0; i < OBJ_MAX_MSGS; i++) {
+		zassert_equal(k_msgq_put(&obj_msgq, msg, K_NO_WAIT), 0, NULL);
+	}
+
+	obj_spawn(obj_msgq_get);
+	obj_poll(&event, K_POLL_STATE_MSGQ_SPACE_AVAILABLE);
+	zassert_equal(k_msgq_put(&obj_msgq, msg, K_NO_WAIT), 0, NULL);
+	k_msgq_purge(&obj_msgq);
+}
+
+/**
+ * @brief Test polling for data in a pipe
+ *
+ * @ingroup kernel_poll_tests
+ */
+void test_poll_pipe_data(void)
+{
+	unsigned char buf[OBJ_PIPE_SIZE];
+	size_t read;
+	struct k_poll_event event = K_POLL_EVENT_INITIALIZER(
+		K_POLL_TYPE_PIPE_DATA_AVAILABLE, K_POLL_MODE_NOTIFY_ONLY,
+		&obj_pipe);
+
+	k_pipe_flush(&obj_pipe);
+
+	obj_spawn(obj_pipe_put);
+	obj_poll(&event, K_POLL_STATE_PIPE_DATA_AVAILABLE);
+	zassert_equal(k_pipe_get(&obj_pipe, buf, sizeof(buf), &read, 1,
+				 K_NO_WAIT), 0, NULL);
+	zassert_equal(read, 3, NULL);
+}
+
+/**
+ * @brief Test polling for events posted to an event object
+ *
+ * @ingroup kernel_poll_tests
+ */
+void test_poll_event_posted(void)
+{
+#ifdef CONFIG_EVENTS
+	struct k_poll_event event = K_POLL_EVENT_INITIALIZER(
+		K_POLL_TYPE_EVENT_POSTED, K_POLL_MODE_NOTIFY_ONLY,
+		&obj_event);
+
+	k_event_set(&obj_event, 0);
+
+	obj_spawn(obj_event_post);
+	obj_poll(&event, K_POLL_STATE_EVENT_POSTED);
+	zassert_equal(k_event_wait(&obj_event, OBJ_EVENT, false, K_NO_WAIT),
+		      OBJ_EVENT, NULL);
+	k_event_set(&obj_event, 0);
+#else
+	ztest_test_skip();
+#endif
+}
+
+/**
+ * @brief Test polling for a mutex to be unlocked
+ *
+ * @ingroup kernel_poll_tests
+ */
+void test_poll_mutex_available(void)
+{
+	struct k_poll_event event = K_POLL_EVENT_INITIALIZER(
+		K_POLL_TYPE_MUTEX_AVAILABLE, K_POLL_MODE_NOTIFY_ONLY,
+		&obj_mutex);
+
+	obj_spawn(obj_mutex_hold);
+	k_sem_take(&obj_ready, K_FOREVER);
+
+	obj_poll(&event, K_POLL_STATE_MUTEX_AVAILABLE);
+	zassert_equal(k_mutex_lock(&obj_mutex, K_NO_WAIT), 0, NULL);
+	zassert_equal(k_mutex_unlock(&obj_mutex), 0, NULL);
+}
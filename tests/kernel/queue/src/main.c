@@ -52,6 +52,7 @@ void test_main(void)
 			 ztest_1cpu_unit_test(test_queue_get_fail),
 			 ztest_1cpu_unit_test(test_queue_loop),
 			 ztest_unit_test(test_queue_alloc),
+			 ztest_unit_test(test_queue_node_pool),
 			 ztest_1cpu_unit_test(test_queue_poll_race),
 			 ztest_unit_test(test_multiple_queues),
 			 ztest_1cpu_unit_test(test_queue_multithread_competition),
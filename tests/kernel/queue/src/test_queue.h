@@ -32,6 +32,7 @@ extern void test_queue_peek_tail_null(void);
 extern void test_queue_cancel_wait_error(void);
 #endif
 extern void test_queue_alloc(void);
+extern void test_queue_node_pool(void);
 extern void test_queue_poll_race(void);
 extern void test_multiple_queues(void);
 extern void test_queue_multithread_competition(void);
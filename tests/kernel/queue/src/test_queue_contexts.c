@@ -312,6 +312,46 @@ void test_queue_alloc(void)
 	tqueue_alloc(&queue);
 }
 
+/**
+ * @brief Test k_queue_alloc_append() with preallocated nodes
+ *
+ * @details Without a resource pool, only as many items as the queue was
+ * given nodes can be added, and nodes are reused once items are removed.
+ *
+ * @ingroup kernel_queue_tests
+ *
+ * @see k_queue_node_pool_init(), k_queue_alloc_append()
+ */
+void test_queue_node_pool(void)
+{
+#ifdef CONFIG_QUEUE_NODE_POOL
+	static struct k_queue_node nodes[LIST_LEN];
+
+	k_queue_init(&queue);
+	k_queue_node_pool_init(&queue, nodes, ARRAY_SIZE(nodes));
+	k_thread_heap_assign(k_current_get(), NULL);
+
+	for (int round = 0; round < 2; round++) {
+		for (int i = 0; i < LIST_LEN; i++) {
+			zassert_equal(k_queue_alloc_append(&queue, &data[i]), 0,
+				      "no node for item %d", i);
+		}
+		zassert_equal(k_queue_alloc_append(&queue, &data_p[0]), -ENOMEM,
+			      "appended past the end of the pool");
+
+		for (int i = 0; i < LIST_LEN; i++) {
+			zassert_equal_ptr(k_queue_get(&queue, K_NO_WAIT),
+					  &data[i], NULL);
+		}
+		zassert_true(k_queue_is_empty(&queue), NULL);
+	}
+
+	k_thread_heap_assign(k_current_get(), &test_pool);
+#else
+	ztest_test_skip();
+#endif
+}
+
 
 /* Does nothing but read items out of the queue and verify that they
  * are non-null.  Two such threads will be created.
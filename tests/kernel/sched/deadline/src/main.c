@@ -211,11 +211,114 @@ void test_unqueued(void)
 	}
 }
 
+#ifdef CONFIG_SCHED_CBS
+volatile uint32_t cbs_runs[2];
+
+void cbs_worker(void *p1, void *p2, void *p3)
+{
+	volatile uint32_t *runs = p1;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (1) {
+		k_busy_wait(100);
+		(*runs)++;
+	}
+}
+
+static k_tid_t cbs_create(int i)
+{
+	return k_thread_create(&worker_threads[i], worker_stacks[i],
+			       STACK_SIZE, cbs_worker, (void *)&cbs_runs[i],
+			       NULL, NULL, K_LOWEST_APPLICATION_THREAD_PRIO,
+			       0, K_FOREVER);
+}
+#endif
+
+/**
+ * @brief Validate the admission test of constant bandwidth servers
+ *
+ * @ingroup kernel_sched_tests
+ */
+void test_cbs_admission(void)
+{
+#ifdef CONFIG_SCHED_CBS
+	k_tid_t a = cbs_create(0);
+	k_tid_t b = cbs_create(1);
+
+	zassert_equal(k_thread_cbs_set(a, 6000, 10000), 0, "");
+	zassert_equal(k_thread_cbs_set(b, 5000, 10000), -ENOSPC,
+		      "overload admitted");
+	zassert_equal(k_thread_cbs_set(b, 4000, 10000), 0, "");
+	zassert_equal(k_thread_cbs_set(b, 20000, 10000), -EINVAL,
+		      "budget longer than period admitted");
+
+	/* Changing a reservation only counts the others against it */
+	zassert_equal(k_thread_cbs_set(a, 7000, 10000), -ENOSPC, "");
+	zassert_equal(k_thread_cbs_set(a, 3000, 5000), 0, "");
+
+	/* Released reservations are available again */
+	zassert_equal(k_thread_cbs_set(a, 0, 0), 0, "");
+	zassert_equal(k_thread_cbs_set(b, 10000, 10000), 0, "");
+
+	k_thread_abort(b);
+	zassert_equal(k_thread_cbs_set(b, 1000, 10000), -EINVAL,
+		      "reservation for an exited thread");
+	zassert_equal(k_thread_cbs_set(a, 10000, 10000), 0,
+		      "exiting thread kept its reservation");
+	k_thread_abort(a);
+#else
+	ztest_test_skip();
+#endif
+}
+
+/**
+ * @brief Validate that busy servers get CPU time in proportion to
+ * their bandwidth
+ *
+ * @details Two servers at the same priority never block.  With plain
+ * deadlines, the first to run would keep the CPU; with budgets enforced
+ * they share it in the ratio of their reservations.
+ *
+ * @ingroup kernel_sched_tests
+ */
+void test_cbs_budget(void)
+{
+#ifdef CONFIG_SCHED_CBS
+	k_tid_t a = cbs_create(0);
+	k_tid_t b = cbs_create(1);
+	uint32_t runs_a, runs_b;
+
+	cbs_runs[0] = 0;
+	cbs_runs[1] = 0;
+	zassert_equal(k_thread_cbs_set(a, 2000, 10000), 0, "");
+	zassert_equal(k_thread_cbs_set(b, 5000, 10000), 0, "");
+
+	k_thread_start(a);
+	k_thread_start(b);
+	k_sleep(K_MSEC(500));
+	runs_a = cbs_runs[0];
+	runs_b = cbs_runs[1];
+	k_thread_abort(a);
+	k_thread_abort(b);
+
+	zassert_true(runs_a > 0, "server a starved");
+	zassert_true((runs_b * 2 > runs_a * 3) && (runs_b < runs_a * 4),
+		     "servers ran %u and %u times, expected 2:5",
+		     runs_a, runs_b);
+#else
+	ztest_test_skip();
+#endif
+}
+
 void test_main(void)
 {
 	ztest_test_suite(suite_deadline,
 			 ztest_unit_test(test_deadline),
 			 ztest_unit_test(test_yield),
-			 ztest_unit_test(test_unqueued));
+			 ztest_unit_test(test_unqueued),
+			 ztest_unit_test(test_cbs_admission),
+			 ztest_unit_test(test_cbs_budget));
 	ztest_run_test_suite(suite_deadline);
 }
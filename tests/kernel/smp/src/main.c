@@ -634,6 +634,74 @@ void test_smp_ipi(void)
 	}
 }
 
+#ifdef CONFIG_TRACE_SCHED_IPI
+static volatile bool ipi_spin;
+static atomic_t ipi_spinners;
+
+static void ipi_spinner(void *p1, void *p2, void *p3)
+{
+	atomic_inc(&ipi_spinners);
+	while (ipi_spin) {
+	}
+}
+
+static void ipi_nop(void *p1, void *p2, void *p3)
+{
+}
+#endif
+
+/**
+ * @brief Test that scheduler IPIs only target CPUs that would switch
+ *
+ * @ingroup kernel_smp_tests
+ *
+ * @details With every other CPU running a cooperative thread, readying a
+ * preemptible thread must not flag an IPI. Once those CPUs are idle,
+ * readying one must.
+ */
+void test_smp_ipi_targeted(void)
+{
+#ifndef CONFIG_TRACE_SCHED_IPI
+	ztest_test_skip();
+#else
+	atomic_val_t flagged, skipped;
+
+	ipi_spin = true;
+	atomic_clear(&ipi_spinners);
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS - 1; i++) {
+		k_thread_create(&tthread[i], tstack[i], STACK_SIZE,
+				ipi_spinner, NULL, NULL, NULL,
+				K_PRIO_COOP(1), 0, K_NO_WAIT);
+	}
+	while (atomic_get(&ipi_spinners) < CONFIG_MP_NUM_CPUS - 1) {
+		k_busy_wait(100);
+	}
+
+	flagged = atomic_get(&_kernel.ipi_stats.flagged);
+	skipped = atomic_get(&_kernel.ipi_stats.skipped);
+	k_thread_create(&t2, t2_stack, T2_STACK_SIZE, ipi_nop, NULL, NULL, NULL,
+			K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	zassert_equal(atomic_get(&_kernel.ipi_stats.flagged), flagged,
+		      "IPI flagged with no CPU to switch");
+	zassert_true(atomic_get(&_kernel.ipi_stats.skipped) > skipped,
+		     "ready thread not counted");
+
+	ipi_spin = false;
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS - 1; i++) {
+		k_thread_join(&tthread[i], K_FOREVER);
+	}
+	k_thread_join(&t2, K_FOREVER);
+
+	/* The other CPUs are idle now */
+	flagged = atomic_get(&_kernel.ipi_stats.flagged);
+	k_thread_create(&t2, t2_stack, T2_STACK_SIZE, ipi_nop, NULL, NULL, NULL,
+			K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	zassert_true(atomic_get(&_kernel.ipi_stats.flagged) > flagged,
+		     "no IPI flagged with idle CPUs");
+	k_thread_join(&t2, K_FOREVER);
+#endif
+}
+
 void k_sys_fatal_error_handler(unsigned int reason, const z_arch_esf_t *pEsf)
 {
 	static int trigger;
@@ -952,6 +1020,86 @@ void test_inc_concurrency(void)
 			"total count %d is wrong(M)", global_cnt);
 }
 
+#ifdef CONFIG_MUTEX_ADAPTIVE_SPIN_STATS
+static struct k_mutex spin_mutex;
+static volatile bool spin_locked;
+
+static void spin_owner(void *p1, void *p2, void *p3)
+{
+	k_mutex_lock(&spin_mutex, K_FOREVER);
+	spin_locked = true;
+	k_busy_wait((uint32_t)(uintptr_t)p1);
+	k_mutex_unlock(&spin_mutex);
+}
+
+static void spin_lock_contended(uint32_t hold_us)
+{
+	spin_locked = false;
+
+	k_thread_create(&t2, t2_stack, T2_STACK_SIZE, spin_owner,
+			(void *)(uintptr_t)hold_us, NULL, NULL,
+			K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+
+	/* Keep this CPU busy so the owner runs on the other one */
+	while (!spin_locked) {
+	}
+
+	zassert_equal(k_mutex_lock(&spin_mutex, K_FOREVER), 0, NULL);
+	k_mutex_unlock(&spin_mutex);
+
+	k_thread_join(&t2, K_FOREVER);
+}
+#endif
+
+/* Rounds of each hold time.  The hold times are wall-clock, and a
+ * virtual CPU can be stalled by the host at any time, so single
+ * rounds may go either way and only the majority is checked.
+ */
+#define SPIN_ROUNDS 8
+
+/**
+ * @brief Test adaptive spinning on mutexes
+ *
+ * @ingroup kernel_smp_tests
+ *
+ * @details A mutex held by a thread running on another CPU for less than
+ * CONFIG_MUTEX_ADAPTIVE_SPIN_US is mostly taken by spinning, while one
+ * held for longer mostly makes the locker give up spinning and pend.
+ */
+void test_mutex_adaptive_spin(void)
+{
+#ifndef CONFIG_MUTEX_ADAPTIVE_SPIN_STATS
+	ztest_test_skip();
+#else
+	struct k_mutex_spin_stats stats;
+	uint32_t hits, misses;
+
+	k_mutex_init(&spin_mutex);
+
+	for (int i = 0; i < SPIN_ROUNDS; i++) {
+		spin_lock_contended(CONFIG_MUTEX_ADAPTIVE_SPIN_US / 4);
+	}
+
+	k_mutex_spin_stats_get(&spin_mutex, &stats);
+	zassert_true(stats.hits > stats.misses,
+		     "short holds: %u spins taken, %u given up",
+		     stats.hits, stats.misses);
+
+	hits = stats.hits;
+	misses = stats.misses;
+
+	for (int i = 0; i < SPIN_ROUNDS; i++) {
+		spin_lock_contended(CONFIG_MUTEX_ADAPTIVE_SPIN_US * 10);
+	}
+
+	k_mutex_spin_stats_get(&spin_mutex, &stats);
+	hits = stats.hits - hits;
+	misses = stats.misses - misses;
+	zassert_true(misses > hits,
+		     "long holds: %u spins taken, %u given up", hits, misses);
+#endif
+}
+
 /**
  * @brief Torture test for context switching code
  *
@@ -1028,11 +1176,13 @@ void test_main(void)
 			 ztest_unit_test(test_sleep_threads),
 			 ztest_unit_test(test_wakeup_threads),
 			 ztest_unit_test(test_smp_ipi),
+			 ztest_unit_test(test_smp_ipi_targeted),
 			 ztest_unit_test(test_get_cpu),
 			 ztest_unit_test(test_fatal_on_smp),
 			 ztest_unit_test(test_workq_on_smp),
 			 ztest_unit_test(test_smp_release_global_lock),
 			 ztest_unit_test(test_inc_concurrency),
+			 ztest_unit_test(test_mutex_adaptive_spin),
 			 ztest_unit_test(test_smp_switch_torture)
 			 );
 	ztest_run_test_suite(smp);
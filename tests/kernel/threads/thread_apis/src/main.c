@@ -617,6 +617,72 @@ void test_k_busy_wait_user(void)
 	k_thread_abort(tid);
 }
 
+#ifdef CONFIG_SCHED_LATENCY_STATS
+#define LATENCY_WAKEUPS 10
+
+static K_SEM_DEFINE(latency_sem, 0, 1);
+
+static void latency_entry(void *p1, void *p2, void *p3)
+{
+	for (int i = 0; i < LATENCY_WAKEUPS; i++) {
+		k_sem_take(&latency_sem, K_FOREVER);
+	}
+}
+
+static uint32_t hist_sum(const uint32_t *hist)
+{
+	uint32_t sum = 0;
+
+	for (int i = 0; i < CONFIG_SCHED_LATENCY_STATS_BUCKETS; i++) {
+		sum += hist[i];
+	}
+
+	return sum;
+}
+#endif
+
+/* A higher priority thread woken up repeatedly by this one has each
+ * wakeup and run slice accounted, and preempts this one each time.
+ */
+void test_thread_latency_stats(void)
+{
+#ifndef CONFIG_SCHED_LATENCY_STATS
+	ztest_test_skip();
+#else
+	struct k_sched_latency_stats stats, cpu_before, cpu_after;
+	k_tid_t tid;
+
+	zassert_equal(k_thread_latency_stats_get(NULL, &stats), -EINVAL, NULL);
+	zassert_equal(k_cpu_latency_stats_get(CONFIG_MP_NUM_CPUS, &stats),
+		      -EINVAL, NULL);
+
+	k_cpu_latency_stats_get(0, &cpu_before);
+
+	tid = k_thread_create(&tdata, tstack, STACK_SIZE, latency_entry,
+			      NULL, NULL, NULL,
+			      k_thread_priority_get(k_current_get()) - 1,
+			      0, K_NO_WAIT);
+
+	for (int i = 0; i < LATENCY_WAKEUPS; i++) {
+		k_sem_give(&latency_sem);
+	}
+
+	k_thread_join(tid, K_FOREVER);
+	k_cpu_latency_stats_get(0, &cpu_after);
+
+	/* Started once, then woken up by each give */
+	zassert_equal(k_thread_latency_stats_get(tid, &stats), 0, NULL);
+	zassert_equal(hist_sum(stats.wakeup), LATENCY_WAKEUPS + 1, NULL);
+	zassert_equal(hist_sum(stats.slice), LATENCY_WAKEUPS + 1, NULL);
+	zassert_equal(stats.preempted, 0, NULL);
+
+	zassert_true(hist_sum(cpu_after.wakeup) - hist_sum(cpu_before.wakeup) >=
+		     LATENCY_WAKEUPS + 1, NULL);
+	zassert_true(cpu_after.preempted - cpu_before.preempted >=
+		     LATENCY_WAKEUPS + 1, "giving thread not preempted");
+#endif
+}
+
 #define INT_ARRAY_SIZE 128
 int large_stack(size_t *space)
 {
@@ -708,7 +774,8 @@ void test_main(void)
 			 ztest_unit_test(test_abort_from_isr_not_self),
 			 ztest_user_unit_test(test_thread_timeout_remaining_expires),
 			 ztest_unit_test(test_k_busy_wait),
-			 ztest_1cpu_user_unit_test(test_k_busy_wait_user)
+			 ztest_1cpu_user_unit_test(test_k_busy_wait_user),
+			 ztest_1cpu_unit_test(test_thread_latency_stats)
 			 );
 
 	ztest_run_test_suite(threads_lifecycle);
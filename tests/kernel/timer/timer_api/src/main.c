@@ -811,6 +811,83 @@ void test_sleep_abs(void)
 		     start + sleep_ticks, end, late);
 }
 
+#define CASCADE_TIMERS 4
+
+/* Skip the timeouts beyond the next 4096 tick boundary when they are
+ * further away than this, i.e. at low tick rates
+ */
+#define CASCADE_BUDGET_MS 5000
+
+static struct k_timer cascade_timers[CASCADE_TIMERS];
+static int64_t cascade_ticks[CASCADE_TIMERS];
+
+static void cascade_expire(struct k_timer *timer)
+{
+	cascade_ticks[timer - cascade_timers] = k_uptime_ticks();
+}
+
+/**
+ * @brief Test timeouts expiring across 64 and 4096 tick boundaries
+ *
+ * Starts timers expiring just after the next multiple of 64 and 4096
+ * ticks.  The timing wheel files such timeouts in its upper levels and
+ * moves them down as the boundaries are crossed, each timer must still
+ * expire at its exact tick.
+ *
+ * @ingroup kernel_timer_tests
+ *
+ * @see k_timer_start(), k_timer_expires_ticks()
+ */
+void test_timer_cascade(void)
+{
+#ifdef CONFIG_TIMEOUT_64BIT
+	k_ticks_t late_max = k_us_to_ticks_ceil32(250);
+	int64_t target[CASCADE_TIMERS];
+	int64_t now, last;
+	int count;
+
+	if (!IS_ENABLED(CONFIG_MULTITHREADING)) {
+		/* k_sleep is not supported when multithreading is off. */
+		return;
+	}
+
+	k_usleep(1); /* tick align */
+
+	now = k_uptime_ticks();
+	/* One tick past the next boundaries, and a level 0 span later */
+	target[0] = (now | 63) + 2;
+	target[1] = target[0] + 64;
+	target[2] = (now | 4095) + 2;
+	target[3] = target[2] + 64;
+
+	count = k_ticks_to_ms_ceil64(target[3] - now) <= CASCADE_BUDGET_MS ?
+		CASCADE_TIMERS : 2;
+
+	last = 0;
+	for (int i = 0; i < count; i++) {
+		k_timer_init(&cascade_timers[i], cascade_expire, NULL);
+		cascade_ticks[i] = 0;
+		k_timer_start(&cascade_timers[i], K_TIMEOUT_ABS_TICKS(target[i]),
+			      K_NO_WAIT);
+		zassert_equal(k_timer_expires_ticks(&cascade_timers[i]),
+			      target[i], "timer %d expires at %lld, not %lld",
+			      i, k_timer_expires_ticks(&cascade_timers[i]),
+			      target[i]);
+		last = MAX(last, target[i]);
+	}
+
+	k_sleep(K_TIMEOUT_ABS_TICKS(last + late_max + 1));
+
+	for (int i = 0; i < count; i++) {
+		k_timer_stop(&cascade_timers[i]);
+		zassert_true(cascade_ticks[i] >= target[i] &&
+			     cascade_ticks[i] - target[i] < late_max,
+			     "timer %d expired at %lld, not %lld", i,
+			     cascade_ticks[i], target[i]);
+	}
+#endif
+}
+
 static void timer_init(struct k_timer *timer, k_timer_expiry_t expiry_fn,
 		       k_timer_stop_t stop_fn)
 {
@@ -853,6 +930,7 @@ void test_main(void)
 			 ztest_user_unit_test(test_timer_user_data),
 			 ztest_user_unit_test(test_timer_remaining),
 			 ztest_user_unit_test(test_timeout_abs),
-			 ztest_user_unit_test(test_sleep_abs));
+			 ztest_user_unit_test(test_sleep_abs),
+			 ztest_unit_test(test_timer_cascade));
 	ztest_run_test_suite(timer_api);
 }
@@ -321,6 +321,42 @@ static void test_1cpu_simple_queue(void)
 	zassert_equal(rc, 0, NULL);
 }
 
+/* Single-CPU check submitting several items in one batch. */
+static void test_1cpu_batch_queue(void)
+{
+	struct k_work *batch[] = { &work, &work1, &work };
+	int rc;
+
+	reset_counters();
+	k_work_init(&work, counter_handler);
+	k_work_init(&work1, counter_handler);
+
+	/* The repeated item is already queued when it comes up again */
+	rc = k_work_submit_batch_to_queue(&coophi_queue, batch,
+					  ARRAY_SIZE(batch));
+	zassert_equal(rc, 2, NULL);
+	zassert_equal(k_work_busy_get(&work), K_WORK_QUEUED, NULL);
+	zassert_equal(k_work_busy_get(&work1), K_WORK_QUEUED, NULL);
+	zassert_equal(coophi_counter(), 0, NULL);
+
+	/* Let them run, then check both finished. */
+	k_sleep(K_TICKS(1));
+	zassert_equal(coophi_counter(), 2, NULL);
+	zassert_equal(k_work_busy_get(&work), 0, NULL);
+	zassert_equal(k_work_busy_get(&work1), 0, NULL);
+
+	/* Flush the sync state from completion (the semaphore
+	 * saturates at one).
+	 */
+	rc = k_sem_take(&sync_sem, K_NO_WAIT);
+	zassert_equal(rc, 0, NULL);
+
+	/* Nothing is newly queued without a queue to submit to */
+	k_work_init(&work, counter_handler);
+	rc = k_work_submit_batch_to_queue(NULL, batch, 1);
+	zassert_equal(rc, -EINVAL, NULL);
+}
+
 /* Basic SMP check submitting with a non-blocking handler. */
 static void test_smp_simple_queue(void)
 {
@@ -1571,6 +1607,7 @@ void test_main(void)
 			 ztest_unit_test(test_queue_start),
 			 ztest_unit_test(test_null_queue),
 			 ztest_1cpu_unit_test(test_1cpu_simple_queue),
+			 ztest_1cpu_unit_test(test_1cpu_batch_queue),
 			 ztest_unit_test(test_smp_simple_queue),
 			 ztest_1cpu_unit_test(test_1cpu_sync_queue),
 			 ztest_1cpu_unit_test(test_1cpu_reentrant_queue),
@@ -259,6 +259,11 @@ static void test_solo_free_header(void)
 
 	TC_PRINT("Testing solo free header in a heap\n");
 
+	if (IS_ENABLED(CONFIG_SYS_HEAP_TLSF)) {
+		/* The bigger heap header doesn't fit such a tiny heap */
+		ztest_test_skip();
+	}
+
 	sys_heap_init(&heap, heapmem, SOLO_FREE_HEADER_HEAP_SZ);
 	if (sizeof(void *) > 4U) {
 		sys_heap_alloc(&heap, 1);
@@ -485,6 +490,85 @@ static void test_heap_listeners(void)
 #endif /* CONFIG_SYS_HEAP_LISTENER */
 }
 
+#ifdef CONFIG_SYS_HEAP_CACHE
+static struct sys_heap_cache cache;
+
+static void *cache_testalloc(void *arg, size_t bytes)
+{
+	void *ret = sys_heap_cache_get(&cache, bytes);
+
+	if (ret == NULL) {
+		ret = sys_heap_cache_refill(&cache, arg, bytes);
+	}
+	if (ret == NULL) {
+		ret = sys_heap_alloc(arg, bytes);
+	}
+	if (ret != NULL) {
+		zassert_true(sys_heap_usable_size(arg, ret) >= bytes, "");
+	}
+
+	fill_block(ret, bytes);
+	sys_heap_validate(arg);
+	return ret;
+}
+
+static void cache_testfree(void *arg, void *p)
+{
+	check_fill(p);
+	if (!sys_heap_cache_put(&cache, arg, p)) {
+		sys_heap_cache_trim(&cache, arg, p);
+	}
+	sys_heap_validate(arg);
+}
+#endif
+
+/* Run the stress rig through a size-class cache, then check that
+ * flushing it leaves a consistent heap and an empty cache.
+ */
+static void test_heap_cache(void)
+{
+#ifdef CONFIG_SYS_HEAP_CACHE
+	struct sys_heap heap;
+	struct z_heap_stress_result result;
+	struct sys_heap_runtime_stats before, after;
+	size_t cached = 0;
+
+	TC_PRINT("Testing size-class cache on a (%d byte) heap\n",
+		 (int) SMALL_HEAP_SZ);
+
+	sys_heap_init(&heap, heapmem, SMALL_HEAP_SZ);
+	sys_heap_cache_init(&cache, 0);
+
+	sys_heap_stress(cache_testalloc, cache_testfree, &heap,
+			SMALL_HEAP_SZ, ITERATION_COUNT,
+			scratchmem, sizeof(scratchmem),
+			50, &result);
+	log_result(SMALL_HEAP_SZ, &result);
+
+	zassert_true(cache.hits > 0, "no allocation served from the cache");
+
+	sys_heap_runtime_stats_get(&heap, &before);
+	for (int i = 0; i < SYS_HEAP_CACHE_CLASSES; i++) {
+		for (void *p = cache.bins[i]; p != NULL; p = *(void **)p) {
+			cached += sys_heap_usable_size(&heap, p);
+		}
+	}
+
+	sys_heap_cache_flush(&cache, &heap);
+	zassert_true(sys_heap_validate(&heap), "");
+	for (int i = 0; i < SYS_HEAP_CACHE_CLASSES; i++) {
+		zassert_is_null(cache.bins[i], "");
+		zassert_equal(cache.count[i], 0, "");
+	}
+
+	/* Everything that was cached is free again */
+	sys_heap_runtime_stats_get(&heap, &after);
+	zassert_true(after.free_bytes >= before.free_bytes + cached, "");
+#else
+	ztest_test_skip();
+#endif
+}
+
 void test_main(void)
 {
 	ztest_test_suite(lib_heap_test,
@@ -493,7 +577,8 @@ void test_main(void)
 			 ztest_unit_test(test_fragmentation),
 			 ztest_unit_test(test_big_heap),
 			 ztest_unit_test(test_solo_free_header),
-			 ztest_unit_test(test_heap_listeners)
+			 ztest_unit_test(test_heap_listeners),
+			 ztest_unit_test(test_heap_cache)
 			 );
 
 	ztest_run_test_suite(lib_heap_test);
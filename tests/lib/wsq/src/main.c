@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <zephyr/zephyr.h>
+#include <zephyr/random/rand32.h>
+#include <ztest.h>
+#include <zephyr/sys/wsq.h>
+
+#define NUM_THREADS CONFIG_MP_NUM_CPUS
+#define NUM_ITEMS (NUM_THREADS * 8)
+#define STRESS_MS 1000
+
+K_WSQ_DEFINE(wsq, NUM_THREADS, 2048);
+
+static struct k_wsq_work item;
+static struct k_wsq_sync sync;
+static atomic_t run_count;
+static atomic_t resubmits;
+static K_SEM_DEFINE(started, 0, 1);
+static K_SEM_DEFINE(release, 0, 1);
+
+static void count_handler(struct k_wsq_work *work)
+{
+	atomic_inc(&run_count);
+	if (atomic_dec(&resubmits) > 0) {
+		zassert_equal(k_wsq_submit(&wsq, work), 2,
+			      "resubmit from handler didn't requeue");
+	}
+}
+
+static void blocking_handler(struct k_wsq_work *work)
+{
+	k_sem_give(&started);
+	k_sem_take(&release, K_FOREVER);
+	atomic_inc(&run_count);
+}
+
+static void test_simple(void)
+{
+	atomic_set(&run_count, 0);
+	atomic_set(&resubmits, 0);
+	k_wsq_work_init(&item, count_handler);
+
+	zassert_equal(k_wsq_flush(&item, &sync), false, "idle item flushed");
+	zassert_equal(k_wsq_submit(&wsq, &item), 1, "submit failed");
+	zassert_true(k_wsq_flush(&item, &sync), "flush didn't wait");
+	zassert_equal(atomic_get(&run_count), 1, "item didn't run once");
+	zassert_equal(k_wsq_work_busy_get(&item), 0, "item still busy");
+}
+
+/* Chained submissions run again, one at a time */
+static void test_resubmit(void)
+{
+	atomic_set(&run_count, 0);
+	atomic_set(&resubmits, 4);
+	k_wsq_work_init(&item, count_handler);
+
+	zassert_equal(k_wsq_submit(&wsq, &item), 1, "submit failed");
+	while (atomic_get(&run_count) < 5) {
+		k_msleep(1);
+	}
+	(void)k_wsq_flush(&item, &sync);
+	zassert_equal(atomic_get(&run_count), 5, "wrong number of runs");
+}
+
+static void test_cancel(void)
+{
+	atomic_set(&run_count, 0);
+	k_wsq_work_init(&item, blocking_handler);
+
+	zassert_equal(k_wsq_submit(&wsq, &item), 1, "submit failed");
+	k_sem_take(&started, K_FOREVER);
+
+	/* Running: queue it again, then cancel the queued instance */
+	zassert_equal(k_wsq_submit(&wsq, &item), 2, "requeue failed");
+	zassert_equal(k_wsq_cancel(&item),
+		      K_WSQ_WORK_RUNNING | K_WSQ_WORK_CANCELING,
+		      "running item not canceling");
+	zassert_equal(k_wsq_submit(&wsq, &item), -EBUSY,
+		      "submit accepted while canceling");
+
+	k_sem_give(&release);
+	(void)k_wsq_cancel_sync(&item, &sync);
+	zassert_equal(k_wsq_work_busy_get(&item), 0, "item still busy");
+	zassert_equal(atomic_get(&run_count), 1, "canceled instance ran");
+}
+
+static struct stress_item {
+	struct k_wsq_work work;
+	atomic_t running;
+	atomic_t runs;
+} stress_items[NUM_ITEMS];
+
+static atomic_t overlap;
+static volatile bool stress_done;
+
+static void stress_handler(struct k_wsq_work *work)
+{
+	struct stress_item *si = CONTAINER_OF(work, struct stress_item, work);
+
+	if (atomic_inc(&si->running) != 0) {
+		atomic_inc(&overlap);
+	}
+	k_busy_wait(sys_rand32_get() % 50);
+	atomic_dec(&si->running);
+	atomic_inc(&si->runs);
+
+	/* Fan out from the workers too, to exercise local pushes */
+	if (!stress_done) {
+		(void)k_wsq_submit(&wsq,
+				   &stress_items[sys_rand32_get() % NUM_ITEMS].work);
+	}
+}
+
+static void test_stress(void)
+{
+	uint64_t end = k_uptime_get() + STRESS_MS;
+	uint32_t total = 0;
+
+	atomic_set(&overlap, 0);
+	stress_done = false;
+
+	for (int i = 0; i < NUM_ITEMS; i++) {
+		k_wsq_work_init(&stress_items[i].work, stress_handler);
+		atomic_set(&stress_items[i].running, 0);
+		atomic_set(&stress_items[i].runs, 0);
+	}
+
+	while (k_uptime_get() < end) {
+		struct stress_item *si = &stress_items[sys_rand32_get() % NUM_ITEMS];
+
+		switch (sys_rand32_get() % 8) {
+		case 0:
+			(void)k_wsq_cancel(&si->work);
+			break;
+		case 1:
+			(void)k_wsq_flush(&si->work, &sync);
+			break;
+		default:
+			(void)k_wsq_submit(&wsq, &si->work);
+			break;
+		}
+		k_busy_wait(10);
+	}
+
+	/* The first pass waits out handlers that may still submit,
+	 * the second cancels what they submitted.
+	 */
+	stress_done = true;
+	for (int pass = 0; pass < 2; pass++) {
+		for (int i = 0; i < NUM_ITEMS; i++) {
+			(void)k_wsq_cancel_sync(&stress_items[i].work, &sync);
+		}
+	}
+
+	for (int i = 0; i < NUM_ITEMS; i++) {
+		zassert_equal(k_wsq_work_busy_get(&stress_items[i].work), 0,
+			      "item %d still busy", i);
+		total += atomic_get(&stress_items[i].runs);
+	}
+
+	zassert_equal(atomic_get(&overlap), 0, "item ran concurrently");
+	zassert_true(total > 0, "nothing ran");
+}
+
+void test_main(void)
+{
+	k_wsq_start(&wsq, K_PRIO_PREEMPT(1));
+
+	ztest_test_suite(lib_wsq_test,
+			 ztest_unit_test(test_simple),
+			 ztest_unit_test(test_resubmit),
+			 ztest_unit_test(test_cancel),
+			 ztest_unit_test(test_stress));
+
+	ztest_run_test_suite(lib_wsq_test);
+}
@@ -1212,6 +1212,239 @@ void test_v6_msg_trunc(void)
 		       (struct sockaddr *)&server_addr, sizeof(server_addr));
 }
 
+void test_v4_recvmsg(void)
+{
+	int rv;
+	int client_sock;
+	int server_sock;
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	struct sockaddr_in addr;
+	struct msghdr msg;
+	struct iovec io_vector[2];
+	char buf1[16], buf2[16];
+
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, CLIENT_PORT,
+			    &client_sock, &client_addr);
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, SERVER_PORT,
+			    &server_sock, &server_addr);
+
+	rv = bind(server_sock, (struct sockaddr *)&server_addr,
+		  sizeof(server_addr));
+	zassert_equal(rv, 0, "server bind failed");
+
+	rv = bind(client_sock, (struct sockaddr *)&client_addr,
+		  sizeof(client_addr));
+	zassert_equal(rv, 0, "client bind failed");
+
+	rv = sendto(client_sock, BUF_AND_SIZE(TEST_STR2), 0,
+		    (struct sockaddr *)&server_addr, sizeof(server_addr));
+	zassert_equal(rv, STRLEN(TEST_STR2), "sendto failed");
+
+	/* The datagram is scattered over both buffers and truncated */
+	io_vector[0].iov_base = buf1;
+	io_vector[0].iov_len = sizeof(buf1);
+	io_vector[1].iov_base = buf2;
+	io_vector[1].iov_len = sizeof(buf2);
+
+	memset(&msg, 0, sizeof(msg));
+	msg.msg_name = &addr;
+	msg.msg_namelen = sizeof(addr);
+	msg.msg_iov = io_vector;
+	msg.msg_iovlen = ARRAY_SIZE(io_vector);
+
+	rv = recvmsg(server_sock, &msg, 0);
+	zassert_equal(rv, sizeof(buf1) + sizeof(buf2), "recvmsg failed");
+	zassert_mem_equal(buf1, TEST_STR2, sizeof(buf1), "wrong data");
+	zassert_mem_equal(buf2, TEST_STR2 + sizeof(buf1), sizeof(buf2),
+			  "wrong data");
+	zassert_true(msg.msg_flags & ZSOCK_MSG_TRUNC, "MSG_TRUNC not set");
+	zassert_equal(msg.msg_namelen, sizeof(addr), "unexpected addrlen");
+	zassert_equal(addr.sin_port, client_addr.sin_port,
+		      "unexpected client port");
+
+	/* The rest of the datagram was discarded */
+	rv = recvmsg(server_sock, &msg, ZSOCK_MSG_DONTWAIT);
+	zassert_equal(rv, -1, "consecutive recvmsg should've failed");
+	zassert_equal(errno, EAGAIN, "incorrect errno value");
+
+	rv = sendto(client_sock, BUF_AND_SIZE(TEST_STR_SMALL), 0,
+		    (struct sockaddr *)&server_addr, sizeof(server_addr));
+	zassert_equal(rv, STRLEN(TEST_STR_SMALL), "sendto failed");
+
+	msg.msg_name = NULL;
+	msg.msg_namelen = 0;
+
+	rv = recvmsg(server_sock, &msg, 0);
+	zassert_equal(rv, STRLEN(TEST_STR_SMALL), "recvmsg failed");
+	zassert_mem_equal(buf1, BUF_AND_SIZE(TEST_STR_SMALL), "wrong data");
+	zassert_false(msg.msg_flags & ZSOCK_MSG_TRUNC, "MSG_TRUNC set");
+
+	rv = close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
+#define MMSG_COUNT 4
+
+void test_v4_sendmmsg_recvmmsg(void)
+{
+	int rv;
+	int i;
+	int client_sock;
+	int server_sock;
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	struct sockaddr_in addr[MMSG_COUNT];
+	struct mmsghdr msgvec[MMSG_COUNT];
+	struct iovec io_vector[MMSG_COUNT];
+	char buf[MMSG_COUNT][8];
+
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, CLIENT_PORT,
+			    &client_sock, &client_addr);
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, SERVER_PORT,
+			    &server_sock, &server_addr);
+
+	rv = bind(server_sock, (struct sockaddr *)&server_addr,
+		  sizeof(server_addr));
+	zassert_equal(rv, 0, "server bind failed");
+
+	rv = bind(client_sock, (struct sockaddr *)&client_addr,
+		  sizeof(client_addr));
+	zassert_equal(rv, 0, "client bind failed");
+
+	/* Datagram i carries the i + 1 first bytes of the test string */
+	memset(msgvec, 0, sizeof(msgvec));
+	for (i = 0; i < MMSG_COUNT; i++) {
+		io_vector[i].iov_base = TEST_STR_SMALL;
+		io_vector[i].iov_len = i + 1;
+
+		msgvec[i].msg_hdr.msg_name = &server_addr;
+		msgvec[i].msg_hdr.msg_namelen = sizeof(server_addr);
+		msgvec[i].msg_hdr.msg_iov = &io_vector[i];
+		msgvec[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	rv = sendmmsg(client_sock, msgvec, MMSG_COUNT, 0);
+	zassert_equal(rv, MMSG_COUNT, "sendmmsg failed");
+
+	for (i = 0; i < MMSG_COUNT; i++) {
+		zassert_equal(msgvec[i].msg_len, i + 1, "wrong msg_len");
+	}
+
+	memset(msgvec, 0, sizeof(msgvec));
+	for (i = 0; i < MMSG_COUNT; i++) {
+		io_vector[i].iov_base = buf[i];
+		io_vector[i].iov_len = sizeof(buf[i]);
+
+		msgvec[i].msg_hdr.msg_name = &addr[i];
+		msgvec[i].msg_hdr.msg_namelen = sizeof(addr[i]);
+		msgvec[i].msg_hdr.msg_iov = &io_vector[i];
+		msgvec[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	/* Only the first datagram is waited for, so allow for the others
+	 * to be received by a later call.
+	 */
+	for (i = 0; i < MMSG_COUNT; i += rv) {
+		rv = recvmmsg(server_sock, &msgvec[i], MMSG_COUNT - i, 0);
+		zassert_true(rv > 0, "recvmmsg failed");
+	}
+
+	for (i = 0; i < MMSG_COUNT; i++) {
+		zassert_equal(msgvec[i].msg_len, i + 1, "wrong msg_len");
+		zassert_mem_equal(buf[i], TEST_STR_SMALL, i + 1,
+				  "wrong data");
+		zassert_equal(addr[i].sin_port, client_addr.sin_port,
+			      "unexpected client port");
+	}
+
+	/* Nothing left, the call does not block */
+	rv = recvmmsg(server_sock, msgvec, MMSG_COUNT, ZSOCK_MSG_DONTWAIT);
+	zassert_equal(rv, -1, "recvmmsg should've failed");
+	zassert_equal(errno, EAGAIN, "incorrect errno value");
+
+	rv = close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
+void test_v6_recvmsg_zc(void)
+{
+	int rv;
+	int client_sock;
+	int server_sock;
+	struct sockaddr_in6 client_addr;
+	struct sockaddr_in6 server_addr;
+	struct msghdr msg;
+	struct iovec io_vector[4];
+	struct net_pkt *pkt, *pkt2;
+	size_t i, len;
+
+	prepare_sock_udp_v6(CONFIG_NET_CONFIG_MY_IPV6_ADDR, CLIENT_PORT,
+			    &client_sock, &client_addr);
+	prepare_sock_udp_v6(CONFIG_NET_CONFIG_MY_IPV6_ADDR, SERVER_PORT,
+			    &server_sock, &server_addr);
+
+	rv = bind(server_sock, (struct sockaddr *)&server_addr,
+		  sizeof(server_addr));
+	zassert_equal(rv, 0, "server bind failed");
+
+	/* More than one fragment */
+	rv = sendto(client_sock, BUF_AND_SIZE(TEST_STR2), 0,
+		    (struct sockaddr *)&server_addr, sizeof(server_addr));
+	zassert_equal(rv, STRLEN(TEST_STR2), "sendto failed");
+
+	memset(&msg, 0, sizeof(msg));
+	msg.msg_iov = io_vector;
+	msg.msg_iovlen = ARRAY_SIZE(io_vector);
+
+	rv = zsock_recvmsg_zc(server_sock, &msg, ZSOCK_MSG_PEEK, &pkt);
+	zassert_equal(rv, STRLEN(TEST_STR2), "recvmsg_zc failed");
+
+	msg.msg_iovlen = ARRAY_SIZE(io_vector);
+
+	/* The peeked datagram is still queued */
+	rv = zsock_recvmsg_zc(server_sock, &msg, 0, &pkt2);
+	zassert_equal(rv, STRLEN(TEST_STR2), "recvmsg_zc failed");
+	zassert_equal_ptr(pkt, pkt2, "different packet");
+	zassert_false(msg.msg_flags & ZSOCK_MSG_TRUNC, "MSG_TRUNC set");
+
+	for (i = 0, len = 0; i < msg.msg_iovlen; i++) {
+		zassert_mem_equal(io_vector[i].iov_base, TEST_STR2 + len,
+				  io_vector[i].iov_len, "wrong data");
+		len += io_vector[i].iov_len;
+	}
+
+	zassert_equal(len, STRLEN(TEST_STR2), "wrong length");
+
+	zsock_recvmsg_zc_release(pkt);
+	zsock_recvmsg_zc_release(pkt2);
+
+	/* Too few entries for the fragments */
+	rv = sendto(client_sock, BUF_AND_SIZE(TEST_STR2), 0,
+		    (struct sockaddr *)&server_addr, sizeof(server_addr));
+	zassert_equal(rv, STRLEN(TEST_STR2), "sendto failed");
+
+	msg.msg_iovlen = 1;
+
+	rv = zsock_recvmsg_zc(server_sock, &msg, 0, &pkt);
+	zassert_true(rv > 0 && rv < (int)STRLEN(TEST_STR2),
+		     "recvmsg_zc failed");
+	zassert_true(msg.msg_flags & ZSOCK_MSG_TRUNC, "MSG_TRUNC not set");
+	zassert_mem_equal(io_vector[0].iov_base, TEST_STR2, rv,
+			  "wrong data");
+
+	zsock_recvmsg_zc_release(pkt);
+
+	rv = close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
 void test_main(void)
 {
 	k_thread_system_pool_assign(k_current_get());
@@ -1242,7 +1475,12 @@ void test_main(void)
 			 ztest_unit_test(test_v6_sendmsg_with_txtime),
 			 ztest_user_unit_test(test_v6_sendmsg_with_txtime),
 			 ztest_unit_test(test_v4_msg_trunc),
-			 ztest_unit_test(test_v6_msg_trunc)
+			 ztest_unit_test(test_v6_msg_trunc),
+			 ztest_unit_test(test_v4_recvmsg),
+			 ztest_user_unit_test(test_v4_recvmsg),
+			 ztest_unit_test(test_v4_sendmmsg_recvmmsg),
+			 ztest_user_unit_test(test_v4_sendmmsg_recvmmsg),
+			 ztest_unit_test(test_v6_recvmsg_zc)
 		);
 
 	ztest_run_test_suite(socket_udp);
@@ -125,6 +125,12 @@ static void handle_syn_resend(void);
 static void handle_client_fin_wait_2_test(sa_family_t af, struct tcphdr *th);
 static void handle_client_closing_test(sa_family_t af, struct tcphdr *th);
 static void handle_server_recv_out_of_order(struct net_pkt *pkt);
+static void handle_cc_test(sa_family_t af, struct net_pkt *pkt,
+			   struct tcphdr *th);
+static void handle_sack_test(sa_family_t af, struct net_pkt *pkt,
+			     struct tcphdr *th);
+static void handle_rto_test(sa_family_t af, struct net_pkt *pkt,
+			    struct tcphdr *th);
 
 static void verify_flags(struct tcphdr *th, uint8_t flags,
 			 const char *fun, int line)
@@ -213,6 +219,22 @@ static uint8_t tcp_options[20] = {
 	0x01, /* NOP */
 	0x03, 0x03, 0x07 /* Win scale*/ };
 
+/* Segment size and window the peer advertises in the congestion tests */
+#define CC_MSS 100
+#define CC_WINDOW 1200
+
+static uint8_t cc_options[4] = {
+	0x02, 0x04, 0x00, CC_MSS, /* Max segment */
+};
+
+/* Window and window shift the peer advertises in the SACK test */
+#define SACK_WINDOW 1600
+#define SACK_WSCALE 4
+
+/* Options of the next segment sent by the peer in the SACK test */
+static uint8_t sack_options[40];
+static uint8_t sack_options_len;
+
 static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 					      uint16_t src_port,
 					      uint16_t dst_port,
@@ -223,11 +245,19 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
 	struct net_pkt *pkt;
 	struct tcphdr *th;
+	const uint8_t *opts = NULL;
 	uint8_t opts_len = 0;
 	int ret = -EINVAL;
 
 	if ((test_case_no == 4U) && (flags & SYN)) {
+		opts = tcp_options;
 		opts_len = sizeof(tcp_options);
+	} else if ((test_case_no == 10U) && (flags & SYN)) {
+		opts = cc_options;
+		opts_len = sizeof(cc_options);
+	} else if (test_case_no == 11U) {
+		opts = sack_options;
+		opts_len = sack_options_len;
 	}
 
 	/* Allocate buffer */
@@ -262,14 +292,17 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 	th->th_sport = src_port;
 	th->th_dport = dst_port;
 
-	if ((test_case_no == 4U) && (flags & SYN)) {
-		th->th_off = 10U;
+	th->th_off = 5U + opts_len / 4U;
+	th->th_flags = flags;
+
+	if (test_case_no == 10U) {
+		th->th_win = htons(CC_WINDOW);
+	} else if (test_case_no == 11U) {
+		th->th_win = htons((flags & SYN) ? SACK_WINDOW :
+				   SACK_WINDOW >> SACK_WSCALE);
 	} else {
-		th->th_off = 5U;
+		th->th_win = NET_IPV6_MTU;
 	}
-
-	th->th_flags = flags;
-	th->th_win = NET_IPV6_MTU;
 	th->th_seq = htonl(seq);
 
 	if (ACK & flags) {
@@ -281,9 +314,9 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 		goto fail;
 	}
 
-	if ((test_case_no == 4U) && (flags & SYN)) {
+	if (opts) {
 		/* Add TCP Options */
-		ret = net_pkt_write(pkt, tcp_options, opts_len);
+		ret = net_pkt_write(pkt, opts, opts_len);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -420,6 +453,15 @@ static int tester_send(const struct device *dev, struct net_pkt *pkt)
 	case 9:
 		handle_server_recv_out_of_order(pkt);
 		break;
+	case 10:
+		handle_cc_test(net_pkt_family(pkt), pkt, &th);
+		break;
+	case 11:
+		handle_sack_test(net_pkt_family(pkt), pkt, &th);
+		break;
+	case 12:
+		handle_rto_test(net_pkt_family(pkt), pkt, &th);
+		break;
 	default:
 		zassert_true(false, "Undefined test case");
 	}
@@ -1484,6 +1526,868 @@ static void test_server_timeout_out_of_order_data(void)
 	net_tcp_put(ooo_ctx);
 }
 
+#define CC_DATA_LEN 10000
+/* Every CC_LOSS_PERIOD:th new segment is dropped by the peer */
+#define CC_LOSS_PERIOD 20
+#define CC_TIMEOUT_MS 5000
+
+static uint8_t cc_data[CC_DATA_LEN];
+
+static void cc_data_init(void)
+{
+	for (int i = 0; i < CC_DATA_LEN; i++) {
+		cc_data[i] = (uint8_t)(i * 7U);
+	}
+}
+
+/* Receiver side of the congestion control tests. Data is acknowledged
+ * cumulatively, data after a hole is kept and duplicate ACKs are sent
+ * for it, so at most one hole exists at a time.
+ */
+static struct {
+	uint32_t isn;
+	uint32_t rcv_nxt;	/* offsets into cc_data */
+	uint32_t high;
+	uint32_t hole_end;
+	uint32_t ooo_end;
+	uint32_t segments;
+	int64_t dup_ack_time;
+	uint8_t dup_acks;
+	bool hole;
+	int losses;
+	int fast_recoveries;
+} cc;
+
+static void cc_check_data(struct net_pkt *pkt, size_t hdr_len,
+			  uint32_t off, size_t len)
+{
+	uint8_t buf[CC_MSS];
+
+	zassert_true(len <= sizeof(buf) && off + len <= CC_DATA_LEN,
+		     "bad segment off %u len %zu", off, len);
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+	net_pkt_skip(pkt, hdr_len);
+	zassert_equal(net_pkt_read(pkt, buf, len), 0, "cannot read data");
+	net_pkt_cursor_init(pkt);
+
+	zassert_mem_equal(buf, cc_data + off, len,
+			  "data mismatch at offset %u", off);
+}
+
+static struct net_pkt *cc_receive(sa_family_t af, struct net_pkt *pkt,
+				  struct tcphdr *th)
+{
+	size_t hdr_len = net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt) +
+			 th->th_off * 4U;
+	size_t len = net_pkt_get_len(pkt) - hdr_len;
+	uint32_t off = ntohl(th->th_seq) - cc.isn - 1U;
+
+	if (off >= cc.high) {
+		cc.high = off + len;
+
+		/* Keep enough data after a loss to get duplicate ACKs */
+		if (!cc.hole && (++cc.segments % CC_LOSS_PERIOD) == 0U &&
+		    off + len + 2 * CC_WINDOW < CC_DATA_LEN) {
+			cc.hole = true;
+			cc.hole_end = off + len;
+			cc.ooo_end = off + len;
+			cc.dup_acks = 0U;
+			cc.losses++;
+			return NULL;
+		}
+	}
+
+	if (off == cc.rcv_nxt) {
+		cc_check_data(pkt, hdr_len, off, len);
+
+		if (cc.hole && off + len >= cc.hole_end) {
+			/* Retransmission arrived well before the RTO */
+			if (cc.dup_acks >= 3U &&
+			    k_uptime_get() - cc.dup_ack_time <
+			    CONFIG_NET_TCP_INIT_RETRANSMISSION_TIMEOUT / 2) {
+				cc.fast_recoveries++;
+			}
+
+			cc.rcv_nxt = cc.ooo_end;
+			cc.hole = false;
+		} else {
+			cc.rcv_nxt += len;
+		}
+	} else if (cc.hole && off == cc.ooo_end) {
+		cc_check_data(pkt, hdr_len, off, len);
+		cc.ooo_end += len;
+
+		if (++cc.dup_acks == 3U) {
+			cc.dup_ack_time = k_uptime_get();
+		}
+	}
+
+	/* Anything else was received already */
+	ack = cc.isn + 1U + cc.rcv_nxt;
+
+	return prepare_ack_packet(af, htons(MY_PORT), th->th_sport);
+}
+
+static void handle_cc_test(sa_family_t af, struct net_pkt *pkt,
+			   struct tcphdr *th)
+{
+	struct net_pkt *reply;
+	int ret;
+
+	switch (t_state) {
+	case T_SYN:
+		test_verify_flags(th, SYN);
+		cc.isn = ntohl(th->th_seq);
+		seq = 0U;
+		ack = cc.isn + 1U;
+		reply = prepare_syn_ack_packet(af, htons(MY_PORT),
+					       th->th_sport);
+		t_state = T_SYN_ACK;
+		break;
+	case T_SYN_ACK:
+		test_verify_flags(th, ACK);
+		seq = 1U;
+		t_state = T_DATA;
+		test_sem_give();
+		return;
+	case T_DATA:
+		if (th->th_flags & FIN) {
+			test_verify_flags(th, FIN | ACK);
+			ack = ntohl(th->th_seq) + 1U;
+			reply = prepare_fin_ack_packet(af, htons(MY_PORT),
+						       th->th_sport);
+			t_state = T_FIN_ACK;
+			break;
+		}
+
+		reply = cc_receive(af, pkt, th);
+		if (!reply) {
+			return;
+		}
+		break;
+	case T_FIN_ACK:
+		test_verify_flags(th, ACK);
+		test_sem_give();
+		return;
+	default:
+		zassert_true(false, "%s unexpected state", __func__);
+		return;
+	}
+
+	ret = net_recv_data(iface, reply);
+	if (ret < 0) {
+		zassert_true(false, "%s failed", __func__);
+	}
+}
+
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+/* Send CC_DATA_LEN bytes over a path that drops a segment every now and
+ * then, and check that all losses are repaired by fast retransmit.
+ */
+static void cc_transfer(const char *algo)
+{
+	struct net_context *ctx;
+	struct tcp *conn;
+	size_t sent = 0;
+	int64_t start;
+	uint32_t elapsed;
+	int ret;
+
+	cc_data_init();
+	memset(&cc, 0, sizeof(cc));
+	t_state = T_SYN;
+	test_case_no = 10;
+	seq = ack = 0;
+
+	ret = net_context_get(AF_INET, SOCK_STREAM, IPPROTO_TCP, &ctx);
+	zassert_equal(ret, 0, "Failed to get net_context");
+
+	ret = net_tcp_set_congestion(ctx, algo);
+	zassert_equal(ret, 0, "Cannot select %s (%d)", algo, ret);
+
+	net_context_ref(ctx);
+
+	ret = net_context_connect(ctx, (struct sockaddr *)&peer_addr_s,
+				  sizeof(struct sockaddr_in),
+				  NULL,
+				  K_MSEC(100), NULL);
+	zassert_equal(ret, 0, "Failed to connect to peer");
+
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	conn = ctx->tcp;
+	zassert_equal(conn->cc.cwnd, 4U * CC_MSS, "wrong initial window %u",
+		      conn->cc.cwnd);
+
+	start = k_uptime_get();
+
+	while (sent < CC_DATA_LEN) {
+		ret = net_context_send(ctx, cc_data + sent,
+				       MIN(CC_MSS, CC_DATA_LEN - sent),
+				       NULL, K_NO_WAIT, NULL);
+		if (ret == -EAGAIN || ret == -ENOBUFS) {
+			k_msleep(1);
+		} else {
+			zassert_true(ret > 0, "send failed (%d)", ret);
+			sent += ret;
+		}
+
+		zassert_true(k_uptime_get() - start < CC_TIMEOUT_MS,
+			     "send stalled at %zu bytes", sent);
+	}
+
+	while (cc.rcv_nxt < CC_DATA_LEN) {
+		zassert_true(k_uptime_get() - start < CC_TIMEOUT_MS,
+			     "transfer stalled at %u bytes", cc.rcv_nxt);
+		k_msleep(1);
+	}
+
+	elapsed = MAX((uint32_t)(k_uptime_get() - start), 1U);
+
+	TC_PRINT("%s: %u bytes in %u ms (%u bytes/s), %d losses, "
+		 "%d fast recoveries, cwnd %u ssthresh %u\n", algo,
+		 CC_DATA_LEN, elapsed, CC_DATA_LEN * 1000U / elapsed,
+		 cc.losses, cc.fast_recoveries, conn->cc.cwnd,
+		 conn->cc.ssthresh);
+
+	zassert_true(cc.losses > 0, "no segment was dropped");
+	zassert_equal(cc.fast_recoveries, cc.losses,
+		      "%d of %d losses needed a timeout",
+		      cc.losses - cc.fast_recoveries, cc.losses);
+	zassert_true(conn->cc.ssthresh < UINT32_MAX, "loss went unnoticed");
+
+	net_context_put(ctx);
+
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	k_sleep(K_MSEC(CONFIG_NET_TCP_TIME_WAIT_DELAY));
+}
+#endif /* CONFIG_NET_TCP_CONGESTION_CONTROL */
+
+static void test_client_congestion_newreno(void)
+{
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+	cc_transfer("newreno");
+#else
+	ztest_test_skip();
+#endif
+}
+
+static void test_client_congestion_cubic(void)
+{
+#if defined(CONFIG_NET_TCP_CONGESTION_CUBIC)
+	cc_transfer("cubic");
+#else
+	ztest_test_skip();
+#endif
+}
+
+/* Delay of the peer's SYN-ACK, the client measures it with timestamps */
+#define SACK_SYN_DELAY_MS 20
+
+/* New segments dropped by the peer, two holes in the same window twice */
+static const uint32_t sack_drops[] = { 10, 12, 40, 43 };
+
+/* Peer side of the SACK test. The peer keeps all data, acknowledges the
+ * received data above a hole with SACK blocks and counts the data that
+ * is retransmitted needlessly.
+ */
+static struct {
+	uint32_t isn;
+	uint32_t rcv_nxt;	/* offsets into cc_data */
+	uint32_t high;
+	uint32_t segments;
+	uint32_t max_len;	/* largest payload seen */
+	uint32_t tsval;		/* peer's clock */
+	uint32_t ts_recent;	/* client's timestamp to echo */
+	uint32_t expect_ack;
+	uint32_t expect_sack[2];
+	int drops;
+	int rexmits;
+	int dup_bytes;
+	bool expect_sack_block;
+} sk;
+
+static uint8_t sack_rcvd[CC_DATA_LEN / 8];
+
+#define sack_is_rcvd(_off) (sack_rcvd[(_off) / 8] & BIT((_off) % 8))
+
+struct sack_test_options {
+	uint32_t tsval;
+	uint32_t tsecr;
+	uint32_t sack[2];
+	uint8_t wscale;
+	uint8_t sack_blocks;
+	bool mss : 1;
+	bool ws : 1;
+	bool sack_perm : 1;
+	bool ts : 1;
+};
+
+static void sack_read_options(struct net_pkt *pkt, struct tcphdr *th,
+			      struct sack_test_options *o)
+{
+	uint8_t buf[40];
+	size_t len = th->th_off * 4U - sizeof(struct tcphdr);
+	size_t i = 0;
+
+	memset(o, 0, sizeof(*o));
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+	net_pkt_skip(pkt, net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt) +
+		     sizeof(struct tcphdr));
+	zassert_equal(net_pkt_read(pkt, buf, len), 0, "cannot read options");
+	net_pkt_cursor_init(pkt);
+
+	while (i < len && buf[i] != 0U) {
+		if (buf[i] == 1U) {
+			i++;
+			continue;
+		}
+
+		switch (buf[i]) {
+		case 2:
+			o->mss = true;
+			break;
+		case 3:
+			o->ws = true;
+			o->wscale = buf[i + 2];
+			break;
+		case 4:
+			o->sack_perm = true;
+			break;
+		case 5:
+			o->sack_blocks = (buf[i + 1] - 2U) / 8U;
+			o->sack[0] = sys_get_be32(&buf[i + 2]);
+			o->sack[1] = sys_get_be32(&buf[i + 6]);
+			break;
+		case 8:
+			o->ts = true;
+			o->tsval = sys_get_be32(&buf[i + 2]);
+			o->tsecr = sys_get_be32(&buf[i + 6]);
+			break;
+		}
+
+		i += buf[i + 1];
+	}
+}
+
+/* Timestamps on every segment, and up to three SACK blocks that report
+ * the data received above rcv_nxt.
+ */
+static void sack_build_options(bool syn)
+{
+	uint8_t *p = sack_options;
+	uint8_t *sack_len = NULL;
+	uint32_t off = sk.rcv_nxt;
+
+	if (syn) {
+		memcpy(p, cc_options, sizeof(cc_options));
+		p += sizeof(cc_options);
+		*p++ = 1U;
+		*p++ = 3U;
+		*p++ = 3U;
+		*p++ = SACK_WSCALE;
+		*p++ = 1U;
+		*p++ = 1U;
+		*p++ = 4U;
+		*p++ = 2U;
+	}
+
+	*p++ = 1U;
+	*p++ = 1U;
+	*p++ = 8U;
+	*p++ = 10U;
+	sys_put_be32(++sk.tsval, p);
+	sys_put_be32(sk.ts_recent, p + 4);
+	p += 8;
+
+	while (!syn && off < sk.high && (p - sack_options) + 8 <= 40) {
+		uint32_t start;
+
+		while (off < sk.high && !sack_is_rcvd(off)) {
+			off++;
+		}
+
+		if (off == sk.high) {
+			break;
+		}
+
+		start = off;
+		while (off < sk.high && sack_is_rcvd(off)) {
+			off++;
+		}
+
+		if (!sack_len) {
+			*p++ = 1U;
+			*p++ = 1U;
+			*p++ = 5U;
+			sack_len = p++;
+			*sack_len = 2U;
+		}
+
+		sys_put_be32(sk.isn + 1U + start, p);
+		sys_put_be32(sk.isn + 1U + off, p + 4);
+		p += 8;
+		*sack_len += 8U;
+	}
+
+	sack_options_len = p - sack_options;
+}
+
+static struct net_pkt *sack_receive(sa_family_t af, struct net_pkt *pkt,
+				    struct tcphdr *th)
+{
+	size_t hdr_len = net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt) +
+			 th->th_off * 4U;
+	size_t len = net_pkt_get_len(pkt) - hdr_len;
+	uint32_t off = ntohl(th->th_seq) - sk.isn - 1U;
+	struct sack_test_options o;
+
+	sack_read_options(pkt, th, &o);
+	zassert_true(o.ts, "segment without timestamp");
+	zassert_true(o.tsecr != 0U && o.tsecr <= sk.tsval,
+		     "wrong echoed timestamp %u", o.tsecr);
+	sk.ts_recent = o.tsval;
+
+	if (len == 0U) {
+		return NULL;
+	}
+
+	/* The options come out of the MSS */
+	zassert_true(len + th->th_off * 4U - sizeof(struct tcphdr) <= CC_MSS,
+		     "%zu bytes and %u bytes of options exceed the MSS", len,
+		     th->th_off * 4U - (uint32_t)sizeof(struct tcphdr));
+	sk.max_len = MAX(sk.max_len, len);
+
+	if (off >= sk.high) {
+		sk.high = off + len;
+		sk.segments++;
+
+		for (size_t i = 0; i < ARRAY_SIZE(sack_drops); i++) {
+			if (sk.segments == sack_drops[i]) {
+				sk.drops++;
+				return NULL;
+			}
+		}
+	} else {
+		sk.rexmits++;
+	}
+
+	cc_check_data(pkt, hdr_len, off, len);
+
+	for (uint32_t i = off; i < off + len; i++) {
+		if (sack_is_rcvd(i)) {
+			sk.dup_bytes++;
+		}
+
+		sack_rcvd[i / 8] |= BIT(i % 8);
+	}
+
+	while (sk.rcv_nxt < CC_DATA_LEN && sack_is_rcvd(sk.rcv_nxt)) {
+		sk.rcv_nxt++;
+	}
+
+	ack = sk.isn + 1U + sk.rcv_nxt;
+	sack_build_options(false);
+
+	return prepare_ack_packet(af, htons(MY_PORT), th->th_sport);
+}
+
+static void handle_sack_test(sa_family_t af, struct net_pkt *pkt,
+			     struct tcphdr *th)
+{
+	struct sack_test_options o;
+	struct net_pkt *reply;
+	int ret;
+
+	switch (t_state) {
+	case T_SYN:
+		test_verify_flags(th, SYN);
+		sack_read_options(pkt, th, &o);
+		zassert_true(o.mss && o.ws && o.sack_perm && o.ts,
+			     "options missing from SYN");
+		zassert_equal(o.tsecr, 0U, "TSecr set in SYN");
+
+		sk.isn = ntohl(th->th_seq);
+		sk.ts_recent = o.tsval;
+		seq = 0U;
+		ack = sk.isn + 1U;
+		sack_build_options(true);
+		reply = prepare_syn_ack_packet(af, htons(MY_PORT),
+					       th->th_sport);
+
+		k_msleep(SACK_SYN_DELAY_MS);
+		t_state = T_SYN_ACK;
+		break;
+	case T_SYN_ACK:
+		test_verify_flags(th, ACK);
+		seq = 1U;
+		t_state = T_DATA;
+		test_sem_give();
+		return;
+	case T_DATA:
+		reply = sack_receive(af, pkt, th);
+		if (!reply) {
+			return;
+		}
+		break;
+	case T_DATA_ACK:
+		/* The client acknowledges data sent by the peer */
+		test_verify_flags(th, ACK);
+		sack_read_options(pkt, th, &o);
+		zassert_equal(ntohl(th->th_ack), sk.expect_ack,
+			      "wrong ack %u", ntohl(th->th_ack));
+
+		if (sk.expect_sack_block) {
+			zassert_equal(o.sack_blocks, 1, "no SACK block");
+			zassert_equal(o.sack[0], sk.expect_sack[0],
+				      "wrong SACK block start %u", o.sack[0]);
+			zassert_equal(o.sack[1], sk.expect_sack[1],
+				      "wrong SACK block end %u", o.sack[1]);
+		} else {
+			zassert_equal(o.sack_blocks, 0, "unexpected SACK");
+		}
+
+		test_sem_give();
+		return;
+	case T_FIN:
+		test_verify_flags(th, FIN | ACK);
+		ack = ntohl(th->th_seq) + 1U;
+		sack_build_options(false);
+		reply = prepare_fin_ack_packet(af, htons(MY_PORT),
+					       th->th_sport);
+		t_state = T_FIN_ACK;
+		break;
+	case T_FIN_ACK:
+		test_verify_flags(th, ACK);
+		test_sem_give();
+		return;
+	default:
+		zassert_true(false, "%s unexpected state", __func__);
+		return;
+	}
+
+	ret = net_recv_data(iface, reply);
+	if (ret < 0) {
+		zassert_true(false, "%s failed", __func__);
+	}
+}
+
+#if defined(CONFIG_NET_TCP_SACK) && defined(CONFIG_NET_TCP_TIMESTAMPS) && \
+	defined(CONFIG_NET_TCP_WINDOW_SCALE)
+/* Send data from the peer and check the client's acknowledgment */
+static void sack_peer_send(struct tcp *conn, uint32_t data_seq,
+			   uint32_t expect_ack, bool expect_sack_block)
+{
+	struct net_pkt *pkt;
+	int ret;
+
+	seq = data_seq;
+	sk.expect_ack = expect_ack;
+	sk.expect_sack[0] = data_seq;
+	sk.expect_sack[1] = data_seq + CC_MSS;
+	sk.expect_sack_block = expect_sack_block;
+
+	sack_build_options(false);
+	pkt = prepare_data_packet(AF_INET, htons(MY_PORT),
+				  conn->src.sin.sin_port, cc_data, CC_MSS);
+	zassert_not_null(pkt, "Cannot create pkt");
+
+	ret = net_recv_data(iface, pkt);
+	zassert_equal(ret, 0, "recv data failed (%d)", ret);
+
+	test_sem_take(K_MSEC(100), __LINE__);
+}
+#endif
+
+/* Negotiate window scaling, SACK and timestamps, then send data over a
+ * path that loses two segments of the same window. Only the lost data
+ * may be retransmitted. Finally check the SACK blocks the client sends
+ * for out-of-order data.
+ */
+static void test_client_sack(void)
+{
+#if defined(CONFIG_NET_TCP_SACK) && defined(CONFIG_NET_TCP_TIMESTAMPS) && \
+	defined(CONFIG_NET_TCP_WINDOW_SCALE)
+	struct net_context *ctx;
+	struct tcp *conn;
+	size_t sent = 0;
+	int64_t start;
+	uint32_t elapsed;
+	int ret;
+
+	cc_data_init();
+	memset(&sk, 0, sizeof(sk));
+	memset(sack_rcvd, 0, sizeof(sack_rcvd));
+	sk.tsval = 1000U;
+	sack_options_len = 0U;
+	t_state = T_SYN;
+	test_case_no = 11;
+	seq = ack = 0;
+
+	ret = net_context_get(AF_INET, SOCK_STREAM, IPPROTO_TCP, &ctx);
+	zassert_equal(ret, 0, "Failed to get net_context");
+
+	net_context_ref(ctx);
+
+	ret = net_context_connect(ctx, (struct sockaddr *)&peer_addr_s,
+				  sizeof(struct sockaddr_in),
+				  NULL,
+				  K_MSEC(100), NULL);
+	zassert_equal(ret, 0, "Failed to connect to peer");
+
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	conn = ctx->tcp;
+	zassert_true(conn->wscale_ok && conn->sack_ok && conn->ts_ok,
+		     "options not negotiated");
+	zassert_equal(conn->snd_wscale, SACK_WSCALE, "wrong window shift");
+	zassert_true(conn->rtt.last >= SACK_SYN_DELAY_MS,
+		     "RTT not measured (%u)", conn->rtt.last);
+
+	start = k_uptime_get();
+
+	while (sent < CC_DATA_LEN) {
+		ret = net_context_send(ctx, cc_data + sent,
+				       MIN(CC_MSS, CC_DATA_LEN - sent),
+				       NULL, K_NO_WAIT, NULL);
+		if (ret == -EAGAIN || ret == -ENOBUFS) {
+			k_msleep(1);
+		} else {
+			zassert_true(ret > 0, "send failed (%d)", ret);
+			sent += ret;
+		}
+
+		zassert_true(k_uptime_get() - start < CC_TIMEOUT_MS,
+			     "send stalled at %zu bytes", sent);
+	}
+
+	while (sk.rcv_nxt < CC_DATA_LEN) {
+		zassert_true(k_uptime_get() - start < CC_TIMEOUT_MS,
+			     "transfer stalled at %u bytes", sk.rcv_nxt);
+		k_msleep(1);
+	}
+
+	elapsed = MAX((uint32_t)(k_uptime_get() - start), 1U);
+
+	TC_PRINT("sack: %u bytes in %u ms (%u bytes/s), %d losses, "
+		 "%d retransmissions\n", CC_DATA_LEN, elapsed,
+		 CC_DATA_LEN * 1000U / elapsed, sk.drops, sk.rexmits);
+
+	zassert_equal(conn->send_win, SACK_WINDOW, "window not scaled (%u)",
+		      conn->send_win);
+	zassert_equal(sk.drops, ARRAY_SIZE(sack_drops), "%d drops", sk.drops);
+	zassert_equal(sk.dup_bytes, 0, "%d bytes sent twice", sk.dup_bytes);
+	zassert_equal(sk.rexmits, sk.drops, "%d retransmissions for %d losses",
+		      sk.rexmits, sk.drops);
+
+	/* Full-sized segments leave room for the timestamps */
+	zassert_equal(sk.max_len, CC_MSS - 2U - NET_TCP_TIMESTAMP_SIZE,
+		      "largest segment %u bytes", sk.max_len);
+
+	if (CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT) {
+		ret = net_context_recv(ctx, test_tcp_recv_cb, K_NO_WAIT, NULL);
+		zassert_equal(ret, 0, "Failed to set recv callback");
+
+		t_state = T_DATA_ACK;
+
+		/* Data after a hole is reported at once */
+		sack_peer_send(conn, 1U + CC_MSS, 1U, true);
+
+		/* Filling the hole acknowledges everything */
+		sack_peer_send(conn, 1U, 1U + 2U * CC_MSS, false);
+
+		seq = 1U + 2U * CC_MSS;
+	}
+
+	t_state = T_FIN;
+	net_context_put(ctx);
+
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	k_sleep(K_MSEC(CONFIG_NET_TCP_TIME_WAIT_DELAY));
+#else
+	ztest_test_skip();
+#endif
+}
+
+/* Delay of the peer's SYN-ACK, the client times the SYN */
+#define RTO_SYN_DELAY_MS 100
+
+/* The peer drops the first data segment until it is sent this many times */
+#define RTO_TRANSMISSIONS 3
+
+#define RTO_DATA_LEN 100
+
+static struct {
+	uint32_t isn;
+	uint32_t acked;
+	int64_t sent[RTO_TRANSMISSIONS];
+	int count;
+} rto;
+
+static void handle_rto_test(sa_family_t af, struct net_pkt *pkt,
+			    struct tcphdr *th)
+{
+	struct net_pkt *reply;
+	size_t len;
+	int ret;
+
+	switch (t_state) {
+	case T_SYN:
+		test_verify_flags(th, SYN);
+		rto.isn = ntohl(th->th_seq);
+		seq = 0U;
+		ack = rto.isn + 1U;
+		reply = prepare_syn_ack_packet(af, htons(MY_PORT),
+					       th->th_sport);
+
+		k_msleep(RTO_SYN_DELAY_MS);
+		t_state = T_SYN_ACK;
+		break;
+	case T_SYN_ACK:
+		test_verify_flags(th, ACK);
+		seq = 1U;
+		t_state = T_DATA;
+		test_sem_give();
+		return;
+	case T_DATA:
+		len = net_pkt_get_len(pkt) - net_pkt_ip_hdr_len(pkt) -
+		      net_pkt_ip_opts_len(pkt) - th->th_off * 4U;
+		if (len == 0) {
+			return;
+		}
+
+		if (rto.count < RTO_TRANSMISSIONS) {
+			rto.sent[rto.count++] = k_uptime_get();
+			if (rto.count < RTO_TRANSMISSIONS) {
+				return;
+			}
+		}
+
+		ack = ntohl(th->th_seq) + len;
+		rto.acked = ack - rto.isn - 1U;
+		reply = prepare_ack_packet(af, htons(MY_PORT), th->th_sport);
+		break;
+	case T_FIN:
+		test_verify_flags(th, FIN | ACK);
+		ack = ntohl(th->th_seq) + 1U;
+		reply = prepare_fin_ack_packet(af, htons(MY_PORT),
+					       th->th_sport);
+		t_state = T_FIN_ACK;
+		break;
+	case T_FIN_ACK:
+		test_verify_flags(th, ACK);
+		test_sem_give();
+		return;
+	default:
+		zassert_true(false, "%s unexpected state", __func__);
+		return;
+	}
+
+	ret = net_recv_data(iface, reply);
+	if (ret < 0) {
+		zassert_true(false, "%s failed", __func__);
+	}
+}
+
+static void rto_send(struct net_context *ctx, uint32_t acked,
+		     uint32_t timeout)
+{
+	int64_t start = k_uptime_get();
+	int ret;
+
+	ret = net_context_send(ctx, cc_data, RTO_DATA_LEN, NULL, K_NO_WAIT,
+			       NULL);
+	zassert_equal(ret, RTO_DATA_LEN, "send failed (%d)", ret);
+
+	while (rto.acked < acked) {
+		zassert_true(k_uptime_get() - start < timeout,
+			     "data not acknowledged");
+		k_msleep(1);
+	}
+}
+
+/* Measure the RTT from a delayed SYN-ACK, then check that the timeout
+ * derived from it is doubled for each retransmission of a lost segment
+ * and that retransmissions are not timed.
+ */
+static void test_client_rto(void)
+{
+	struct net_context *ctx;
+	struct tcp *conn;
+	uint32_t first_rto;
+	int64_t gap;
+	int ret;
+
+	cc_data_init();
+	memset(&rto, 0, sizeof(rto));
+	t_state = T_SYN;
+	test_case_no = 12;
+	seq = ack = 0;
+
+	ret = net_context_get(AF_INET, SOCK_STREAM, IPPROTO_TCP, &ctx);
+	zassert_equal(ret, 0, "Failed to get net_context");
+
+	net_context_ref(ctx);
+
+	ret = net_context_connect(ctx, (struct sockaddr *)&peer_addr_s,
+				  sizeof(struct sockaddr_in),
+				  NULL,
+				  K_MSEC(2 * RTO_SYN_DELAY_MS), NULL);
+	zassert_equal(ret, 0, "Failed to connect to peer");
+
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	conn = ctx->tcp;
+	zassert_equal(conn->rtt.samples, 1U, "SYN not timed");
+	zassert_true(conn->rtt.last >= RTO_SYN_DELAY_MS, "RTT %u too small",
+		     conn->rtt.last);
+
+	/* The first measurement gives RTO = R + 4 * R / 2 */
+	first_rto = conn->rtt.rto;
+	zassert_equal(first_rto, CLAMP(3U * conn->rtt.last,
+				       (uint32_t)CONFIG_NET_TCP_RTO_MIN,
+				       (uint32_t)CONFIG_NET_TCP_RTO_MAX),
+		      "wrong RTO %u for RTT %u", first_rto, conn->rtt.last);
+
+	rto_send(ctx, RTO_DATA_LEN, 8U * first_rto);
+
+	gap = rto.sent[1] - rto.sent[0];
+	zassert_true(gap >= first_rto - 10 && gap < 2 * first_rto,
+		     "first retransmission after %d ms, RTO %u",
+		     (int)gap, first_rto);
+
+	gap = rto.sent[2] - rto.sent[1];
+	zassert_true(gap >= 2 * first_rto - 10 && gap < 4 * first_rto,
+		     "timeout not backed off (%d ms)", (int)gap);
+
+	/* Karn's algorithm, the acknowledged data was retransmitted */
+	zassert_equal(conn->rtt.samples, 1U, "retransmission timed");
+	zassert_equal(conn->rtt.rto, MIN(4U * first_rto,
+					 (uint32_t)CONFIG_NET_TCP_RTO_MAX),
+		      "backoff lost (%u)", conn->rtt.rto);
+
+	/* A new measurement replaces the backed off timeout */
+	rto_send(ctx, 2U * RTO_DATA_LEN, first_rto);
+
+	zassert_equal(conn->rtt.samples, 2U, "new data not timed");
+	zassert_true(conn->rtt.rto < 4U * first_rto, "RTO %u still backed off",
+		     conn->rtt.rto);
+	zassert_true(conn->rtt.min <= conn->rtt.last, "wrong minimum RTT");
+
+	t_state = T_FIN;
+	net_context_put(ctx);
+
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	k_sleep(K_MSEC(CONFIG_NET_TCP_TIME_WAIT_DELAY));
+}
+
 /** Test case main entry */
 void test_main(void)
 {
@@ -1499,7 +2403,11 @@ void test_main(void)
 			 ztest_unit_test(test_client_closing_ipv6),
 			 ztest_unit_test(test_client_invalid_rst),
 			 ztest_unit_test(test_server_recv_out_of_order_data),
-			 ztest_unit_test(test_server_timeout_out_of_order_data)
+			 ztest_unit_test(test_server_timeout_out_of_order_data),
+			 ztest_unit_test(test_client_congestion_newreno),
+			 ztest_unit_test(test_client_congestion_cubic),
+			 ztest_unit_test(test_client_sack),
+			 ztest_unit_test(test_client_rto)
 			 );
 
 	ztest_run_test_suite(test_tcp_fn);